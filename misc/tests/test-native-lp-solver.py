@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+
+"""
+Regression test for the native LP solver: run the LP-based optimal
+configurations with lpsolver=native and check that they find plans with
+the optimal cost. A wrong LP result (e.g., a solvable LP reported as
+infeasible) makes the heuristics inadmissible or prunes solvable states,
+which shows up as a missing or more expensive plan.
+"""
+
+from __future__ import print_function
+
+import os
+import re
+import subprocess
+import sys
+
+DIR = os.path.dirname(os.path.abspath(__file__))
+REPO_BASE = os.path.dirname(os.path.dirname(DIR))
+
+BENCHMARKS_DIR = os.path.join(REPO_BASE, "misc", "tests", "benchmarks")
+DRIVER = os.path.join(REPO_BASE, "fast-downward.py")
+PLAN_FILE = "native-lp.plan"
+
+TASKS = [
+    "gripper/prob01.pddl",
+    "miconic/s1-0.pddl",
+]
+
+REFERENCE_CONFIG = "astar(lmcut())"
+
+CONFIGS = [
+    "astar(operatorcounting([state_equation_constraints()], lpsolver=native))",
+    "astar(operatorcounting([lmcut_constraints()], lpsolver=native))",
+    "astar(operatorcounting([state_equation_constraints(), lmcut_constraints()], "
+    "lpsolver=native))",
+    "astar(operatorcounting([pho_constraints(patterns=systematic(2))], "
+    "lpsolver=native))",
+    "astar(initial_state_potential(lpsolver=native))",
+    "astar(all_states_potential(lpsolver=native))",
+    "astar(diverse_potentials(lpsolver=native))",
+    "astar(lmcount(lm_rhw(), admissible=true, optimal=true, lpsolver=native))",
+]
+
+
+def get_plan_cost(pddl_file, search_options):
+    cmd = [sys.executable, DRIVER, "--plan-file", PLAN_FILE, pddl_file,
+           "--search", search_options]
+    print("\nRun {}:".format(cmd))
+    sys.stdout.flush()
+    exitcode = subprocess.call(cmd)
+    if exitcode != 0:
+        return None
+    with open(PLAN_FILE) as f:
+        match = re.search(r"; cost = (\d+)", f.read())
+    os.remove(PLAN_FILE)
+    return int(match.group(1))
+
+
+def main():
+    # On Windows, ./build.py has to be called from the correct environment.
+    # Since we want this script to work even when we are in a regular
+    # shell, we do not build on Windows. If the planner is not yet built,
+    # the driver script will complain about this.
+    if os.name == "posix":
+        subprocess.check_call(["./build.py"], cwd=REPO_BASE)
+
+    failures = []
+    for task in TASKS:
+        pddl_file = os.path.join(BENCHMARKS_DIR, task)
+        optimal_cost = get_plan_cost(pddl_file, REFERENCE_CONFIG)
+        assert optimal_cost is not None
+        for config in CONFIGS:
+            cost = get_plan_cost(pddl_file, config)
+            if cost != optimal_cost:
+                print("{} failed on {}: expected cost {}, got {}".format(
+                    config, task, optimal_cost, cost), file=sys.stderr)
+                failures.append((task, config))
+
+    if failures:
+        print("\nFailures:")
+        for task, config in failures:
+            print("{} on {}".format(config, task))
+        sys.exit(1)
+
+    print("\nNo errors detected.")
+
+
+main()
@@ -75,12 +75,13 @@ fast_downward_plugin(
         search_progress
         search_space
         search_statistics
+        state_data_pool
         state_id
         state_registry
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER SEGMENTED_VECTOR STAMPED_ORDERED_SET SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
     CORE_PLUGIN
 )
 
@@ -117,6 +118,8 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/parallel
+        utils/parallel_options
         utils/rng
         utils/rng_options
         utils/strings
@@ -218,10 +221,10 @@ fast_downward_plugin(
 )
 
 fast_downward_plugin(
-    NAME ORDERED_SET
-    HELP "Set of elements ordered by insertion time"
+    NAME STAMPED_ORDERED_SET
+    HELP "Set of indexed elements ordered by insertion time with epoch-based clearing"
     SOURCES
-        algorithms/ordered_set
+        algorithms/stamped_ordered_set
     DEPENDENCY_ONLY
 )
 
@@ -351,10 +354,18 @@ fast_downward_plugin(
     HELP "Eager search algorithm"
     SOURCES
         search_engines/eager_search
-    DEPENDS NULL_PRUNING_METHOD ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS NULL_PRUNING_METHOD STAMPED_ORDERED_SET SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME EXTERNAL_SEARCH
+    HELP "External-memory A* and breadth-first search"
+    SOURCES
+        search_engines/external_search
+    DEPENDS INT_PACKER SUCCESSOR_GENERATOR TASK_PROPERTIES
+)
+
 fast_downward_plugin(
     NAME PLUGIN_ASTAR
     HELP "A* search"
@@ -416,7 +427,7 @@ fast_downward_plugin(
     HELP "Lazy enforced hill-climbing search algorithm"
     SOURCES
         search_engines/enforced_hill_climbing_search
-    DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
+    DEPENDS G_EVALUATOR PREF_EVALUATOR SEARCH_COMMON STAMPED_ORDERED_SET SUCCESSOR_GENERATOR
 )
 
 fast_downward_plugin(
@@ -431,7 +442,7 @@ fast_downward_plugin(
     HELP "Lazy search algorithm"
     SOURCES
         search_engines/lazy_search
-    DEPENDS ORDERED_SET SUCCESSOR_GENERATOR
+    DEPENDS STAMPED_ORDERED_SET SUCCESSOR_GENERATOR
     DEPENDENCY_ONLY
 )
 
@@ -441,6 +452,7 @@ fast_downward_plugin(
     SOURCES
         lp/lp_internals
         lp/lp_solver
+        lp/native_lp_solver
     DEPENDENCY_ONLY
 )
 
@@ -512,6 +524,7 @@ fast_downward_plugin(
     NAME HM_HEURISTIC
     HELP "The h^m heuristic"
     SOURCES
+        heuristics/h2_engine
         heuristics/hm_heuristic
     DEPENDS TASK_PROPERTIES
 )
@@ -609,6 +622,7 @@ fast_downward_plugin(
         cegar/additive_cartesian_heuristic
         cegar/cartesian_heuristic_function
         cegar/cegar
+        cegar/compact_lists
         cegar/cost_saturation
         cegar/domains
         cegar/refinement_hierarchy
@@ -704,11 +718,13 @@ fast_downward_plugin(
     SOURCES
         pdbs/canonical_pdbs
         pdbs/canonical_pdbs_heuristic
+        pdbs/distance_table
         pdbs/dominance_pruning
         pdbs/incremental_canonical_pdbs
         pdbs/match_tree
         pdbs/max_additive_pdb_sets
         pdbs/max_cliques
+        pdbs/multi_pdb_lookup
         pdbs/pattern_collection_information
         pdbs/pattern_database
         pdbs/pattern_collection_generator_combo
@@ -719,6 +735,7 @@ fast_downward_plugin(
         pdbs/pattern_generator_greedy
         pdbs/pattern_generator_manual
         pdbs/pattern_generator
+        pdbs/pdb_cache
         pdbs/pdb_heuristic
         pdbs/plugin_group
         pdbs/types
@@ -736,6 +753,7 @@ fast_downward_plugin(
         potentials/plugin_group
         potentials/potential_function
         potentials/potential_heuristic
+        potentials/potential_matrix
         potentials/potential_max_heuristic
         potentials/potential_optimizer
         potentials/sample_based_potential_heuristics
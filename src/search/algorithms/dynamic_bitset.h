@@ -17,7 +17,7 @@ class DynamicBitset {
         "Block type must be unsigned");
 
     std::vector<Block> blocks;
-    const std::size_t num_bits;
+    std::size_t num_bits;
 
     static const Block zeros;
     static const Block ones;
@@ -45,6 +45,42 @@ class DynamicBitset {
         return bit_index(num_bits);
     }
 
+    // Return the position of the lowest set bit of a non-zero block.
+    static int lowest_bit(Block block) {
+        assert(block != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(static_cast<unsigned long long>(block));
+#else
+        int pos = 0;
+        while (!(block & Block(1))) {
+            block >>= 1;
+            ++pos;
+        }
+        return pos;
+#endif
+    }
+
+    static int count_bits(Block block) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(static_cast<unsigned long long>(block));
+#else
+        int result = 0;
+        while (block) {
+            block &= block - 1;
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    std::size_t find_from_block(std::size_t first_block) const {
+        for (std::size_t i = first_block; i < blocks.size(); ++i) {
+            if (blocks[i] != zeros)
+                return i * bits_per_block + lowest_bit(blocks[i]);
+        }
+        return npos;
+    }
+
     void zero_unused_bits() {
         const int bits_in_last_block = count_bits_in_last_block();
 
@@ -55,6 +91,8 @@ class DynamicBitset {
     }
 
 public:
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
     explicit DynamicBitset(std::size_t num_bits)
         : blocks(compute_num_blocks(num_bits), zeros),
           num_bits(num_bits) {
@@ -64,16 +102,11 @@ public:
         return num_bits;
     }
 
-    /*
-      Count the number of set bits.
-
-      The computation could be made faster by using a more sophisticated
-      algorithm (see https://en.wikipedia.org/wiki/Hamming_weight).
-    */
+    // Count the number of set bits.
     int count() const {
         int result = 0;
-        for (std::size_t pos = 0; pos < num_bits; ++pos) {
-            result += static_cast<int>(test(pos));
+        for (Block block : blocks) {
+            result += count_bits(block);
         }
         return result;
     }
@@ -106,6 +139,23 @@ public:
         return test(pos);
     }
 
+    // Return the position of the first set bit or npos if there is none.
+    std::size_t find_first() const {
+        return find_from_block(0);
+    }
+
+    // Return the position of the first set bit after pos or npos.
+    std::size_t find_next(std::size_t pos) const {
+        ++pos;
+        if (pos >= num_bits)
+            return npos;
+        std::size_t index = block_index(pos);
+        Block remaining = blocks[index] >> bit_index(pos);
+        if (remaining != zeros)
+            return pos + lowest_bit(remaining);
+        return find_from_block(index + 1);
+    }
+
     bool intersects(const DynamicBitset &other) const {
         assert(size() == other.size());
         for (std::size_t i = 0; i < blocks.size(); ++i) {
@@ -115,6 +165,30 @@ public:
         return false;
     }
 
+    /*
+      Set all bits that are set in other and, if mask is given, also in
+      mask. Call visit(pos) in increasing order for each of these bits that
+      was not set before.
+    */
+    template<typename Visitor>
+    void set_and_visit_new(const DynamicBitset &other, const DynamicBitset *mask,
+                           const Visitor &visit) {
+        assert(size() == other.size());
+        assert(!mask || size() == mask->size());
+        for (std::size_t i = 0; i < blocks.size(); ++i) {
+            Block new_bits = other.blocks[i] & ~blocks[i];
+            if (mask)
+                new_bits &= mask->blocks[i];
+            if (new_bits != zeros) {
+                blocks[i] |= new_bits;
+                do {
+                    visit(i * bits_per_block + lowest_bit(new_bits));
+                    new_bits &= new_bits - 1;
+                } while (new_bits != zeros);
+            }
+        }
+    }
+
     bool is_subset_of(const DynamicBitset &other) const {
         assert(size() == other.size());
         for (std::size_t i = 0; i < blocks.size(); ++i) {
@@ -0,0 +1,98 @@
+#ifndef ALGORITHMS_STAMPED_ORDERED_SET_H
+#define ALGORITHMS_STAMPED_ORDERED_SET_H
+
+#include "../utils/collections.h"
+#include "../utils/rng.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace stamped_ordered_set {
+/*
+  Set of elements ordered by insertion time, like ordered_set::OrderedSet,
+  for element types with small non-negative indices (accessed via
+  get_index(), e.g., OperatorID).
+
+  Instead of a hash set, we store for each index the "epoch" in which the
+  element was last inserted. An element is contained in the set iff its
+  stamp equals the current epoch, so membership tests need no hashing and
+  clearing the set only increments the epoch. The set is meant to be kept
+  around and reused (e.g., once per expansion), so that it does not
+  allocate memory after the first uses.
+*/
+template<typename T>
+class StampedOrderedSet {
+    std::vector<T> ordered_items;
+    std::vector<unsigned int> stamps;
+    unsigned int epoch;
+
+public:
+    StampedOrderedSet()
+        : epoch(1) {
+    }
+
+    bool empty() const {
+        return ordered_items.empty();
+    }
+
+    int size() const {
+        return ordered_items.size();
+    }
+
+    void clear() {
+        ordered_items.clear();
+        ++epoch;
+        if (epoch == 0) {
+            // Overflow: reset all stamps to avoid false positives.
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+        assert(empty());
+    }
+
+    /*
+      If item is not yet included in the set, append it to the end. If
+      it is included, do nothing.
+    */
+    void insert(const T &item) {
+        int index = item.get_index();
+        assert(index >= 0);
+        if (index >= static_cast<int>(stamps.size())) {
+            stamps.resize(index + 1, 0);
+        }
+        if (stamps[index] != epoch) {
+            stamps[index] = epoch;
+            ordered_items.push_back(item);
+        }
+    }
+
+    bool contains(const T &item) const {
+        int index = item.get_index();
+        return index < static_cast<int>(stamps.size()) && stamps[index] == epoch;
+    }
+
+    void shuffle(utils::RandomNumberGenerator &rng) {
+        rng.shuffle(ordered_items);
+    }
+
+    const T &operator[](int pos) const {
+        assert(utils::in_bounds(pos, ordered_items));
+        return ordered_items[pos];
+    }
+
+    const std::vector<T> &get_as_vector() const {
+        return ordered_items;
+    }
+
+    typename std::vector<T>::const_iterator begin() const {
+        return ordered_items.begin();
+    }
+
+    typename std::vector<T>::const_iterator end() const {
+        return ordered_items.end();
+    }
+};
+}
+
+#endif
@@ -49,7 +49,8 @@ public:
     }
 };
 
-AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
+AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy)
+    : supports_incremental_evaluation(false) {
     task_has_axioms = task_properties::has_axioms(task_proxy);
     if (task_has_axioms) {
         VariablesProxy variables = task_proxy.get_variables();
@@ -67,7 +68,10 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
             int num_conditions = cond_effect.get_conditions().size();
             AxiomLiteral *eff_literal = &axiom_literals[effect.var][effect.value];
             rules.emplace_back(
-                num_conditions, effect.var, effect.value, eff_literal);
+                num_conditions, effect.var, effect.value, eff_literal,
+                rule_conditions.size());
+            for (FactProxy condition : cond_effect.get_conditions())
+                rule_conditions.push_back(condition.get_pair());
         }
 
         // Cross-reference rules and literals
@@ -109,7 +113,61 @@ AxiomEvaluator::AxiomEvaluator(const TaskProxy &task_proxy) {
             else
                 default_values.emplace_back(-1);
         }
+
+        axiom_layers.reserve(variables.size());
+        for (VariableProxy var : variables) {
+            axiom_layers.push_back(var.is_derived() ? var.get_axiom_layer() : -1);
+        }
+        for (AxiomRule &rule : rules) {
+            if (!derives_default_value(rule))
+                rule.effect_literal->achieved_by.push_back(&rule);
+        }
+        supports_incremental_evaluation =
+            check_incremental_evaluation_support(task_proxy);
+        if (supports_incremental_evaluation) {
+            removed_condition_rules_by_layer.resize(last_layer + 1);
+            added_condition_rules_by_layer.resize(last_layer + 1);
+            touched.resize(variables.size(), false);
+        }
+    }
+}
+
+bool AxiomEvaluator::check_incremental_evaluation_support(
+    const TaskProxy &task_proxy) const {
+    /*
+      Incremental evaluation relies on the following properties, which
+      the translator guarantees but the task interface does not:
+      - Derived variables are binary, so that a derived variable is
+        "true" iff it does not have its default value.
+      - Rules only have negative (default-value) conditions on derived
+        variables of lower layers and positive conditions on derived
+        variables of lower or the same layer.
+
+      The translator also generates rules deriving the default value
+      of a derived variable, namely the negation of the other rules
+      for the variable. Their body can only be satisfied if the
+      variable holds its default value anyway, so they never change
+      anything in evaluate_aux and we ignore them here.
+    */
+    for (VariableProxy var : task_proxy.get_variables()) {
+        if (var.is_derived() && var.get_domain_size() != 2)
+            return false;
+    }
+    for (const AxiomRule &rule : rules) {
+        if (derives_default_value(rule))
+            continue;
+        int rule_layer = axiom_layers[rule.effect_var];
+        for (int i = 0; i < rule.condition_count; ++i) {
+            const FactPair &condition = rule_conditions[rule.conditions_begin + i];
+            int condition_layer = axiom_layers[condition.var];
+            if (condition_layer > rule_layer)
+                return false;
+            if (condition_layer == rule_layer &&
+                condition.value == default_values[condition.var])
+                return false;
+        }
     }
+    return true;
 }
 
 // TODO rethink the way this is called: see issue348.
@@ -122,6 +180,173 @@ void AxiomEvaluator::evaluate(PackedStateBin *buffer,
     evaluate_aux(buffer, PackedStateAccessor(state_packer));
 }
 
+void AxiomEvaluator::evaluate_incremental(
+    PackedStateBin *buffer, const int_packer::IntPacker &state_packer,
+    const vector<FactPair> &changed_facts) {
+    if (!task_has_axioms)
+        return;
+    if (!supports_incremental_evaluation) {
+        evaluate(buffer, state_packer);
+        return;
+    }
+    evaluate_incremental_aux(buffer, PackedStateAccessor(state_packer), changed_facts);
+
+#ifndef NDEBUG
+    // Compare against evaluating the axioms from scratch.
+    vector<PackedStateBin> copy(buffer, buffer + state_packer.get_num_bins());
+    evaluate(copy.data(), state_packer);
+    for (size_t var_id = 0; var_id < default_values.size(); ++var_id) {
+        assert(state_packer.get(buffer, var_id) ==
+               state_packer.get(copy.data(), var_id));
+    }
+#endif
+}
+
+template<typename Values, typename Accessor>
+inline bool AxiomEvaluator::rule_fires(
+    const AxiomRule &rule, const Values &values, const Accessor &accessor) const {
+    for (int i = 0; i < rule.condition_count; ++i) {
+        const FactPair &condition = rule_conditions[rule.conditions_begin + i];
+        if (accessor.get(values, condition.var) != condition.value)
+            return false;
+    }
+    return true;
+}
+
+void AxiomEvaluator::add_changed_fact(const FactPair &old_fact, int new_value) {
+    /*
+      Changes to a derived variable can only affect rules of higher
+      layers: rules of its own layer have already been processed.
+    */
+    int min_layer = axiom_layers[old_fact.var] + 1;
+    for (const AxiomRule *rule : axiom_literals[old_fact.var][old_fact.value].condition_of) {
+        int layer = axiom_layers[rule->effect_var];
+        if (layer >= min_layer && !derives_default_value(*rule))
+            removed_condition_rules_by_layer[layer].push_back(rule);
+    }
+    for (const AxiomRule *rule : axiom_literals[old_fact.var][new_value].condition_of) {
+        int layer = axiom_layers[rule->effect_var];
+        if (layer >= min_layer && !derives_default_value(*rule))
+            added_condition_rules_by_layer[layer].push_back(rule);
+    }
+}
+
+template<typename Values, typename Accessor>
+void AxiomEvaluator::update_layer(int layer, Values &values, const Accessor &accessor) {
+    /*
+      This is a variant of the delete-rederive (DRed) algorithm for
+      the stratum of the given layer. All lower layers are final.
+    */
+    assert(touched_facts.empty());
+    assert(deletion_queue.empty() && insertion_queue.empty());
+
+    /*
+      Deletion phase: retract all derived facts that are the effect of
+      a rule which lost a condition, and everything that depends on
+      them within the layer. This over-approximates the set of facts
+      that lose their support.
+    */
+    for (const AxiomRule *rule : removed_condition_rules_by_layer[layer]) {
+        int var = rule->effect_var;
+        if (accessor.get(values, var) == rule->effect_val) {
+            touched[var] = true;
+            touched_facts.emplace_back(var, rule->effect_val);
+            accessor.set(values, var, default_values[var]);
+            deletion_queue.push_back(var);
+        }
+    }
+    while (!deletion_queue.empty()) {
+        int var = deletion_queue.back();
+        deletion_queue.pop_back();
+        int derived_value = 1 - default_values[var];
+        for (const AxiomRule *rule : axiom_literals[var][derived_value].condition_of) {
+            int effect_var = rule->effect_var;
+            if (axiom_layers[effect_var] == layer &&
+                !derives_default_value(*rule) &&
+                accessor.get(values, effect_var) == rule->effect_val) {
+                assert(!touched[effect_var]);
+                touched[effect_var] = true;
+                touched_facts.emplace_back(effect_var, rule->effect_val);
+                accessor.set(values, effect_var, default_values[effect_var]);
+                deletion_queue.push_back(effect_var);
+            }
+        }
+    }
+
+    /*
+      Insertion phase: rederive retracted facts that still have a
+      firing rule, fire rules which gained a condition and propagate
+      the new facts within the layer.
+    */
+    for (size_t i = 0; i < touched_facts.size(); ++i) {
+        int var = touched_facts[i].var;
+        const AxiomLiteral &literal = axiom_literals[var][touched_facts[i].value];
+        for (const AxiomRule *rule : literal.achieved_by) {
+            if (rule_fires(*rule, values, accessor)) {
+                accessor.set(values, var, rule->effect_val);
+                insertion_queue.push_back(var);
+                break;
+            }
+        }
+    }
+    for (const AxiomRule *rule : added_condition_rules_by_layer[layer]) {
+        int var = rule->effect_var;
+        if (accessor.get(values, var) != rule->effect_val &&
+            rule_fires(*rule, values, accessor)) {
+            if (!touched[var]) {
+                touched[var] = true;
+                touched_facts.emplace_back(var, default_values[var]);
+            }
+            accessor.set(values, var, rule->effect_val);
+            insertion_queue.push_back(var);
+        }
+    }
+    while (!insertion_queue.empty()) {
+        int var = insertion_queue.back();
+        insertion_queue.pop_back();
+        int derived_value = accessor.get(values, var);
+        for (const AxiomRule *rule : axiom_literals[var][derived_value].condition_of) {
+            int effect_var = rule->effect_var;
+            if (axiom_layers[effect_var] == layer &&
+                !derives_default_value(*rule) &&
+                accessor.get(values, effect_var) != rule->effect_val &&
+                rule_fires(*rule, values, accessor)) {
+                if (!touched[effect_var]) {
+                    touched[effect_var] = true;
+                    touched_facts.emplace_back(effect_var, default_values[effect_var]);
+                }
+                accessor.set(values, effect_var, rule->effect_val);
+                insertion_queue.push_back(effect_var);
+            }
+        }
+    }
+
+    // Pass the net changes of this layer on to the higher layers.
+    for (const FactPair &old_fact : touched_facts) {
+        touched[old_fact.var] = false;
+        int new_value = accessor.get(values, old_fact.var);
+        if (new_value != old_fact.value)
+            add_changed_fact(old_fact, new_value);
+    }
+    touched_facts.clear();
+    removed_condition_rules_by_layer[layer].clear();
+    added_condition_rules_by_layer[layer].clear();
+}
+
+template<typename Values, typename Accessor>
+void AxiomEvaluator::evaluate_incremental_aux(
+    Values &values, const Accessor &accessor, const vector<FactPair> &changed_facts) {
+    for (const FactPair &old_fact : changed_facts) {
+        assert(default_values[old_fact.var] == -1);
+        int new_value = accessor.get(values, old_fact.var);
+        if (new_value != old_fact.value)
+            add_changed_fact(old_fact, new_value);
+    }
+    for (size_t layer = 0; layer < nbf_info_by_layer.size(); ++layer) {
+        update_layer(layer, values, accessor);
+    }
+}
+
 template<typename Values, typename Accessor>
 inline void AxiomEvaluator::evaluate_aux(Values &values, const Accessor &accessor) {
     if (!task_has_axioms)
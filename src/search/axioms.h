@@ -16,6 +16,8 @@ class AxiomEvaluator {
     struct AxiomRule;
     struct AxiomLiteral {
         std::vector<AxiomRule *> condition_of;
+        // Only used for incremental evaluation.
+        std::vector<AxiomRule *> achieved_by;
     };
     struct AxiomRule {
         int condition_count;
@@ -23,9 +25,13 @@ class AxiomEvaluator {
         int effect_var;
         int effect_val;
         AxiomLiteral *effect_literal;
-        AxiomRule(int cond_count, int eff_var, int eff_val, AxiomLiteral *eff_literal)
+        // Position of the first condition in rule_conditions.
+        int conditions_begin;
+        AxiomRule(int cond_count, int eff_var, int eff_val, AxiomLiteral *eff_literal,
+                  int cond_begin)
             : condition_count(cond_count), unsatisfied_conditions(cond_count),
-              effect_var(eff_var), effect_val(eff_val), effect_literal(eff_literal) {
+              effect_var(eff_var), effect_val(eff_val), effect_literal(eff_literal),
+              conditions_begin(cond_begin) {
         }
     };
     struct NegationByFailureInfo {
@@ -53,6 +59,32 @@ class AxiomEvaluator {
     */
     std::vector<int> default_values;
 
+    /*
+      Data for incremental evaluation. axiom_layers is indexed by
+      variable number and set to -1 for non-derived variables.
+      rule_conditions contains the conditions of all rules, grouped by
+      rule. Incremental evaluation is only supported if all derived
+      variables are binary and the layering is stratified (see
+      check_incremental_evaluation_support). Otherwise, we fall back to
+      evaluating the axioms from scratch. Rules deriving the default
+      value of a variable are ignored by the incremental evaluation.
+    */
+    bool supports_incremental_evaluation;
+    std::vector<int> axiom_layers;
+    std::vector<FactPair> rule_conditions;
+    /*
+      Per-layer buckets of rules whose body lost (added) a literal
+      through changes to variables of lower layers, the variables
+      touched while processing the current layer (with their previous
+      value), and queues for the deletion and insertion phases.
+    */
+    std::vector<std::vector<const AxiomRule *>> removed_condition_rules_by_layer;
+    std::vector<std::vector<const AxiomRule *>> added_condition_rules_by_layer;
+    std::vector<bool> touched;
+    std::vector<FactPair> touched_facts;
+    std::vector<int> deletion_queue;
+    std::vector<int> insertion_queue;
+
     /*
       The queue is an instance variable rather than a local variable
       to reduce reallocation effort. See issue420.
@@ -61,11 +93,38 @@ class AxiomEvaluator {
 
     template<typename Values, typename Accessor>
     void evaluate_aux(Values &values, const Accessor &accessor);
+
+    bool check_incremental_evaluation_support(const TaskProxy &task_proxy) const;
+    bool derives_default_value(const AxiomRule &rule) const {
+        return rule.effect_val == default_values[rule.effect_var];
+    }
+    template<typename Values, typename Accessor>
+    bool rule_fires(const AxiomRule &rule, const Values &values,
+                    const Accessor &accessor) const;
+    void add_changed_fact(const FactPair &old_fact, int new_value);
+    template<typename Values, typename Accessor>
+    void update_layer(int layer, Values &values, const Accessor &accessor);
+    template<typename Values, typename Accessor>
+    void evaluate_incremental_aux(Values &values, const Accessor &accessor,
+                                  const std::vector<FactPair> &changed_facts);
 public:
     explicit AxiomEvaluator(const TaskProxy &task_proxy);
 
     void evaluate(PackedStateBin *buffer, const int_packer::IntPacker &state_packer);
     void evaluate(std::vector<int> &state);
+
+    /*
+      Re-evaluate the axioms after applying an operator. The buffer
+      must contain the (fully evaluated) predecessor state with the
+      operator effects applied, and changed_facts must contain the
+      predecessor's facts for all variables modified by the operator.
+      Only rules depending on changed variables are reconsidered:
+      within each layer, derived facts that might have lost their
+      support are first retracted and then rederived where possible.
+    */
+    void evaluate_incremental(PackedStateBin *buffer,
+                              const int_packer::IntPacker &state_packer,
+                              const std::vector<FactPair> &changed_facts);
 };
 
 extern PerTaskInformation<AxiomEvaluator> g_axiom_evaluators;
@@ -1,6 +1,7 @@
 #include "abstract_search.h"
 
 #include "abstract_state.h"
+#include "compact_lists.h"
 #include "transition_system.h"
 #include "utils.h"
 
@@ -12,150 +13,156 @@ using namespace std;
 
 namespace cegar {
 AbstractSearch::AbstractSearch(
-    const vector<int> &operator_costs)
+    const vector<int> &operator_costs, bool debug)
     : operator_costs(operator_costs),
-      search_info(1) {
+      debug(debug) {
 }
 
-void AbstractSearch::reset(int num_states) {
-    open_queue.clear();
-    search_info.resize(num_states);
-    for (AbstractSearchInfo &info : search_info) {
-        info.reset();
-    }
+int AbstractSearch::add_costs(int distance, int op_id) const {
+    assert(utils::in_bounds(op_id, operator_costs));
+    int op_cost = operator_costs[op_id];
+    assert(op_cost >= 0);
+    if (distance == INF || op_cost == INF)
+        return INF;
+    return distance + op_cost;
 }
 
-unique_ptr<Solution> AbstractSearch::extract_solution(int init_id, int goal_id) const {
-    unique_ptr<Solution> solution = utils::make_unique_ptr<Solution>();
-    int current_id = goal_id;
-    while (current_id != init_id) {
-        const Transition &prev = search_info[current_id].get_incoming_transition();
-        solution->emplace_front(prev.op_id, current_id);
-        assert(prev.target_id != current_id);
-        current_id = prev.target_id;
-    }
-    return solution;
+void AbstractSearch::mark_dirty(int state_id) {
+    assert(!dirty[state_id]);
+    dirty[state_id] = true;
+    dirty_states.push_back(state_id);
 }
 
-void AbstractSearch::update_goal_distances(const Solution &solution) {
-    /*
-      Originally, we only updated the goal distances of states that are part of
-      the trace (see Seipp and Helmert, JAIR 2018). The code below generalizes
-      this idea and potentially updates the goal distances of all states.
-
-      Let C* be the cost of the trace and g(s) be the g value of states s when
-      A* finds the trace. Then for all states s with g(s) < INF (i.e., s has
-      been reached by the search), C*-g(s) is a lower bound on the goal
-      distance. This is the case since
-
-      g(s) >= g*(s) [1]
-
-      and
-
-          f*(s) >= C*         (optimality of A* with an admissible heuristic)
-      ==> g*(s) + h*(s) >= C* (definition of f values)
-      ==> g(s) + h*(s) >= C*  (using [1])
-      ==> h*(s) >= C* - g(s)  (arithmetic)
+void AbstractSearch::dijkstra_from_open_queue(
+    const TransitionLists &incoming, bool only_dirty_states) {
+    while (!open_queue.empty()) {
+        pair<int, int> top_pair = open_queue.pop();
+        int old_distance = top_pair.first;
+        int state_id = top_pair.second;
 
-      Together with our existing lower bound h*(s) >= h(s), i.e., the h values
-      from the last iteration, for each abstract state s with g(s) < INF, we
-      can set h(s) = max(h(s), C*-g(s)).
-    */
-    int solution_cost = 0;
-    for (const Transition &transition : solution) {
-        solution_cost += operator_costs[transition.op_id];
-    }
-    for (auto &info : search_info) {
-        if (info.get_g_value() < INF) {
-            int new_h = max(info.get_h_value(), solution_cost - info.get_g_value());
-            info.increase_h_value_to(new_h);
+        const int distance = goal_distances[state_id];
+        assert(0 <= distance && distance < INF);
+        assert(distance <= old_distance);
+        if (distance < old_distance)
+            continue;
+        assert(utils::in_bounds(state_id, incoming));
+        for (const Transition &transition : incoming[state_id]) {
+            int pred_id = transition.target_id;
+            if (only_dirty_states && !dirty[pred_id])
+                continue;
+            int pred_distance = add_costs(distance, transition.op_id);
+            assert(pred_distance >= 0);
+            if (pred_distance < goal_distances[pred_id]) {
+                goal_distances[pred_id] = pred_distance;
+                shortest_path[pred_id] = Transition(transition.op_id, state_id);
+                open_queue.push(pred_distance, pred_id);
+            }
         }
     }
 }
 
-unique_ptr<Solution> AbstractSearch::find_solution(
-    const vector<Transitions> &transitions,
-    int init_id,
-    const Goals &goal_ids) {
-    reset(transitions.size());
-    search_info[init_id].decrease_g_value_to(0);
-    open_queue.push(search_info[init_id].get_h_value(), init_id);
-    int goal_id = astar_search(transitions, goal_ids);
+void AbstractSearch::recompute_goal_distances(
+    const TransitionLists &incoming, const Goals &goals) {
+    int num_states = incoming.size();
     open_queue.clear();
-    bool has_found_solution = (goal_id != UNDEFINED);
-    if (has_found_solution) {
-        unique_ptr<Solution> solution = extract_solution(init_id, goal_id);
-        update_goal_distances(*solution);
-        return solution;
-    } else {
-        search_info[init_id].increase_h_value_to(INF);
+    goal_distances.assign(num_states, INF);
+    shortest_path.assign(num_states, Transition());
+    dirty.assign(num_states, false);
+    for (int goal_id : goals) {
+        goal_distances[goal_id] = 0;
+        open_queue.push(0, goal_id);
     }
-    return nullptr;
+    dijkstra_from_open_queue(incoming, false);
 }
 
-int AbstractSearch::astar_search(
-    const vector<Transitions> &transitions, const Goals &goals) {
-    while (!open_queue.empty()) {
-        pair<int, int> top_pair = open_queue.pop();
-        int old_f = top_pair.first;
-        int state_id = top_pair.second;
+void AbstractSearch::update_goal_distances(
+    const TransitionLists &incoming,
+    const TransitionLists &outgoing,
+    int v1_id, int v2_id, const Goals &goals) {
+    int num_states = incoming.size();
+    assert(v2_id == num_states - 1);
+    goal_distances.resize(num_states, INF);
+    shortest_path.resize(num_states, Transition());
+    dirty.resize(num_states, false);
 
-        const int g = search_info[state_id].get_g_value();
-        assert(0 <= g && g < INF);
-        int new_f = g + search_info[state_id].get_h_value();
-        assert(new_f <= old_f);
-        if (new_f < old_f)
-            continue;
-        if (goals.count(state_id)) {
-            return state_id;
+    /*
+      Collect all states whose shortest path passes through the split
+      state v. Their paths point to v1 (which reuses the ID of v), but
+      the transitions may now end in v2, so we follow the incoming
+      transitions of both new states.
+    */
+    dirty_states.clear();
+    mark_dirty(v1_id);
+    mark_dirty(v2_id);
+    for (size_t i = 0; i < dirty_states.size(); ++i) {
+        int state_id = dirty_states[i];
+        for (const Transition &transition : incoming[state_id]) {
+            int pred_id = transition.target_id;
+            int next_id = shortest_path[pred_id].target_id;
+            if (!dirty[pred_id] && next_id != UNDEFINED && dirty[next_id])
+                mark_dirty(pred_id);
         }
-        assert(utils::in_bounds(state_id, transitions));
-        for (const Transition &transition : transitions[state_id]) {
-            int op_id = transition.op_id;
-            int succ_id = transition.target_id;
-
-            assert(utils::in_bounds(op_id, operator_costs));
-            const int op_cost = operator_costs[op_id];
-            assert(op_cost >= 0);
-            int succ_g = (op_cost == INF) ? INF : g + op_cost;
-            assert(succ_g >= 0);
+    }
 
-            if (succ_g < search_info[succ_id].get_g_value()) {
-                search_info[succ_id].decrease_g_value_to(succ_g);
-                int h = search_info[succ_id].get_h_value();
-                if (h == INF)
+    // Seed the dirty states with transitions into clean states.
+    open_queue.clear();
+    for (int state_id : dirty_states) {
+        int &distance = goal_distances[state_id];
+        Transition &path = shortest_path[state_id];
+        distance = INF;
+        path = Transition();
+        if (goals.count(state_id)) {
+            distance = 0;
+        } else {
+            for (const Transition &transition : outgoing[state_id]) {
+                int succ_id = transition.target_id;
+                if (dirty[succ_id])
                     continue;
-                int f = succ_g + h;
-                assert(f >= 0);
-                assert(f != INF);
-                open_queue.push(f, succ_id);
-                search_info[succ_id].set_incoming_transition(Transition(op_id, state_id));
+                int new_distance = add_costs(
+                    goal_distances[succ_id], transition.op_id);
+                if (new_distance < distance) {
+                    distance = new_distance;
+                    path = transition;
+                }
             }
         }
+        if (distance != INF)
+            open_queue.push(distance, state_id);
     }
-    return UNDEFINED;
-}
+    dijkstra_from_open_queue(incoming, true);
 
-int AbstractSearch::get_h_value(int state_id) const {
-    assert(utils::in_bounds(state_id, search_info));
-    return search_info[state_id].get_h_value();
+    for (int state_id : dirty_states) {
+        dirty[state_id] = false;
+    }
+
+    if (debug)
+        assert(compute_distances(incoming, operator_costs, goals) == goal_distances);
 }
 
-void AbstractSearch::set_h_value(int state_id, int h) {
-    assert(utils::in_bounds(state_id, search_info));
-    search_info[state_id].increase_h_value_to(h);
+unique_ptr<Solution> AbstractSearch::find_solution(
+    int init_id, const Goals &goals) const {
+    if (goal_distances[init_id] == INF)
+        return nullptr;
+    unique_ptr<Solution> solution = utils::make_unique_ptr<Solution>();
+    int current_id = init_id;
+    while (!goals.count(current_id)) {
+        const Transition &next = shortest_path[current_id];
+        assert(next.op_id != UNDEFINED && next.target_id != UNDEFINED);
+        assert(next.target_id != current_id);
+        solution->push_back(next);
+        current_id = next.target_id;
+    }
+    return solution;
 }
 
-void AbstractSearch::copy_h_value_to_children(int v, int v1, int v2) {
-    int h = get_h_value(v);
-    search_info.resize(search_info.size() + 1);
-    set_h_value(v1, h);
-    set_h_value(v2, h);
+int AbstractSearch::get_h_value(int state_id) const {
+    assert(utils::in_bounds(state_id, goal_distances));
+    return goal_distances[state_id];
 }
 
 
 vector<int> compute_distances(
-    const vector<Transitions> &transitions,
+    const TransitionLists &transitions,
     const vector<int> &costs,
     const unordered_set<int> &start_ids) {
     vector<int> distances(transitions.size(), INF);
@@ -14,81 +14,60 @@ namespace cegar {
 using Solution = std::deque<Transition>;
 
 /*
-  Find abstract solutions using A*.
+  Find optimal abstract solutions by maintaining the goal distances and a
+  shortest path tree towards the goal states.
+
+  After a state v is split into v1 and v2, only states whose shortest
+  path passes through v can change their goal distances, since
+  distances never decrease when refining an abstraction. We mark these
+  states as dirty, seed each of them with its cheapest transition into
+  the rest of the abstraction and repair their distances with a
+  Dijkstra search that is restricted to the dirty states.
 */
 class AbstractSearch {
-    class AbstractSearchInfo {
-        int g;
-        int h;
-        Transition incoming_transition;
-public:
-        AbstractSearchInfo()
-            : h(0),
-              incoming_transition(UNDEFINED, UNDEFINED) {
-            reset();
-        }
-
-        void reset() {
-            g = std::numeric_limits<int>::max();
-            incoming_transition = Transition(UNDEFINED, UNDEFINED);
-        }
-
-        void decrease_g_value_to(int new_g) {
-            assert(new_g <= g);
-            g = new_g;
-        }
-
-        int get_g_value() const {
-            return g;
-        }
-
-        void increase_h_value_to(int new_h) {
-            assert(new_h >= h);
-            h = new_h;
-        }
-
-        int get_h_value() const {
-            return h;
-        }
-
-        void set_incoming_transition(const Transition &transition) {
-            incoming_transition = transition;
-        }
-
-        const Transition &get_incoming_transition() const {
-            assert(incoming_transition.op_id != UNDEFINED &&
-                   incoming_transition.target_id != UNDEFINED);
-            return incoming_transition;
-        }
-    };
-
     const std::vector<int> operator_costs;
+    const bool debug;
+
+    std::vector<int> goal_distances;
+    /* First transition on a shortest path to a goal state. Undefined for
+       goal states and dead ends. */
+    std::vector<Transition> shortest_path;
 
     // Keep data structures around to avoid reallocating them.
     priority_queues::AdaptiveQueue<int> open_queue;
-    std::vector<AbstractSearchInfo> search_info;
+    std::vector<bool> dirty;
+    std::vector<int> dirty_states;
 
-    void reset(int num_states);
-    void set_h_value(int state_id, int h);
-    std::unique_ptr<Solution> extract_solution(int init_id, int goal_id) const;
-    void update_goal_distances(const Solution &solution);
-    int astar_search(
-        const std::vector<Transitions> &transitions,
-        const Goals &goals);
+    int add_costs(int distance, int op_id) const;
+    void mark_dirty(int state_id);
+    void dijkstra_from_open_queue(
+        const TransitionLists &incoming, bool only_dirty_states);
 
 public:
-    explicit AbstractSearch(const std::vector<int> &operator_costs);
+    AbstractSearch(const std::vector<int> &operator_costs, bool debug);
+
+    // Compute goal distances for all states from scratch.
+    void recompute_goal_distances(
+        const TransitionLists &incoming, const Goals &goals);
+
+    /*
+      Repair goal distances after v has been split into v1 and v2, where
+      v1 reuses the ID of v.
+    */
+    void update_goal_distances(
+        const TransitionLists &incoming,
+        const TransitionLists &outgoing,
+        int v1_id, int v2_id, const Goals &goals);
+
+    /* Return an optimal solution from init_id along the shortest path
+       tree or nullptr if no goal state is reachable. */
+    std::unique_ptr<Solution> find_solution(int init_id, const Goals &goals) const;
 
-    std::unique_ptr<Solution> find_solution(
-        const std::vector<Transitions> &transitions,
-        int init_id,
-        const Goals &goal_ids);
     int get_h_value(int state_id) const;
-    void copy_h_value_to_children(int v, int v1, int v2);
 };
 
 std::vector<int> compute_distances(
-    const std::vector<Transitions> &transitions,
+    const TransitionLists &transitions,
     const std::vector<int> &costs,
     const std::unordered_set<int> &start_ids);
 }
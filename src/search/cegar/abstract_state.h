@@ -2,6 +2,7 @@
 #define CEGAR_ABSTRACT_STATE_H
 
 #include "domains.h"
+#include "refinement_hierarchy.h"
 #include "types.h"
 
 #include <vector>
@@ -13,20 +14,20 @@ class State;
 class TaskProxy;
 
 namespace cegar {
-class Node;
-
 /*
   Store and update abstract Domains.
 */
 class AbstractState {
-    // Abstract domains for all variables.
-    const Domains domains;
+    int state_id;
 
     // This state's node in the refinement hierarchy.
-    Node *node;
+    NodeID node_id;
+
+    // Abstract domains for all variables.
+    const Domains domains;
 
     // Construct instances with factory methods.
-    AbstractState(const Domains &domains, Node *node);
+    AbstractState(int state_id, NodeID node_id, const Domains &domains);
 
     bool is_more_general_than(const AbstractState &other) const;
 
@@ -48,10 +49,11 @@ public:
     /*
       Split this state into two new states by separating the "wanted" values
       from the other values in the abstract domain and return the resulting two
-      new states.
+      new states. The caller splits the node in the refinement hierarchy.
     */
     std::pair<AbstractState *, AbstractState *> split(
-        int var, const std::vector<int> &wanted, int v1_id, int v2_id);
+        int var, const std::vector<int> &wanted, int v1_id, int v2_id,
+        NodeID v1_node_id, NodeID v2_node_id);
 
     bool includes(const State &concrete_state) const;
     bool includes(const std::vector<FactPair> &facts) const;
@@ -59,6 +61,8 @@ public:
     // IDs are consecutive, so they can be used to index states in vectors.
     int get_id() const;
 
+    NodeID get_node_id() const;
+
     friend std::ostream &operator<<(std::ostream &os, const AbstractState &state) {
         return os << "#" << state.get_id() << state.domains;
     }
@@ -70,7 +74,7 @@ public:
       TODO: Return unique_ptr?
     */
     static AbstractState *get_trivial_abstract_state(
-        const std::vector<int> &domain_sizes, Node *root_node);
+        const std::vector<int> &domain_sizes);
 
     // Create the Cartesian set that corresponds to the given fact conditions.
     static AbstractState get_cartesian_set(
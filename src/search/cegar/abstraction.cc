@@ -72,8 +72,7 @@ void Abstraction::mark_all_states_as_goals() {
 }
 
 void Abstraction::initialize_trivial_abstraction(const vector<int> &domain_sizes) {
-    init = AbstractState::get_trivial_abstract_state(
-        domain_sizes, refinement_hierarchy->get_root());
+    init = AbstractState::get_trivial_abstract_state(domain_sizes);
     goals.insert(init->get_id());
     states.push_back(init);
 }
@@ -87,8 +86,10 @@ pair<int, int> Abstraction::refine(
     // Reuse state ID from obsolete parent to obtain consecutive IDs.
     int v1_id = v_id;
     int v2_id = get_num_states();
+    pair<NodeID, NodeID> node_ids = refinement_hierarchy->split(
+        state->get_node_id(), var, wanted, v1_id, v2_id);
     pair<AbstractState *, AbstractState *> new_states = state->split(
-        var, wanted, v1_id, v2_id);
+        var, wanted, v1_id, v2_id, node_ids.first, node_ids.second);
     AbstractState *v1 = new_states.first;
     AbstractState *v2 = new_states.second;
     delete state;
@@ -131,9 +132,9 @@ pair<int, int> Abstraction::refine(
     };
 }
 
-void Abstraction::print_statistics() const {
-    cout << "States: " << get_num_states() << endl;
-    cout << "Goal states: " << goals.size() << endl;
-    transition_system->print_statistics();
+void Abstraction::print_statistics(ostream &out) const {
+    out << "States: " << get_num_states() << endl;
+    out << "Goal states: " << goals.size() << endl;
+    transition_system->print_statistics(out);
 }
 }
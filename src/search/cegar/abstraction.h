@@ -8,6 +8,7 @@
 #include "../utils/collections.h"
 
 #include <memory>
+#include <ostream>
 #include <vector>
 
 namespace cegar {
@@ -62,7 +63,7 @@ public:
     std::pair<int, int> refine(
         AbstractState *state, int var, const std::vector<int> &wanted);
 
-    void print_statistics() const;
+    void print_statistics(std::ostream &out) const;
 };
 }
 
@@ -10,6 +10,7 @@
 
 #include "../utils/logging.h"
 #include "../utils/markup.h"
+#include "../utils/parallel_options.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -33,7 +34,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         opts.get<bool>("use_general_costs"),
         static_cast<PickSplit>(opts.get<int>("pick")),
         *rng,
-        opts.get<bool>("debug"));
+        opts.get<bool>("debug"),
+        utils::parse_num_threads_from_options(opts));
     return cost_saturation.generate_heuristic_functions(
         opts.get<shared_ptr<AbstractTask>>("transform"));
 }
@@ -45,7 +47,7 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
 }
 
 int AdditiveCartesianHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -91,6 +93,14 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("consistent", "yes");
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
+    parser.document_note(
+        "Parallel refinement",
+        "With num_threads > 1, the abstractions for the subtasks of each "
+        "subtask generator are built concurrently. All of them are refined "
+        "under the costs that remain before the first one, and the cost "
+        "partitioning is computed afterwards. The result is the same for "
+        "all values of num_threads > 1, but differs from the sequential "
+        "computation.");
 
     parser.add_list_option<shared_ptr<SubtaskGenerator>>(
         "subtasks",
@@ -132,6 +142,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "false");
     Heuristic::add_options_to_parser(parser);
     utils::add_rng_options(parser);
+    utils::add_parallel_options(parser);
     Options opts = parser.parse();
 
     if (parser.dry_run())
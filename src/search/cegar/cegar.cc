@@ -72,26 +72,29 @@ CEGAR::CEGAR(
     int max_states,
     int max_non_looping_transitions,
     double max_time,
-    PickSplit pick,
+    unique_ptr<SplitSelector> split_selector,
     utils::RandomNumberGenerator &rng,
-    bool debug)
+    bool debug,
+    ostream &out)
     : task_proxy(*task),
       domain_sizes(get_domain_sizes(task_proxy)),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
-      split_selector(task, pick),
+      split_selector(move(split_selector)),
       abstraction(utils::make_unique_ptr<Abstraction>(task, debug)),
-      abstract_search(task_properties::get_operator_costs(task_proxy)),
+      abstract_search(task_properties::get_operator_costs(task_proxy), debug),
       timer(max_time),
-      debug(debug) {
+      debug(debug),
+      out(out),
+      log(out) {
     assert(max_states >= 1);
-    utils::g_log << "Start building abstraction." << endl;
-    cout << "Maximum number of states: " << max_states << endl;
-    cout << "Maximum number of transitions: "
-         << max_non_looping_transitions << endl;
+    log << "Start building abstraction." << endl;
+    out << "Maximum number of states: " << max_states << endl;
+    out << "Maximum number of transitions: "
+        << max_non_looping_transitions << endl;
     refinement_loop(rng);
-    utils::g_log << "Done building abstraction." << endl;
-    cout << "Time for building abstraction: " << timer.get_elapsed_time() << endl;
+    log << "Done building abstraction." << endl;
+    out << "Time for building abstraction: " << timer.get_elapsed_time() << endl;
 
     print_statistics();
 }
@@ -129,16 +132,16 @@ void CEGAR::separate_facts_unreachable_before_goal() {
 
 bool CEGAR::may_keep_refining() const {
     if (abstraction->get_num_states() >= max_states) {
-        cout << "Reached maximum number of states." << endl;
+        out << "Reached maximum number of states." << endl;
         return false;
     } else if (abstraction->get_transition_system().get_num_non_loops() >= max_non_looping_transitions) {
-        cout << "Reached maximum number of transitions." << endl;
+        out << "Reached maximum number of transitions." << endl;
         return false;
     } else if (timer.is_expired()) {
-        cout << "Reached time limit." << endl;
+        out << "Reached time limit." << endl;
         return false;
     } else if (!utils::extra_memory_padding_is_reserved()) {
-        cout << "Reached memory limit." << endl;
+        out << "Reached memory limit." << endl;
         return false;
     }
     return true;
@@ -163,15 +166,20 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
     find_flaw_timer.stop();
     refine_timer.stop();
 
+    const TransitionSystem &transition_system = abstraction->get_transition_system();
+    find_trace_timer.resume();
+    abstract_search.recompute_goal_distances(
+        transition_system.get_incoming_transitions(), abstraction->get_goals());
+    find_trace_timer.stop();
+
     while (may_keep_refining()) {
         find_trace_timer.resume();
         unique_ptr<Solution> solution = abstract_search.find_solution(
-            abstraction->get_transition_system().get_outgoing_transitions(),
             abstraction->get_initial_state()->get_id(),
             abstraction->get_goals());
         find_trace_timer.stop();
         if (!solution) {
-            cout << "Abstract task is unsolvable." << endl;
+            out << "Abstract task is unsolvable." << endl;
             break;
         }
 
@@ -179,42 +187,46 @@ void CEGAR::refinement_loop(utils::RandomNumberGenerator &rng) {
         unique_ptr<Flaw> flaw = find_flaw(*solution);
         find_flaw_timer.stop();
         if (!flaw) {
-            cout << "Found concrete solution during refinement." << endl;
+            out << "Found concrete solution during refinement." << endl;
             break;
         }
 
         refine_timer.resume();
         AbstractState *abstract_state = flaw->current_abstract_state;
-        int state_id = abstract_state->get_id();
         vector<Split> splits = flaw->get_possible_splits();
-        const Split &split = split_selector.pick_split(*abstract_state, splits, rng);
+        const Split &split = split_selector->pick_split(*abstract_state, splits, rng);
         auto new_state_ids = abstraction->refine(abstract_state, split.var_id, split.values);
-        // Since h-values only increase we can assign the h-value to the children.
-        abstract_search.copy_h_value_to_children(
-            state_id, new_state_ids.first, new_state_ids.second);
         refine_timer.stop();
 
+        find_trace_timer.resume();
+        abstract_search.update_goal_distances(
+            transition_system.get_incoming_transitions(),
+            transition_system.get_outgoing_transitions(),
+            new_state_ids.first, new_state_ids.second,
+            abstraction->get_goals());
+        find_trace_timer.stop();
+
         if (abstraction->get_num_states() % 1000 == 0) {
-            utils::g_log << abstraction->get_num_states() << "/" << max_states << " states, "
-                         << abstraction->get_transition_system().get_num_non_loops() << "/"
-                         << max_non_looping_transitions << " transitions" << endl;
+            log << abstraction->get_num_states() << "/" << max_states << " states, "
+                << abstraction->get_transition_system().get_num_non_loops() << "/"
+                << max_non_looping_transitions << " transitions" << endl;
         }
     }
-    cout << "Time for finding abstract traces: " << find_trace_timer << endl;
-    cout << "Time for finding flaws: " << find_flaw_timer << endl;
-    cout << "Time for splitting states: " << refine_timer << endl;
+    out << "Time for finding abstract traces: " << find_trace_timer << endl;
+    out << "Time for finding flaws: " << find_flaw_timer << endl;
+    out << "Time for splitting states: " << refine_timer << endl;
 }
 
 unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
     if (debug)
-        cout << "Check solution:" << endl;
+        out << "Check solution:" << endl;
 
     AbstractState *abstract_state = abstraction->get_initial_state();
     State concrete_state = task_proxy.get_initial_state();
     assert(abstract_state->includes(concrete_state));
 
     if (debug)
-        cout << "  Initial abstract state: " << *abstract_state << endl;
+        out << "  Initial abstract state: " << *abstract_state << endl;
 
     for (const Transition &step : solution) {
         if (!utils::extra_memory_padding_is_reserved())
@@ -223,12 +235,12 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
         AbstractState *next_abstract_state = abstraction->get_state(step.target_id);
         if (task_properties::is_applicable(op, concrete_state)) {
             if (debug)
-                cout << "  Move to " << *next_abstract_state << " with "
-                     << op.get_name() << endl;
+                out << "  Move to " << *next_abstract_state << " with "
+                    << op.get_name() << endl;
             State next_concrete_state = concrete_state.get_successor(op);
             if (!next_abstract_state->includes(next_concrete_state)) {
                 if (debug)
-                    cout << "  Paths deviate." << endl;
+                    out << "  Paths deviate." << endl;
                 return utils::make_unique_ptr<Flaw>(
                     move(concrete_state),
                     abstract_state,
@@ -238,7 +250,7 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
             concrete_state = move(next_concrete_state);
         } else {
             if (debug)
-                cout << "  Operator not applicable: " << op.get_name() << endl;
+                out << "  Operator not applicable: " << op.get_name() << endl;
             return utils::make_unique_ptr<Flaw>(
                 move(concrete_state),
                 abstract_state,
@@ -252,7 +264,7 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
         return nullptr;
     } else {
         if (debug)
-            cout << "  Goal test failed." << endl;
+            out << "  Goal test failed." << endl;
         return utils::make_unique_ptr<Flaw>(
             move(concrete_state),
             abstract_state,
@@ -262,9 +274,9 @@ unique_ptr<Flaw> CEGAR::find_flaw(const Solution &solution) {
 }
 
 void CEGAR::print_statistics() {
-    abstraction->print_statistics();
+    abstraction->print_statistics(out);
     int init_id = abstraction->get_initial_state()->get_id();
-    cout << "Initial h value: " << abstract_search.get_h_value(init_id) << endl;
-    cout << endl;
+    out << "Initial h value: " << abstract_search.get_h_value(init_id) << endl;
+    out << endl;
 }
 }
@@ -7,8 +7,10 @@
 #include "../task_proxy.h"
 
 #include "../utils/countdown_timer.h"
+#include "../utils/logging.h"
 
 #include <memory>
+#include <ostream>
 
 namespace utils {
 class RandomNumberGenerator;
@@ -24,14 +26,18 @@ struct Flaw;
 
   Store the abstraction, use AbstractSearch to find abstract solutions, find
   flaws, use SplitSelector to select splits in case of ambiguities and break
-  spurious solutions.
+  spurious solutions. After each split, AbstractSearch repairs the goal
+  distances locally instead of searching from scratch.
+
+  All output is written to the given stream, so that abstractions built
+  in parallel can print their output one after the other.
 */
 class CEGAR {
     const TaskProxy task_proxy;
     const std::vector<int> domain_sizes;
     const int max_states;
     const int max_non_looping_transitions;
-    const SplitSelector split_selector;
+    const std::unique_ptr<SplitSelector> split_selector;
 
     std::unique_ptr<Abstraction> abstraction;
     AbstractSearch abstract_search;
@@ -41,6 +47,9 @@ class CEGAR {
 
     const bool debug;
 
+    std::ostream &out;
+    utils::Log log;
+
     bool may_keep_refining() const;
 
     /*
@@ -68,9 +77,10 @@ public:
         int max_states,
         int max_non_looping_transitions,
         double max_time,
-        PickSplit pick,
+        std::unique_ptr<SplitSelector> split_selector,
         utils::RandomNumberGenerator &rng,
-        bool debug);
+        bool debug,
+        std::ostream &out);
     ~CEGAR();
 
     CEGAR(const CEGAR &) = delete;
@@ -0,0 +1,152 @@
+#ifndef CEGAR_COMPACT_LISTS_H
+#define CEGAR_COMPACT_LISTS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace cegar {
+/*
+  Store many growable lists (e.g., the transitions of all abstract
+  states) in a single buffer to avoid the memory overhead of one vector
+  and one heap allocation per list.
+
+  Each list occupies a slice of the buffer with some spare capacity.
+  If a list outgrows its slice, it is moved to the end of the buffer
+  and the old slice becomes garbage. The buffer is compacted when more
+  than half of it is garbage. Appending to any list invalidates all
+  ranges returned by operator[].
+*/
+template<typename T>
+class CompactLists {
+    struct Slice {
+        std::size_t begin;
+        int size;
+        int capacity;
+
+        Slice()
+            : begin(0), size(0), capacity(0) {
+        }
+    };
+
+    std::vector<T> buffer;
+    std::vector<Slice> slices;
+    std::size_t num_garbage_entries;
+
+    void compact() {
+        std::vector<T> new_buffer;
+        std::size_t new_size = buffer.size() - num_garbage_entries;
+        new_buffer.reserve(new_size + new_size / 2);
+        for (Slice &slice : slices) {
+            std::size_t new_begin = new_buffer.size();
+            new_buffer.insert(new_buffer.end(),
+                              buffer.begin() + slice.begin,
+                              buffer.begin() + slice.begin + slice.size);
+            // Keep the spare capacity to avoid moving the list again soon.
+            new_buffer.resize(new_buffer.size() + slice.capacity - slice.size);
+            slice.begin = new_begin;
+        }
+        buffer.swap(new_buffer);
+        num_garbage_entries = 0;
+    }
+
+    void grow(Slice &slice) {
+        int new_capacity = std::max(4, 2 * slice.capacity);
+        if (slice.begin + slice.capacity == buffer.size()) {
+            // The slice is at the end of the buffer and can grow in place.
+            buffer.resize(slice.begin + new_capacity);
+        } else {
+            std::size_t new_begin = buffer.size();
+            buffer.resize(new_begin + new_capacity);
+            std::copy(buffer.begin() + slice.begin,
+                      buffer.begin() + slice.begin + slice.size,
+                      buffer.begin() + new_begin);
+            num_garbage_entries += slice.capacity;
+            slice.begin = new_begin;
+        }
+        slice.capacity = new_capacity;
+    }
+
+public:
+    class Range {
+        const T *first;
+        const T *last;
+public:
+        Range(const T *first, const T *last)
+            : first(first), last(last) {
+        }
+
+        const T *begin() const {
+            return first;
+        }
+
+        const T *end() const {
+            return last;
+        }
+
+        int size() const {
+            return last - first;
+        }
+
+        bool empty() const {
+            return first == last;
+        }
+    };
+
+    CompactLists()
+        : num_garbage_entries(0) {
+    }
+
+    // Return the number of lists.
+    std::size_t size() const {
+        return slices.size();
+    }
+
+    void add_list() {
+        slices.emplace_back();
+    }
+
+    Range operator[](int list_id) const {
+        assert(list_id >= 0 && static_cast<std::size_t>(list_id) < size());
+        const Slice &slice = slices[list_id];
+        const T *first = buffer.data() + slice.begin;
+        return Range(first, first + slice.size);
+    }
+
+    void push_back(int list_id, const T &entry) {
+        assert(list_id >= 0 && static_cast<std::size_t>(list_id) < size());
+        if (slices[list_id].size == slices[list_id].capacity) {
+            if (num_garbage_entries > buffer.size() / 2)
+                compact();
+            grow(slices[list_id]);
+        }
+        Slice &slice = slices[list_id];
+        buffer[slice.begin + slice.size++] = entry;
+    }
+
+    // Remove all entries that match the predicate and return their number.
+    template<typename Predicate>
+    int remove_if(int list_id, const Predicate &pred) {
+        Slice &slice = slices[list_id];
+        auto first = buffer.begin() + slice.begin;
+        auto new_last = std::remove_if(first, first + slice.size, pred);
+        int num_removed = first + slice.size - new_last;
+        slice.size -= num_removed;
+        return num_removed;
+    }
+
+    // Move the entries of a list to the given vector and clear the list.
+    void extract(int list_id, std::vector<T> &entries) {
+        Range range = (*this)[list_id];
+        entries.assign(range.begin(), range.end());
+        slices[list_id].size = 0;
+    }
+
+    std::size_t get_memory_in_bytes() const {
+        return buffer.capacity() * sizeof(T) + slices.capacity() * sizeof(Slice);
+    }
+};
+}
+
+#endif
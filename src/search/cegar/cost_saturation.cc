@@ -5,6 +5,7 @@
 #include "cartesian_heuristic_function.h"
 #include "cegar.h"
 #include "refinement_hierarchy.h"
+#include "split_selector.h"
 #include "subtask_generators.h"
 #include "transition_system.h"
 #include "utils.h"
@@ -14,9 +15,15 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/logging.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
+#include "../utils/rng.h"
 
 #include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
 
 using namespace std;
 
@@ -89,7 +96,8 @@ CostSaturation::CostSaturation(
     bool use_general_costs,
     PickSplit pick_split,
     utils::RandomNumberGenerator &rng,
-    bool debug)
+    bool debug,
+    int num_threads)
     : subtask_generators(subtask_generators),
       max_states(max_states),
       max_non_looping_transitions(max_non_looping_transitions),
@@ -98,6 +106,7 @@ CostSaturation::CostSaturation(
       pick_split(pick_split),
       rng(rng),
       debug(debug),
+      num_threads(num_threads),
       num_abstractions(0),
       num_states(0),
       num_non_looping_transitions(0) {
@@ -187,10 +196,102 @@ bool CostSaturation::state_is_dead_end(const State &state) const {
     return false;
 }
 
+void CostSaturation::add_heuristic_function(unique_ptr<Abstraction> abstraction) {
+    ++num_abstractions;
+    num_states += abstraction->get_num_states();
+    num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
+    assert(num_states <= max_states);
+
+    vector<int> init_distances = compute_distances(
+        abstraction->get_transition_system().get_outgoing_transitions(),
+        remaining_costs,
+        {abstraction->get_initial_state()->get_id()});
+    vector<int> goal_distances = compute_distances(
+        abstraction->get_transition_system().get_incoming_transitions(),
+        remaining_costs,
+        abstraction->get_goals());
+    vector<int> saturated_costs = compute_saturated_costs(
+        abstraction->get_transition_system(),
+        init_distances,
+        goal_distances,
+        use_general_costs);
+
+    heuristic_functions.emplace_back(
+        abstraction->extract_refinement_hierarchy(),
+        move(goal_distances));
+
+    reduce_remaining_costs(saturated_costs);
+}
+
+void CostSaturation::build_abstractions_in_parallel(
+    const vector<shared_ptr<AbstractTask>> &subtasks,
+    const utils::CountdownTimer &timer,
+    function<bool()> should_abort) {
+    int num_subtasks = subtasks.size();
+    assert(num_states < max_states);
+    int max_states_per_subtask = max(1, (max_states - num_states) / num_subtasks);
+    int max_transitions_per_subtask = max(
+        1, (max_non_looping_transitions - num_non_looping_transitions) / num_subtasks);
+    /* Each subtask gets the same share of the remaining time as in the
+       sequential case, but up to num_threads subtasks run at a time. */
+    double max_time_per_subtask =
+        static_cast<double>(timer.get_remaining_time()) *
+        min(num_threads, num_subtasks) / num_subtasks;
+
+    // Prepare the tasks and seeds sequentially to stay deterministic.
+    vector<shared_ptr<AbstractTask>> remaining_costs_subtasks;
+    vector<int> seeds;
+    for (shared_ptr<AbstractTask> subtask : subtasks) {
+        remaining_costs_subtasks.push_back(get_remaining_costs_task(subtask));
+        seeds.push_back(rng(numeric_limits<int>::max()));
+    }
+
+    /*
+      The split selectors print output while computing h^add, so we
+      create them one at a time. CEGAR writes to one buffer per subtask and
+      we print the buffers in the order of the subtasks.
+    */
+    mutex split_selector_mutex;
+    vector<ostringstream> outputs(num_subtasks);
+    vector<unique_ptr<Abstraction>> abstractions(num_subtasks);
+    utils::parallel_for(
+        num_threads, num_subtasks,
+        [&](int, int i) {
+            unique_ptr<SplitSelector> split_selector;
+            {
+                lock_guard<mutex> lock(split_selector_mutex);
+                split_selector = utils::make_unique_ptr<SplitSelector>(
+                    remaining_costs_subtasks[i], pick_split);
+            }
+            utils::RandomNumberGenerator subtask_rng(seeds[i]);
+            CEGAR cegar(
+                remaining_costs_subtasks[i],
+                max_states_per_subtask,
+                max_transitions_per_subtask,
+                max_time_per_subtask,
+                move(split_selector),
+                subtask_rng,
+                debug,
+                outputs[i]);
+            abstractions[i] = cegar.extract_abstraction();
+        });
+
+    for (int i = 0; i < num_subtasks; ++i) {
+        cout << outputs[i].str();
+        add_heuristic_function(move(abstractions[i]));
+        if (should_abort())
+            break;
+    }
+}
+
 void CostSaturation::build_abstractions(
     const vector<shared_ptr<AbstractTask>> &subtasks,
     const utils::CountdownTimer &timer,
     function<bool()> should_abort) {
+    if (num_threads > 1 && subtasks.size() > 1) {
+        build_abstractions_in_parallel(subtasks, timer, should_abort);
+        return;
+    }
     int rem_subtasks = subtasks.size();
     for (shared_ptr<AbstractTask> subtask : subtasks) {
         subtask = get_remaining_costs_task(subtask);
@@ -202,36 +303,12 @@ void CostSaturation::build_abstractions(
             max(1, (max_non_looping_transitions - num_non_looping_transitions) /
                 rem_subtasks),
             timer.get_remaining_time() / rem_subtasks,
-            pick_split,
+            utils::make_unique_ptr<SplitSelector>(subtask, pick_split),
             rng,
-            debug);
-
-        unique_ptr<Abstraction> abstraction = cegar.extract_abstraction();
-        ++num_abstractions;
-        num_states += abstraction->get_num_states();
-        num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states <= max_states);
-
-        vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
-            costs,
-            {abstraction->get_initial_state()->get_id()});
-        vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
-            costs,
-            abstraction->get_goals());
-        vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            init_distances,
-            goal_distances,
-            use_general_costs);
-
-        heuristic_functions.emplace_back(
-            abstraction->extract_refinement_hierarchy(),
-            move(goal_distances));
-
-        reduce_remaining_costs(saturated_costs);
+            debug,
+            cout);
+
+        add_heuristic_function(cegar.extract_abstraction());
 
         if (should_abort())
             break;
@@ -14,6 +14,7 @@ class RandomNumberGenerator;
 }
 
 namespace cegar {
+class Abstraction;
 class CartesianHeuristicFunction;
 class SubtaskGenerator;
 
@@ -23,6 +24,11 @@ class SubtaskGenerator;
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  With more than one thread, the abstractions for the subtasks of each
+  SubtaskGenerator are built concurrently, all using the remaining costs
+  from before the first of them. The cost partitioning is then computed
+  sequentially on the transition systems of the finished abstractions.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators;
@@ -33,6 +39,7 @@ class CostSaturation {
     const PickSplit pick_split;
     utils::RandomNumberGenerator &rng;
     const bool debug;
+    const int num_threads;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions;
     std::vector<int> remaining_costs;
@@ -45,6 +52,11 @@ class CostSaturation {
     std::shared_ptr<AbstractTask> get_remaining_costs_task(
         std::shared_ptr<AbstractTask> &parent) const;
     bool state_is_dead_end(const State &state) const;
+    void add_heuristic_function(std::unique_ptr<Abstraction> abstraction);
+    void build_abstractions_in_parallel(
+        const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
+        const utils::CountdownTimer &timer,
+        std::function<bool()> should_abort);
     void build_abstractions(
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         const utils::CountdownTimer &timer,
@@ -60,7 +72,8 @@ public:
         bool use_general_costs,
         PickSplit pick_split,
         utils::RandomNumberGenerator &rng,
-        bool debug);
+        bool debug,
+        int num_threads = 1);
 
     std::vector<CartesianHeuristicFunction> generate_heuristic_functions(
         const std::shared_ptr<AbstractTask> &task);
@@ -6,66 +6,61 @@ using namespace std;
 
 namespace cegar {
 Node::Node(int state_id)
-    : left_child(nullptr),
-      right_child(nullptr),
+    : left_child(UNDEFINED),
+      right_child(UNDEFINED),
       var(UNDEFINED),
       value(UNDEFINED),
       state_id(state_id) {
     assert(state_id != UNDEFINED);
+    assert(!is_split());
 }
 
-Node::~Node() {
-    if (is_split()) {
-        if (owns_right_child()) {
-            delete right_child;
-        }
-        delete left_child;
-    }
+void Node::split(int var, int value, NodeID left_child, NodeID right_child) {
+    this->var = var;
+    this->value = value;
+    this->left_child = left_child;
+    this->right_child = right_child;
+    state_id = UNDEFINED;
+    assert(is_split());
 }
 
-pair<Node *, Node *> Node::split(
-    int var, const vector<int> &values, int left_state_id, int right_state_id) {
-    Node *helper = this;
-    right_child = new Node(right_state_id);
-    for (int value : values) {
-        Node *new_helper = new Node(left_state_id);
-        helper->var = var;
-        helper->value = value;
-        helper->left_child = new_helper;
-        helper->right_child = right_child;
-        helper->state_id = UNDEFINED;
-        assert(helper->is_split());
-        assert(!new_helper->is_split());
-        helper = new_helper;
-    }
-    return make_pair(helper, right_child);
-}
 
-Node *Node::get_child(int value) const {
-    assert(is_split());
-    if (value == this->value)
-        return right_child;
-    return left_child;
+RefinementHierarchy::RefinementHierarchy(const shared_ptr<AbstractTask> &task)
+    : task(task) {
+    add_node(0);
 }
 
+NodeID RefinementHierarchy::add_node(int state_id) {
+    NodeID node_id = nodes.size();
+    nodes.emplace_back(state_id);
+    return node_id;
+}
 
-RefinementHierarchy::RefinementHierarchy(const shared_ptr<AbstractTask> &task)
-    : task(task),
-      root(new Node(0)) {
+pair<NodeID, NodeID> RefinementHierarchy::split(
+    NodeID node_id, int var, const vector<int> &values,
+    int left_state_id, int right_state_id) {
+    NodeID helper_id = node_id;
+    NodeID right_child_id = add_node(right_state_id);
+    for (int value : values) {
+        NodeID new_helper_id = add_node(left_state_id);
+        nodes[helper_id].split(var, value, new_helper_id, right_child_id);
+        helper_id = new_helper_id;
+    }
+    return make_pair(helper_id, right_child_id);
 }
 
-Node *RefinementHierarchy::get_node(const State &state) const {
-    assert(root);
-    Node *current = root.get();
-    while (current->is_split()) {
-        current = current->get_child(state[current->get_var()].get_value());
+NodeID RefinementHierarchy::get_node_id(const State &state) const {
+    NodeID id = 0;
+    while (nodes[id].is_split()) {
+        const Node &node = nodes[id];
+        id = node.get_child(state[node.get_var()].get_value());
     }
-    return current;
+    return id;
 }
 
 int RefinementHierarchy::get_abstract_state_id(const State &state) const {
     TaskProxy subtask_proxy(*task);
     State subtask_state = subtask_proxy.convert_ancestor_state(state);
-    return get_node(subtask_state)->get_state_id();
+    return nodes[get_node_id(subtask_state)].get_state_id();
 }
 }
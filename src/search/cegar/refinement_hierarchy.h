@@ -12,36 +12,8 @@ class AbstractTask;
 class State;
 
 namespace cegar {
-class Node;
-
-/*
-  This class stores the refinement hierarchy of a Cartesian
-  abstraction. The hierarchy forms a DAG with inner nodes for each
-  split and leaf nodes for the abstract states.
-
-  It is used for efficient lookup of abstract states during search.
-
-  Inner nodes correspond to abstract states that have been split (or
-  helper nodes, see below). Leaf nodes correspond to the current
-  (unsplit) states in an abstraction. The use of helper nodes makes
-  this structure a directed acyclic graph (instead of a tree).
-*/
-class RefinementHierarchy {
-    std::shared_ptr<AbstractTask> task;
-    std::unique_ptr<Node> root;
-
-    Node *get_node(const State &state) const;
-
-public:
-    explicit RefinementHierarchy(const std::shared_ptr<AbstractTask> &task);
-
-    Node *get_root() const {
-        return root.get();
-    }
-
-    int get_abstract_state_id(const State &state) const;
-};
-
+// Nodes are identified by their index in the refinement hierarchy.
+using NodeID = int;
 
 class Node {
     /*
@@ -50,9 +22,8 @@ class Node {
       nodes to the hierarchy to allow for efficient lookup in case more
       than one fact is split off a state.
     */
-    // TODO: Use shared_ptr for left_child and unique_ptr for right_child?
-    Node *left_child;
-    Node *right_child;
+    NodeID left_child;
+    NodeID right_child;
 
     /* Before splitting the corresponding state for var and value, both
        members hold UNDEFINED. */
@@ -64,31 +35,15 @@ class Node {
 
 public:
     explicit Node(int state_id);
-    ~Node();
 
-    Node(const Node &) = delete;
-    Node &operator=(const Node &) = delete;
-
-    /*
-      Update the split tree for the new split. Additionally to the left
-      and right child nodes add |values|-1 helper nodes that all have
-      the right child as their right child and the next helper node as
-      their left child.
-    */
-    std::pair<Node *, Node *> split(
-        int var, const std::vector<int> &values, int left_state_id, int right_state_id);
+    void split(int var, int value, NodeID left_child, NodeID right_child);
 
     bool is_split() const {
-        assert((!left_child && !right_child &&
+        assert((left_child == UNDEFINED && right_child == UNDEFINED &&
                 var == UNDEFINED && value == UNDEFINED && state_id != UNDEFINED) ||
-               (left_child && right_child &&
+               (left_child != UNDEFINED && right_child != UNDEFINED &&
                 var != UNDEFINED && value != UNDEFINED && state_id == UNDEFINED));
-        return left_child;
-    }
-
-    bool owns_right_child() const {
-        assert(is_split());
-        return !left_child->is_split() || left_child->right_child != right_child;
+        return left_child != UNDEFINED;
     }
 
     int get_var() const {
@@ -96,13 +51,57 @@ public:
         return var;
     }
 
-    Node *get_child(int value) const;
+    NodeID get_child(int value) const {
+        assert(is_split());
+        if (value == this->value)
+            return right_child;
+        return left_child;
+    }
 
     int get_state_id() const {
         assert(!is_split());
         return state_id;
     }
 };
+
+
+/*
+  This class stores the refinement hierarchy of a Cartesian
+  abstraction. The hierarchy forms a DAG with inner nodes for each
+  split and leaf nodes for the abstract states.
+
+  It is used for efficient lookup of abstract states during search.
+
+  Inner nodes correspond to abstract states that have been split (or
+  helper nodes, see below). Leaf nodes correspond to the current
+  (unsplit) states in an abstraction. The use of helper nodes makes
+  this structure a directed acyclic graph (instead of a tree).
+
+  All nodes are stored in a single vector and refer to their children
+  by index, which keeps lookups cache-friendly.
+*/
+class RefinementHierarchy {
+    std::shared_ptr<AbstractTask> task;
+    std::vector<Node> nodes;
+
+    NodeID add_node(int state_id);
+    NodeID get_node_id(const State &state) const;
+
+public:
+    explicit RefinementHierarchy(const std::shared_ptr<AbstractTask> &task);
+
+    /*
+      Update the split tree for the new split. Additionally to the left
+      and right child nodes add |values|-1 helper nodes that all have
+      the right child as their right child and the next helper node as
+      their left child.
+    */
+    std::pair<NodeID, NodeID> split(
+        NodeID node_id, int var, const std::vector<int> &values,
+        int left_state_id, int right_state_id);
+
+    int get_abstract_state_id(const State &state) const;
+};
 }
 
 #endif
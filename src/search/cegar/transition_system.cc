@@ -68,12 +68,12 @@ static int lookup_value(const vector<FactPair> &facts, int var) {
 }
 
 static void remove_transitions_with_given_target(
-    Transitions &transitions, int state_id) {
-    auto new_end = remove_if(
-        transitions.begin(), transitions.end(),
+    TransitionLists &transitions, int list_id, int state_id) {
+    int num_removed = transitions.remove_if(
+        list_id,
         [state_id](const Transition &t) {return t.target_id == state_id;});
-    assert(new_end != transitions.end());
-    transitions.erase(new_end, transitions.end());
+    assert(num_removed > 0);
+    utils::unused_variable(num_removed);
 }
 
 
@@ -93,16 +93,15 @@ int TransitionSystem::get_postcondition_value(int op_id, int var) const {
     return lookup_value(postconditions_by_operator[op_id], var);
 }
 
-void TransitionSystem::enlarge_vectors_by_one() {
-    int new_num_states = get_num_states() + 1;
-    outgoing.resize(new_num_states);
-    incoming.resize(new_num_states);
-    loops.resize(new_num_states);
+void TransitionSystem::add_state() {
+    outgoing.add_list();
+    incoming.add_list();
+    loops.add_list();
 }
 
 void TransitionSystem::add_loops_in_trivial_abstraction() {
     assert(get_num_states() == 0);
-    enlarge_vectors_by_one();
+    add_state();
     int init_id = 0;
     for (int i = 0; i < get_num_operators(); ++i) {
         add_loop(init_id, i);
@@ -111,14 +110,14 @@ void TransitionSystem::add_loops_in_trivial_abstraction() {
 
 void TransitionSystem::add_transition(int src_id, int op_id, int target_id) {
     assert(src_id != target_id);
-    outgoing[src_id].emplace_back(op_id, target_id);
-    incoming[target_id].emplace_back(op_id, src_id);
+    outgoing.push_back(src_id, Transition(op_id, target_id));
+    incoming.push_back(target_id, Transition(op_id, src_id));
     ++num_non_loops;
 }
 
 void TransitionSystem::add_loop(int state_id, int op_id) {
     assert(utils::in_bounds(state_id, loops));
-    loops[state_id].push_back(op_id);
+    loops.push_back(state_id, op_id);
     ++num_loops;
 }
 
@@ -135,7 +134,7 @@ void TransitionSystem::rewire_incoming_transitions(
         int u_id = transition.target_id;
         bool is_new_state = updated_states.insert(u_id).second;
         if (is_new_state) {
-            remove_transitions_with_given_target(outgoing[u_id], v1_id);
+            remove_transitions_with_given_target(outgoing, u_id, v1_id);
         }
     }
     num_non_loops -= old_incoming.size();
@@ -180,7 +179,7 @@ void TransitionSystem::rewire_outgoing_transitions(
         int w_id = transition.target_id;
         bool is_new_state = updated_states.insert(w_id).second;
         if (is_new_state) {
-            remove_transitions_with_given_target(incoming[w_id], v1_id);
+            remove_transitions_with_given_target(incoming, w_id, v1_id);
         }
     }
     num_non_loops -= old_outgoing.size();
@@ -275,10 +274,10 @@ void TransitionSystem::rewire_loops(
 void TransitionSystem::rewire(
     const AbstractStates &states, int v_id, AbstractState *v1, AbstractState *v2, int var) {
     // Retrieve old transitions and make space for new transitions.
-    Transitions old_incoming = move(incoming[v_id]);
-    Transitions old_outgoing = move(outgoing[v_id]);
-    Loops old_loops = move(loops[v_id]);
-    enlarge_vectors_by_one();
+    incoming.extract(v_id, split_state_incoming);
+    outgoing.extract(v_id, split_state_outgoing);
+    loops.extract(v_id, split_state_loops);
+    add_state();
     int v1_id = v1->get_id();
     int v2_id = v2->get_id();
     utils::unused_variable(v1_id);
@@ -287,20 +286,20 @@ void TransitionSystem::rewire(
     assert(incoming[v2_id].empty() && outgoing[v2_id].empty() && loops[v2_id].empty());
 
     // Remove old transitions and add new transitions.
-    rewire_incoming_transitions(old_incoming, states, v1, v2, var);
-    rewire_outgoing_transitions(old_outgoing, states, v1, v2, var);
-    rewire_loops(old_loops, v1, v2, var);
+    rewire_incoming_transitions(split_state_incoming, states, v1, v2, var);
+    rewire_outgoing_transitions(split_state_outgoing, states, v1, v2, var);
+    rewire_loops(split_state_loops, v1, v2, var);
 }
 
-const vector<Transitions> &TransitionSystem::get_incoming_transitions() const {
+const TransitionLists &TransitionSystem::get_incoming_transitions() const {
     return incoming;
 }
 
-const vector<Transitions> &TransitionSystem::get_outgoing_transitions() const {
+const TransitionLists &TransitionSystem::get_outgoing_transitions() const {
     return outgoing;
 }
 
-const vector<Loops> &TransitionSystem::get_loops() const {
+const LoopLists &TransitionSystem::get_loops() const {
     return loops;
 }
 
@@ -322,7 +321,7 @@ int TransitionSystem::get_num_loops() const {
     return num_loops;
 }
 
-void TransitionSystem::print_statistics() const {
+void TransitionSystem::print_statistics(ostream &out) const {
     int total_incoming_transitions = 0;
     int total_outgoing_transitions = 0;
     int total_loops = 0;
@@ -334,7 +333,10 @@ void TransitionSystem::print_statistics() const {
     assert(total_outgoing_transitions == total_incoming_transitions);
     assert(get_num_loops() == total_loops);
     assert(get_num_non_loops() == total_outgoing_transitions);
-    cout << "Looping transitions: " << total_loops << endl;
-    cout << "Non-looping transitions: " << total_outgoing_transitions << endl;
+    out << "Looping transitions: " << total_loops << endl;
+    out << "Non-looping transitions: " << total_outgoing_transitions << endl;
+    out << "Transition system memory: "
+         << incoming.get_memory_in_bytes() + outgoing.get_memory_in_bytes() +
+        loops.get_memory_in_bytes() << " bytes" << endl;
 }
 }
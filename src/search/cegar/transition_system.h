@@ -1,8 +1,11 @@
 #ifndef CEGAR_TRANSITION_SYSTEM_H
 #define CEGAR_TRANSITION_SYSTEM_H
 
+#include "compact_lists.h"
+#include "transition.h"
 #include "types.h"
 
+#include <ostream>
 #include <vector>
 
 struct FactPair;
@@ -11,22 +14,30 @@ class OperatorsProxy;
 namespace cegar {
 /*
   Rewire transitions after each split.
+
+  The transitions and self-loops of all states are stored in
+  CompactLists, which avoid the overhead of separate vectors per state.
 */
 class TransitionSystem {
     const std::vector<std::vector<FactPair>> preconditions_by_operator;
     const std::vector<std::vector<FactPair>> postconditions_by_operator;
 
     // Transitions from and to other abstract states.
-    std::vector<Transitions> incoming;
-    std::vector<Transitions> outgoing;
+    TransitionLists incoming;
+    TransitionLists outgoing;
 
     // Store self-loops (operator indices) separately to save space.
-    std::vector<Loops> loops;
+    LoopLists loops;
 
     int num_non_loops;
     int num_loops;
 
-    void enlarge_vectors_by_one();
+    // Old transitions of the last split state, kept to avoid reallocation.
+    Transitions split_state_incoming;
+    Transitions split_state_outgoing;
+    Loops split_state_loops;
+
+    void add_state();
 
     // Add self-loops to single abstract state in trivial abstraction.
     void add_loops_in_trivial_abstraction();
@@ -53,16 +64,16 @@ public:
     void rewire(
         const AbstractStates &states, int v_id, AbstractState *v1, AbstractState *v2, int var);
 
-    const std::vector<Transitions> &get_incoming_transitions() const;
-    const std::vector<Transitions> &get_outgoing_transitions() const;
-    const std::vector<Loops> &get_loops() const;
+    const TransitionLists &get_incoming_transitions() const;
+    const TransitionLists &get_outgoing_transitions() const;
+    const LoopLists &get_loops() const;
 
     int get_num_states() const;
     int get_num_operators() const;
     int get_num_non_loops() const;
     int get_num_loops() const;
 
-    void print_statistics() const;
+    void print_statistics(std::ostream &out) const;
 };
 }
 
@@ -8,11 +8,16 @@
 namespace cegar {
 class AbstractState;
 struct Transition;
+template<typename T>
+class CompactLists;
 
 using AbstractStates = std::vector<AbstractState *>;
 using Goals = std::unordered_set<int>;
 using Loops = std::vector<int>;
 using Transitions = std::vector<Transition>;
+// Loops and transitions of all abstract states.
+using LoopLists = CompactLists<int>;
+using TransitionLists = CompactLists<Transition>;
 
 const int UNDEFINED = -1;
 
@@ -4,6 +4,8 @@
 #include "evaluator.h"
 #include "search_statistics.h"
 
+#include "utils/memory.h"
+
 #include <cassert>
 
 using namespace std;
@@ -16,7 +18,9 @@ EvaluationContext::EvaluationContext(
       g_value(g_value),
       preferred(is_preferred),
       statistics(statistics),
-      calculate_preferred(calculate_preferred) {
+      calculate_preferred(calculate_preferred),
+      applicable_operators(nullptr),
+      state_owner(nullptr) {
 }
 
 EvaluationContext::EvaluationContext(
@@ -31,17 +35,28 @@ EvaluationContext::EvaluationContext(
     : EvaluationContext(EvaluatorCache(state), INVALID, false, statistics, calculate_preferred) {
 }
 
+EvaluationContext::EvaluationContext(
+    EvaluationContext &state_owner, int g_value, bool is_preferred,
+    SearchStatistics *statistics)
+    : EvaluationContext(EvaluatorCache(state_owner.get_state()), g_value, is_preferred, statistics) {
+    this->state_owner = &state_owner;
+}
+
 const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
-    EvaluationResult &result = cache[evaluator];
-    if (result.is_uninitialized()) {
-        result = evaluator->compute_result(*this);
+    if (cache[evaluator].is_uninitialized()) {
+        /*
+          Computing the result may store results of other evaluators in the
+          cache, so we only look up the entry again afterwards.
+        */
+        EvaluationResult result = evaluator->compute_result(*this);
         if (statistics &&
             evaluator->is_used_for_counting_evaluations() &&
             result.get_count_evaluation()) {
             statistics->inc_evaluations();
         }
+        cache[evaluator] = move(result);
     }
-    return result;
+    return cache[evaluator];
 }
 
 const EvaluatorCache &EvaluationContext::get_cache() const {
@@ -52,6 +67,26 @@ const GlobalState &EvaluationContext::get_state() const {
     return cache.get_state();
 }
 
+const State &EvaluationContext::get_unpacked_state(const TaskProxy &task_proxy) {
+    if (state_owner) {
+        return state_owner->get_unpacked_state(task_proxy);
+    }
+    if (unpacked_states.empty()) {
+        unpacked_states.push_back(
+            utils::make_unique_ptr<State>(get_state().unpack()));
+    }
+    TaskID task_id = task_proxy.get_id();
+    for (const unique_ptr<State> &state : unpacked_states) {
+        if (state->get_task().get_id() == task_id) {
+            return *state;
+        }
+    }
+    unpacked_states.push_back(
+        utils::make_unique_ptr<State>(
+            task_proxy.convert_ancestor_state(*unpacked_states.front())));
+    return *unpacked_states.back();
+}
+
 int EvaluationContext::get_g_value() const {
     assert(g_value != INVALID);
     return g_value;
@@ -85,3 +120,22 @@ EvaluationContext::get_preferred_operators(Evaluator *eval) {
 bool EvaluationContext::get_calculate_preferred() const {
     return calculate_preferred;
 }
+
+void EvaluationContext::set_applicable_operators(
+    const vector<OperatorID> *applicable_ops) {
+    applicable_operators = applicable_ops;
+    applicable_operators_generator = nullptr;
+}
+
+void EvaluationContext::set_applicable_operators_generator(
+    const function<const vector<OperatorID> &()> &generator) {
+    applicable_operators = nullptr;
+    applicable_operators_generator = generator;
+}
+
+const vector<OperatorID> *EvaluationContext::get_applicable_operators() {
+    if (!applicable_operators && applicable_operators_generator) {
+        applicable_operators = &applicable_operators_generator();
+    }
+    return applicable_operators;
+}
@@ -4,8 +4,11 @@
 #include "evaluation_result.h"
 #include "evaluator_cache.h"
 #include "operator_id.h"
+#include "task_proxy.h"
 
-#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <vector>
 
 class Evaluator;
 class GlobalState;
@@ -38,6 +41,10 @@ class SearchStatistics;
      tie-breaking open list based on <g + h, h> and a third time for
      its "progress evaluator" that produces output whenever we reach a
      new best f value.
+
+  It also caches the unpacked state, so that heuristics evaluated in the
+  same context (see Heuristic::convert_global_state()) unpack the state
+  only once.
 */
 
 class EvaluationContext {
@@ -46,6 +53,17 @@ class EvaluationContext {
     bool preferred;
     SearchStatistics *statistics;
     bool calculate_preferred;
+    const std::vector<OperatorID> *applicable_operators;
+    std::function<const std::vector<OperatorID> &()> applicable_operators_generator;
+    /*
+      The state unpacked for the tasks (e.g., the root task and a
+      cost-adapted task) that evaluators asked for so far. The first entry
+      is the state of the root task. We use pointers to keep references
+      valid while new entries are added.
+    */
+    std::vector<std::unique_ptr<State>> unpacked_states;
+    // Context whose unpacked states we use instead of our own (or nullptr).
+    EvaluationContext *state_owner;
 
     static const int INVALID = -1;
 
@@ -81,12 +99,30 @@ public:
     EvaluationContext(
         const GlobalState &state,
         SearchStatistics *statistics = nullptr, bool calculate_preferred = false);
+    /*
+      Create a new heuristic cache for the state of the given context, but
+      share its unpacked state. Used by evaluators that evaluate other
+      evaluators internally without affecting the results and statistics of
+      the search. The given context must outlive the new one.
+    */
+    EvaluationContext(
+        EvaluationContext &state_owner, int g_value, bool is_preferred,
+        SearchStatistics *statistics);
 
+    EvaluationContext(EvaluationContext &&other) = default;
     ~EvaluationContext() = default;
 
+    EvaluationContext &operator=(EvaluationContext &&other) = default;
+
     const EvaluationResult &get_result(Evaluator *eval);
     const EvaluatorCache &get_cache() const;
     const GlobalState &get_state() const;
+    /*
+      Return the state as a State of the given task, which has to be the
+      root task or a transformation of it. The state is unpacked on first
+      use for each task and stays valid as long as this context exists.
+    */
+    const State &get_unpacked_state(const TaskProxy &task_proxy);
     int get_g_value() const;
     bool is_preferred() const;
 
@@ -106,6 +142,26 @@ public:
     int get_evaluator_value_or_infinity(Evaluator *eval);
     const std::vector<OperatorID> &get_preferred_operators(Evaluator *eval);
     bool get_calculate_preferred() const;
+
+    /*
+      Search engines that generate the applicable operators of the state
+      before evaluating it can register them here, so that evaluators
+      computing preferred operators don't have to generate them a second
+      time. The operator IDs refer to the root task. The vector is not
+      copied and must stay alive while evaluators are queried through
+      this context. Contexts created from the cache of another context
+      do not inherit the registered operators.
+    */
+    void set_applicable_operators(const std::vector<OperatorID> *applicable_ops);
+    /*
+      Like set_applicable_operators(), but the operators are only generated
+      by calling generator when an evaluator asks for them for the first
+      time. The returned vector must stay alive as described above.
+    */
+    void set_applicable_operators_generator(
+        const std::function<const std::vector<OperatorID> &()> &generator);
+    // Returns nullptr if no applicable operators have been registered.
+    const std::vector<OperatorID> *get_applicable_operators();
 };
 
 #endif
@@ -9,12 +9,14 @@
 
 using namespace std;
 
+atomic<int> Evaluator::num_evaluators(0);
 
 Evaluator::Evaluator(const string &description,
                      bool use_for_reporting_minima,
                      bool use_for_boosting,
                      bool use_for_counting_evaluations)
-    : description(description),
+    : id(num_evaluators++),
+      description(description),
       use_for_reporting_minima(use_for_reporting_minima),
       use_for_boosting(use_for_boosting),
       use_for_counting_evaluations(use_for_counting_evaluations) {
@@ -3,12 +3,21 @@
 
 #include "evaluation_result.h"
 
+#include <atomic>
 #include <set>
 
 class EvaluationContext;
 class GlobalState;
 
 class Evaluator {
+    // Atomic because some evaluators are created in parallel (e.g., by CEGAR).
+    static std::atomic<int> num_evaluators;
+
+    /*
+      Evaluators are numbered consecutively in the order of their creation.
+      EvaluationContext uses the IDs to store results in a flat array.
+    */
+    const int id;
     const std::string description;
     const bool use_for_reporting_minima;
     const bool use_for_boosting;
@@ -43,6 +52,19 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      get_involved_evaluators should insert this evaluator and all
+      evaluators that it directly or indirectly depends on into the result
+      set. Search engines use it to print the statistics of all evaluators
+      they use.
+    */
+    virtual void get_involved_evaluators(std::set<const Evaluator *> &evals) const {
+        evals.insert(this);
+    }
+
+    // Print statistics when the search engine prints its statistics.
+    virtual void print_statistics() const {
+    }
 
     virtual void notify_initial_state(const GlobalState & /*initial_state*/) {
     }
@@ -79,6 +101,15 @@ public:
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
+    int get_id() const {
+        return id;
+    }
+
+    // Return the number of evaluators created so far (an upper bound on IDs).
+    static int get_num_evaluators() {
+        return num_evaluators;
+    }
+
     const std::string &get_description() const;
     bool is_used_for_reporting_minima() const;
     bool is_used_for_boosting() const;
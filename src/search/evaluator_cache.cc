@@ -1,5 +1,9 @@
 #include "evaluator_cache.h"
 
+#include "evaluator.h"
+
+#include <algorithm>
+
 using namespace std;
 
 
@@ -8,7 +12,14 @@ EvaluatorCache::EvaluatorCache(const GlobalState &state)
 }
 
 EvaluationResult &EvaluatorCache::operator[](Evaluator *eval) {
-    return eval_results[eval];
+    int id = eval->get_id();
+    if (id >= static_cast<int>(eval_results.size())) {
+        int size = max(id + 1, Evaluator::get_num_evaluators());
+        eval_results.resize(size);
+        evaluators.resize(size, nullptr);
+    }
+    evaluators[id] = eval;
+    return eval_results[id];
 }
 
 const GlobalState &EvaluatorCache::get_state() const {
@@ -4,17 +4,22 @@
 #include "evaluation_result.h"
 #include "global_state.h"
 
-#include <unordered_map>
+#include <vector>
 
 class Evaluator;
 
-using EvaluationResults = std::unordered_map<Evaluator *, EvaluationResult>;
-
 /*
   Store a state and evaluation results for this state.
+
+  The results are stored in a flat vector indexed by the IDs of the
+  evaluators (see Evaluator::get_id()). We size the vector for all evaluators
+  that exist when the first result is stored, so references to results stay
+  valid unless evaluators are created while the cache is in use.
 */
 class EvaluatorCache {
-    EvaluationResults eval_results;
+    std::vector<EvaluationResult> eval_results;
+    // Evaluator of each entry, nullptr for unused entries.
+    std::vector<Evaluator *> evaluators;
     GlobalState state;
 
 public:
@@ -27,10 +32,11 @@ public:
 
     template<class Callback>
     void for_each_evaluator_result(const Callback &callback) const {
-        for (const auto &element : eval_results) {
-            const Evaluator *eval = element.first;
-            const EvaluationResult &result = element.second;
-            callback(eval, result);
+        for (size_t id = 0; id < evaluators.size(); ++id) {
+            const Evaluator *eval = evaluators[id];
+            if (eval) {
+                callback(eval, eval_results[id]);
+            }
         }
     }
 };
@@ -50,4 +50,11 @@ void CombiningEvaluator::get_path_dependent_evaluators(
     for (auto &subevaluator : subevaluators)
         subevaluator->get_path_dependent_evaluators(evals);
 }
+
+void CombiningEvaluator::get_involved_evaluators(
+    set<const Evaluator *> &evals) const {
+    evals.insert(this);
+    for (auto &subevaluator : subevaluators)
+        subevaluator->get_involved_evaluators(evals);
+}
 }
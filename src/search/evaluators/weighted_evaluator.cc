@@ -44,6 +44,11 @@ void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+void WeightedEvaluator::get_involved_evaluators(set<const Evaluator *> &evals) const {
+    evals.insert(this);
+    evaluator->get_involved_evaluators(evals);
+}
+
 static shared_ptr<Evaluator> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Weighted evaluator",
@@ -12,12 +12,17 @@ using namespace std;
 
 
 GlobalState::GlobalState(
-    const PackedStateBin *buffer, const StateRegistry &registry, StateID id)
+    const PackedStateBin *buffer, const StateRegistry &registry, StateID id,
+    int *pin_count)
     : buffer(buffer),
       registry(&registry),
-      id(id) {
+      id(id),
+      pin_count(pin_count) {
     assert(buffer);
     assert(id != StateID::no_state);
+    if (pin_count) {
+        ++*pin_count;
+    }
 }
 
 int GlobalState::operator[](int var) const {
@@ -26,10 +26,17 @@ class GlobalState {
     // registry isn't a reference because we want to support operator=
     const StateRegistry *registry;
     StateID id;
+    /*
+      Pin counter of the storage segment containing buffer, which must stay
+      in memory while the state exists. It is nullptr if the registry keeps
+      all states in memory (see StateDataPool).
+    */
+    int *pin_count;
 
     // Only used by the state registry.
     GlobalState(
-        const PackedStateBin *buffer, const StateRegistry &registry, StateID id);
+        const PackedStateBin *buffer, const StateRegistry &registry, StateID id,
+        int *pin_count = nullptr);
 
     const PackedStateBin *get_packed_buffer() const {
         return buffer;
@@ -39,7 +46,35 @@ class GlobalState {
         return *registry;
     }
 public:
-    ~GlobalState() = default;
+    GlobalState(const GlobalState &other)
+        : buffer(other.buffer),
+          registry(other.registry),
+          id(other.id),
+          pin_count(other.pin_count) {
+        if (pin_count) {
+            ++*pin_count;
+        }
+    }
+
+    GlobalState &operator=(const GlobalState &other) {
+        if (other.pin_count) {
+            ++*other.pin_count;
+        }
+        if (pin_count) {
+            --*pin_count;
+        }
+        buffer = other.buffer;
+        registry = other.registry;
+        id = other.id;
+        pin_count = other.pin_count;
+        return *this;
+    }
+
+    ~GlobalState() {
+        if (pin_count) {
+            --*pin_count;
+        }
+    }
 
     StateID get_id() const {
         return id;
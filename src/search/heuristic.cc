@@ -9,6 +9,8 @@
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
 
+#include "utils/memory.h"
+
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -17,6 +19,7 @@ using namespace std;
 
 Heuristic::Heuristic(const Options &opts)
     : Evaluator(opts.get_unparsed_config(), true, true, true),
+      current_eval_context(nullptr),
       heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
@@ -30,8 +33,24 @@ void Heuristic::set_preferred(const OperatorProxy &op) {
     preferred_operators.insert(op.get_ancestor_operator_id(tasks::g_root_task.get()));
 }
 
-State Heuristic::convert_global_state(const GlobalState &global_state) const {
-    return task_proxy.convert_ancestor_state(global_state.unpack());
+const vector<OperatorID> *Heuristic::get_applicable_operators() const {
+    assert(current_eval_context);
+    return current_eval_context->get_applicable_operators();
+}
+
+EvaluationContext &Heuristic::get_current_eval_context() const {
+    assert(current_eval_context);
+    return *current_eval_context;
+}
+
+const State &Heuristic::convert_global_state(const GlobalState &global_state) {
+    if (current_eval_context &&
+        current_eval_context->get_state().get_id() == global_state.get_id()) {
+        return current_eval_context->get_unpacked_state(task_proxy);
+    }
+    converted_state = utils::make_unique_ptr<State>(
+        task_proxy.convert_ancestor_state(global_state.unpack()));
+    return *converted_state;
 }
 
 void Heuristic::add_options_to_parser(OptionParser &parser) {
@@ -58,7 +77,9 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
     } else {
+        current_eval_context = &eval_context;
         heuristic = compute_heuristic(state);
+        current_eval_context = nullptr;
         if (cache_evaluator_values) {
             heuristic_cache[state] = HEntry(heuristic, false);
         }
@@ -90,8 +111,9 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
 #endif
 
     result.set_evaluator_value(heuristic);
-    result.set_preferred_operators(preferred_operators.pop_as_vector());
-    assert(preferred_operators.empty());
+    result.set_preferred_operators(
+        vector<OperatorID>(preferred_operators.begin(), preferred_operators.end()));
+    preferred_operators.clear();
 
     return result;
 }
@@ -6,7 +6,7 @@
 #include "per_state_information.h"
 #include "task_proxy.h"
 
-#include "algorithms/ordered_set.h"
+#include "algorithms/stamped_ordered_set.h"
 
 #include <memory>
 #include <vector>
@@ -42,7 +42,16 @@ class Heuristic : public Evaluator {
       being able to reuse the data structure from one iteration to the
       next, but this seems to be the only potential downside.
     */
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
+    stamped_ordered_set::StampedOrderedSet<OperatorID> preferred_operators;
+
+    /*
+      Context of the state that is currently being evaluated. Only set
+      during calls to compute_heuristic().
+    */
+    EvaluationContext *current_eval_context;
+
+    // Storage for states converted outside of an evaluation.
+    std::unique_ptr<State> converted_state;
 
 protected:
     /*
@@ -71,9 +80,34 @@ protected:
     */
     void set_preferred(const OperatorProxy &op);
 
-    /* TODO: Make private and use State instead of GlobalState once all
-       heuristics use the TaskProxy class. */
-    State convert_global_state(const GlobalState &global_state) const;
+    /*
+      Return the applicable operators of the state passed to
+      compute_heuristic() if the search engine has already generated them,
+      or nullptr otherwise. The operator IDs refer to the root task, so
+      heuristics may only use them if their task has the same operators as
+      the root task (e.g., the root task itself or a cost-adapted task).
+    */
+    const std::vector<OperatorID> *get_applicable_operators() const;
+
+    /*
+      Return the evaluation context passed to compute_result(). Heuristics
+      that evaluate other evaluators internally can use it to share the
+      unpacked state (see EvaluationContext). May only be called during
+      compute_heuristic().
+    */
+    EvaluationContext &get_current_eval_context() const;
+
+    /*
+      Convert the given state into a state of this heuristic's task. The
+      state that is currently being evaluated is unpacked only once per
+      task and shared with all other heuristics evaluated in the same
+      context. The reference stays valid until the evaluation ends or, for
+      other states, until the next call of this method.
+
+      TODO: Make private and use State instead of GlobalState once all
+      heuristics use the TaskProxy class.
+    */
+    const State &convert_global_state(const GlobalState &global_state);
 
 public:
     explicit Heuristic(const options::Options &opts);
@@ -3,8 +3,7 @@
 #include "../task_proxy.h"
 
 #include "../task_utils/causal_graph.h"
-#include "../utils/collections.h"
-#include "../utils/math.h"
+#include "../utils/hash.h"
 
 #include <algorithm>
 #include <cassert>
@@ -14,9 +13,16 @@
 using namespace std;
 
 namespace cg_heuristic {
-const int CGCache::NOT_COMPUTED;
+// Capacity of the table of a variable after the first entry is added.
+static const int INITIAL_CAPACITY = 16;
 
-CGCache::CGCache(TaskProxy &task_proxy) : task_proxy(task_proxy) {
+const int CGCache::NOT_CACHED;
+
+CGCache::CGCache(const TaskProxy &task_proxy, size_t max_bytes)
+    : task_proxy(task_proxy),
+      max_bytes(max_bytes),
+      num_bytes(0),
+      num_evictions(0) {
     cout << "Initializing heuristic cache... " << flush;
 
     int var_count = task_proxy.get_variables().size();
@@ -50,18 +56,14 @@ CGCache::CGCache(TaskProxy &task_proxy) : task_proxy(task_proxy) {
                               depends_on[var].end());
     }
 
-    cache.resize(var_count);
-    helpful_transition_cache.resize(var_count);
-
+    variable_caches.resize(var_count);
     for (int var = 0; var < var_count; ++var) {
-        int required_cache_size = compute_required_cache_size(
-            var, depends_on[var]);
-        if (required_cache_size != -1) {
-            //  cout << "Cache for var " << var << ": "
-            //       << required_cache_size << " entries" << endl;
-            cache[var].resize(required_cache_size, NOT_COMPUTED);
-            helpful_transition_cache[var].resize(required_cache_size, 0);
-        }
+        VariableCache &var_cache = variable_caches[var];
+        var_cache.key_size = depends_on[var].size() + 1;
+        var_cache.num_values = task_proxy.get_variables()[var].get_domain_size();
+        var_cache.capacity = 0;
+        var_cache.num_entries = 0;
+        var_cache.clock_hand = 0;
     }
 
     cout << "done!" << endl;
@@ -70,63 +72,159 @@ CGCache::CGCache(TaskProxy &task_proxy) : task_proxy(task_proxy) {
 CGCache::~CGCache() {
 }
 
-int CGCache::compute_required_cache_size(
-    int var_id, const vector<int> &depends_on) const {
+void CGCache::compute_key(int var, const State &state, int from_val) {
+    const vector<int> &values = state.get_values();
+    key.clear();
+    for (int dep_var : depends_on[var]) {
+        key.push_back(values[dep_var]);
+    }
+    key.push_back(from_val);
+}
+
+uint32_t CGCache::compute_hash() const {
+    utils::HashState hash_state;
+    for (int value : key) {
+        utils::feed(hash_state, value);
+    }
+    return hash_state.get_hash32();
+}
+
+size_t CGCache::get_entry_bytes(const VariableCache &var_cache) const {
     /*
-      Compute the size of the cache required for variable with ID "var_id",
-      which depends on the variables in "depends_on". Requires that the caches
-      for all variables in "depends_on" have already been allocated. Returns -1
-      if the variable cannot be cached because the required cache size would be
-      too large.
+      We count two index positions per entry since the index is at most
+      half full.
     */
+    return var_cache.get_entry_size() * sizeof(int) +
+           var_cache.num_values *
+           sizeof(domain_transition_graph::ValueTransitionLabel *) +
+           sizeof(uint32_t) + 2 * sizeof(int);
+}
 
-    const int MAX_CACHE_SIZE = 1000000;
-
-    VariablesProxy variables = task_proxy.get_variables();
-    int var_domain = variables[var_id].get_domain_size();
-    if (!utils::is_product_within_limit(var_domain, var_domain - 1,
-                                        MAX_CACHE_SIZE))
-        return -1;
+bool CGCache::keys_match(const VariableCache &var_cache, int entry) const {
+    const int *entry_key = &var_cache.entry_data[entry * var_cache.get_entry_size()];
+    return equal(key.begin(), key.end(), entry_key);
+}
 
-    int required_size = var_domain * (var_domain - 1);
+void CGCache::resize(VariableCache &var_cache, int new_capacity) {
+    assert(new_capacity > var_cache.capacity);
+    num_bytes += (new_capacity - var_cache.capacity) * get_entry_bytes(var_cache);
+    var_cache.capacity = new_capacity;
+    var_cache.entry_data.resize(new_capacity * var_cache.get_entry_size());
+    var_cache.helpful_transitions.resize(new_capacity * var_cache.num_values);
+    var_cache.hashes.resize(new_capacity);
+    var_cache.referenced.resize(new_capacity, false);
+    var_cache.index.assign(2 * new_capacity, NOT_CACHED);
+    for (int entry = 0; entry < var_cache.num_entries; ++entry) {
+        insert_into_index(var_cache, entry);
+    }
+}
 
-    for (int depend_var_id : depends_on) {
-        int depend_var_domain = variables[depend_var_id].get_domain_size();
+void CGCache::insert_into_index(VariableCache &var_cache, int entry) {
+    int mask = var_cache.index.size() - 1;
+    int pos = var_cache.hashes[entry] & mask;
+    while (var_cache.index[pos] != NOT_CACHED) {
+        pos = (pos + 1) & mask;
+    }
+    var_cache.index[pos] = entry;
+}
 
-        /*
-          If var depends on a variable var_i that is not cached, then
-          it cannot be cached. This is possible even if var would have
-          an acceptable cache size because the domain of var_i
-          contributes quadratically to its own cache size but only
-          linearly to the cache size of var.
-        */
-        if (cache[depend_var_id].empty())
-            return -1;
+void CGCache::remove_from_index(VariableCache &var_cache, int entry) {
+    vector<int> &index = var_cache.index;
+    int mask = index.size() - 1;
+    int pos = var_cache.hashes[entry] & mask;
+    while (index[pos] != entry) {
+        assert(index[pos] != NOT_CACHED);
+        pos = (pos + 1) & mask;
+    }
+    /*
+      Move later entries of the probe sequence into the gap unless their
+      home position lies cyclically between the gap and their position.
+    */
+    int next = (pos + 1) & mask;
+    while (index[next] != NOT_CACHED) {
+        int home = var_cache.hashes[index[next]] & mask;
+        bool can_move = (pos <= next) ?
+            (home <= pos || home > next) : (home <= pos && home > next);
+        if (can_move) {
+            index[pos] = index[next];
+            pos = next;
+        }
+        next = (next + 1) & mask;
+    }
+    index[pos] = NOT_CACHED;
+}
 
-        if (!utils::is_product_within_limit(required_size, depend_var_domain,
-                                            MAX_CACHE_SIZE))
-            return -1;
+int CGCache::evict_entry(VariableCache &var_cache) {
+    while (var_cache.referenced[var_cache.clock_hand]) {
+        var_cache.referenced[var_cache.clock_hand] = false;
+        var_cache.clock_hand = (var_cache.clock_hand + 1) % var_cache.capacity;
+    }
+    int entry = var_cache.clock_hand;
+    var_cache.clock_hand = (var_cache.clock_hand + 1) % var_cache.capacity;
+    remove_from_index(var_cache, entry);
+    ++num_evictions;
+    return entry;
+}
 
-        required_size *= depend_var_domain;
+int CGCache::lookup(int var, const State &state, int from_val, uint32_t &hash) {
+    compute_key(var, state, from_val);
+    hash = compute_hash();
+    VariableCache &var_cache = variable_caches[var];
+    if (var_cache.num_entries == 0)
+        return NOT_CACHED;
+    int mask = var_cache.index.size() - 1;
+    for (int pos = hash & mask; var_cache.index[pos] != NOT_CACHED;
+         pos = (pos + 1) & mask) {
+        int entry = var_cache.index[pos];
+        if (var_cache.hashes[entry] == hash && keys_match(var_cache, entry)) {
+            var_cache.referenced[entry] = true;
+            return entry;
+        }
     }
+    return NOT_CACHED;
+}
 
-    return required_size;
+int CGCache::add_entry(int var, const State &state, int from_val, uint32_t hash) {
+    VariableCache &var_cache = variable_caches[var];
+    /*
+      The key has to be computed again because computing the distances
+      may have looked up keys of other variables in the meantime.
+    */
+    compute_key(var, state, from_val);
+    assert(compute_hash() == hash);
+    int entry;
+    if (var_cache.num_entries < var_cache.capacity) {
+        entry = var_cache.num_entries++;
+    } else {
+        int new_capacity = max(2 * var_cache.capacity, INITIAL_CAPACITY);
+        size_t additional_bytes =
+            (new_capacity - var_cache.capacity) * get_entry_bytes(var_cache);
+        if (num_bytes + additional_bytes <= max_bytes) {
+            resize(var_cache, new_capacity);
+            entry = var_cache.num_entries++;
+        } else if (var_cache.capacity == 0) {
+            // Every variable can cache at least one entry.
+            resize(var_cache, 1);
+            entry = var_cache.num_entries++;
+        } else {
+            entry = evict_entry(var_cache);
+        }
+    }
+    var_cache.hashes[entry] = hash;
+    var_cache.referenced[entry] = true;
+    copy(key.begin(), key.end(),
+         &var_cache.entry_data[entry * var_cache.get_entry_size()]);
+    insert_into_index(var_cache, entry);
+    return entry;
 }
 
-int CGCache::get_index(int var, const State &state,
-                       int from_val, int to_val) const {
-    assert(is_cached(var));
-    assert(from_val != to_val);
-    int index = from_val;
-    int multiplier = task_proxy.get_variables()[var].get_domain_size();
-    for (int dep_var : depends_on[var]) {
-        index += state[dep_var].get_value() * multiplier;
-        multiplier *= task_proxy.get_variables()[dep_var].get_domain_size();
+void CGCache::print_statistics() const {
+    int64_t num_entries = 0;
+    for (const VariableCache &var_cache : variable_caches) {
+        num_entries += var_cache.num_entries;
     }
-    if (to_val > from_val)
-        --to_val;
-    index += to_val * multiplier;
-    assert(utils::in_bounds(index, cache[var]));
-    return index;
+    cout << "CG cache entries: " << num_entries << endl;
+    cout << "CG cache memory: " << num_bytes / 1024 << " KB" << endl;
+    cout << "CG cache evictions: " << num_evictions << endl;
 }
 }
@@ -3,6 +3,7 @@
 
 #include "../task_proxy.h"
 
+#include <cstdint>
 #include <vector>
 
 namespace domain_transition_graph {
@@ -10,46 +11,106 @@ struct ValueTransitionLabel;
 }
 
 namespace cg_heuristic {
+/*
+  Cache for the distances computed by the causal graph heuristic.
+
+  The distances from a value of a variable to all other values only depend
+  on the values of the ancestors of the variable in the reduced causal
+  graph. For each variable, we store the distances (and helpful
+  transitions) for the combinations of ancestor values and start values
+  that occurred so far in a hash table. The tables grow until they reach a
+  common memory limit. Afterwards, new entries replace old entries of the
+  same variable, which are chosen with the CLOCK algorithm: every entry has
+  a "referenced" bit that is set when the entry is used, and the clock hand
+  evicts the next entry without this bit, clearing the bits it passes.
+*/
 class CGCache {
+    struct VariableCache {
+        // Number of ancestor variables plus one for the start value.
+        int key_size;
+        int num_values;
+        int capacity;
+        int num_entries;
+        int clock_hand;
+        // For each entry: the key followed by the distances to all values.
+        std::vector<int> entry_data;
+        std::vector<domain_transition_graph::ValueTransitionLabel *> helpful_transitions;
+        std::vector<std::uint32_t> hashes;
+        std::vector<bool> referenced;
+        // Hash table with linear probing that maps keys to entries.
+        std::vector<int> index;
+
+        int get_entry_size() const {
+            return key_size + num_values;
+        }
+    };
+
     TaskProxy task_proxy;
-    std::vector<std::vector<int>> cache;
-    std::vector<std::vector<domain_transition_graph::ValueTransitionLabel *>> helpful_transition_cache;
     std::vector<std::vector<int>> depends_on;
+    std::vector<VariableCache> variable_caches;
+    const size_t max_bytes;
+    size_t num_bytes;
+    int64_t num_evictions;
+    std::vector<int> key;
 
-    int get_index(int var, const State &state, int from_val, int to_val) const;
-    int compute_required_cache_size(int var_id,
-                                    const std::vector<int> &depends_on) const;
+    void compute_key(int var, const State &state, int from_val);
+    std::uint32_t compute_hash() const;
+    size_t get_entry_bytes(const VariableCache &var_cache) const;
+    bool keys_match(const VariableCache &var_cache, int entry) const;
+    void resize(VariableCache &var_cache, int new_capacity);
+    void insert_into_index(VariableCache &var_cache, int entry);
+    void remove_from_index(VariableCache &var_cache, int entry);
+    int evict_entry(VariableCache &var_cache);
 public:
-    static const int NOT_COMPUTED = -2;
+    static const int NOT_CACHED = -1;
 
-    explicit CGCache(TaskProxy &task_proxy);
+    CGCache(const TaskProxy &task_proxy, size_t max_bytes);
     ~CGCache();
 
-    bool is_cached(int var) const {
-        return !cache[var].empty();
-    }
+    /*
+      Return the ID of the entry with the distances from from_val for the
+      ancestor values in the given state, or NOT_CACHED. The hash of the
+      key is stored in hash so that it can be passed to add_entry on a
+      miss.
+    */
+    int lookup(int var, const State &state, int from_val, std::uint32_t &hash);
+
+    /*
+      Add an entry for the given key, whose hash has been computed by
+      lookup, and return its ID. The caller has to set all distances and
+      helpful transitions of the entry. This may evict other entries of
+      the same variable.
+    */
+    int add_entry(int var, const State &state, int from_val, std::uint32_t hash);
 
-    int lookup(int var, const State &state, int from_val, int to_val) const {
-        return cache[var][get_index(var, state, from_val, to_val)];
+    int get_distance(int var, int entry, int to_val) const {
+        const VariableCache &var_cache = variable_caches[var];
+        return var_cache.entry_data[
+            entry * var_cache.get_entry_size() + var_cache.key_size + to_val];
     }
 
-    void store(int var, const State &state,
-               int from_val, int to_val, int cost) {
-        cache[var][get_index(var, state, from_val, to_val)] = cost;
+    void set_distance(int var, int entry, int to_val, int distance) {
+        VariableCache &var_cache = variable_caches[var];
+        var_cache.entry_data[
+            entry * var_cache.get_entry_size() + var_cache.key_size + to_val] =
+            distance;
     }
 
-    domain_transition_graph::ValueTransitionLabel *lookup_helpful_transition(
-        int var, const State &state, int from_val, int to_val) const {
-        int index = get_index(var, state, from_val, to_val);
-        return helpful_transition_cache[var][index];
+    domain_transition_graph::ValueTransitionLabel *get_helpful_transition(
+        int var, int entry, int to_val) const {
+        const VariableCache &var_cache = variable_caches[var];
+        return var_cache.helpful_transitions[entry * var_cache.num_values + to_val];
     }
 
-    void store_helpful_transition(
-        int var, const State &state, int from_val, int to_val,
+    void set_helpful_transition(
+        int var, int entry, int to_val,
         domain_transition_graph::ValueTransitionLabel *helpful_transition) {
-        int index = get_index(var, state, from_val, to_val);
-        helpful_transition_cache[var][index] = helpful_transition;
+        VariableCache &var_cache = variable_caches[var];
+        var_cache.helpful_transitions[entry * var_cache.num_values + to_val] =
+            helpful_transition;
     }
+
+    void print_statistics() const;
 };
 }
 
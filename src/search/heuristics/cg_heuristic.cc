@@ -16,13 +16,13 @@
 using namespace std;
 using namespace domain_transition_graph;
 
-// TODO: Turn this into an option and check its impact.
-#define USE_CACHE true
-
 namespace cg_heuristic {
 CGHeuristic::CGHeuristic(const Options &opts)
     : Heuristic(opts),
-      cache(utils::make_unique_ptr<CGCache>(task_proxy)),
+      cache(opts.get<int>("max_cache_size") > 0 ?
+            utils::make_unique_ptr<CGCache>(
+                task_proxy, static_cast<size_t>(opts.get<int>("max_cache_size")) << 20) :
+            nullptr),
       cache_hits(0),
       cache_misses(0),
       helpful_transition_extraction_counter(0),
@@ -47,8 +47,20 @@ bool CGHeuristic::dead_ends_are_reliable() const {
     return false;
 }
 
+void CGHeuristic::print_statistics() const {
+    if (cache) {
+        int64_t num_lookups = cache_hits + cache_misses;
+        cout << "CG cache hits: " << cache_hits << endl;
+        cout << "CG cache misses: " << cache_misses << endl;
+        cout << "CG cache hit rate: "
+             << (num_lookups ? 100.0 * cache_hits / num_lookups : 0.0)
+             << "%" << endl;
+        cache->print_statistics();
+    }
+}
+
 int CGHeuristic::compute_heuristic(const GlobalState &global_state) {
-    const State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     setup_domain_transition_graphs();
 
     int heuristic = 0;
@@ -88,20 +100,19 @@ int CGHeuristic::get_transition_cost(const State &state,
 
     int var_no = dtg->var;
 
-    // Check cache.
-    bool use_the_cache = USE_CACHE && cache->is_cached(var_no);
-    if (use_the_cache) {
-        int cached_val = cache->lookup(var_no, state, start_val, goal_val);
-        if (cached_val != CGCache::NOT_COMPUTED) {
-            ++cache_hits;
-            return cached_val;
-        }
-    } else {
-        ++cache_misses;
-    }
-
     ValueNode *start = &dtg->nodes[start_val];
     if (start->distances.empty()) {
+        // Check cache.
+        uint32_t hash = 0;
+        if (cache) {
+            int entry = cache->lookup(var_no, state, start_val, hash);
+            if (entry != CGCache::NOT_CACHED) {
+                ++cache_hits;
+                return cache->get_distance(var_no, entry, goal_val);
+            }
+            ++cache_misses;
+        }
+
         // Initialize data of initial node.
         start->distances.resize(dtg->nodes.size(), numeric_limits<int>::max());
         start->helpful_transitions.resize(dtg->nodes.size(), 0);
@@ -200,20 +211,19 @@ int CGHeuristic::get_transition_cost(const State &state,
                 }
             }
         }
-    }
 
-    if (use_the_cache) {
-        int num_values = start->distances.size();
-        for (int val = 0; val < num_values; ++val) {
-            if (val == start_val)
-                continue;
-            int distance = start->distances[val];
-            ValueTransitionLabel *helpful = start->helpful_transitions[val];
-            // We should have a helpful transition iff distance is infinite.
-            assert((distance == numeric_limits<int>::max()) == !helpful);
-            cache->store(var_no, state, start_val, val, distance);
-            cache->store_helpful_transition(
-                var_no, state, start_val, val, helpful);
+        if (cache) {
+            int entry = cache->add_entry(var_no, state, start_val, hash);
+            int num_values = start->distances.size();
+            for (int val = 0; val < num_values; ++val) {
+                int distance = start->distances[val];
+                ValueTransitionLabel *helpful = start->helpful_transitions[val];
+                // We should have a helpful transition iff distance is infinite.
+                assert(val == start_val ||
+                       (distance == numeric_limits<int>::max()) == !helpful);
+                cache->set_distance(var_no, entry, val, distance);
+                cache->set_helpful_transition(var_no, entry, val, helpful);
+            }
         }
     }
 
@@ -253,17 +263,29 @@ void CGHeuristic::mark_helpful_transitions(const State &state,
 
     ValueTransitionLabel *helpful;
     int cost;
+    ValueNode *start_node = &dtg->nodes[from];
     // Check cache.
-    if (USE_CACHE && cache->is_cached(var_no)) {
-        helpful = cache->lookup_helpful_transition(var_no, state, from, to);
-        cost = cache->lookup(var_no, state, from, to);
-        assert(helpful);
+    int entry = CGCache::NOT_CACHED;
+    if (cache && start_node->helpful_transitions.empty()) {
+        uint32_t hash;
+        entry = cache->lookup(var_no, state, from, hash);
+    }
+    if (entry != CGCache::NOT_CACHED) {
+        helpful = cache->get_helpful_transition(var_no, entry, to);
+        cost = cache->get_distance(var_no, entry, to);
     } else {
-        ValueNode *start_node = &dtg->nodes[from];
+        if (start_node->helpful_transitions.empty()) {
+            /*
+              The distances were looked up in the cache, but the entry has
+              been evicted since.
+            */
+            get_transition_cost(state, dtg, from, to);
+        }
         assert(!start_node->helpful_transitions.empty());
         helpful = start_node->helpful_transitions[to];
         cost = start_node->distances[to];
     }
+    assert(helpful);
 
     OperatorProxy op = helpful->is_axiom ?
         task_proxy.get_axioms()[helpful->op_id] :
@@ -298,6 +320,15 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "no");
     parser.document_property("preferred operators", "yes");
 
+    parser.add_option<int>(
+        "max_cache_size",
+        "maximum memory in MiB for caching the distances of variables for "
+        "combinations of the values of their ancestors in the causal graph. "
+        "If the limit is reached, the least recently used entries are "
+        "replaced (approximately, using the CLOCK algorithm). "
+        "Use 0 to disable the cache.",
+        "256",
+        Bounds("0", "infinity"));
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -49,7 +49,7 @@ void FFHeuristic::mark_preferred_operators_and_relaxed_plan(
 }
 
 int FFHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     int h_add = compute_add_and_ff(state);
     if (h_add == DEAD_END)
         return h_add;
@@ -0,0 +1,240 @@
+#include "h2_engine.h"
+
+#include "../utils/parallel.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace hm_heuristic {
+// Number of operators that a thread applies at once in parallel rounds.
+static const int OPERATORS_PER_CHUNK = 16;
+/*
+  Rounds with fewer operators per thread are run serially, because
+  starting the threads would take longer than applying the operators.
+*/
+static const int MIN_OPERATORS_PER_THREAD = 1024;
+
+H2Engine::H2Engine(const TaskProxy &task_proxy, int num_threads)
+    : num_threads(num_threads),
+      num_facts(0) {
+    VariablesProxy variables = task_proxy.get_variables();
+    for (VariableProxy var : variables) {
+        variable_offsets.push_back(num_facts);
+        domain_sizes.push_back(var.get_domain_size());
+        num_facts += var.get_domain_size();
+        fact_variables.resize(num_facts, var.get_id());
+    }
+    costs.resize(static_cast<size_t>(num_facts) * (num_facts + 1) / 2);
+    precondition_of.resize(num_facts);
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    int num_operators = operators.size();
+    operator_preconditions.resize(num_operators);
+    operator_effects.resize(num_operators);
+    for (OperatorProxy op : operators) {
+        int op_id = op.get_id();
+        vector<int> &preconditions = operator_preconditions[op_id];
+        for (FactProxy pre : op.get_preconditions()) {
+            preconditions.push_back(get_fact(pre));
+        }
+        sort(preconditions.begin(), preconditions.end());
+        for (int pre : preconditions) {
+            precondition_of[pre].push_back(op_id);
+        }
+        if (preconditions.empty()) {
+            operators_without_preconditions.push_back(op_id);
+        }
+
+        vector<int> &effects = operator_effects[op_id];
+        for (EffectProxy eff : op.get_effects()) {
+            effects.push_back(get_fact(eff.get_fact()));
+        }
+        sort(effects.begin(), effects.end());
+        effects.erase(unique(effects.begin(), effects.end()), effects.end());
+
+        operator_costs.push_back(op.get_cost());
+    }
+
+    is_queued.resize(num_operators, false);
+    scratch_by_thread.resize(max(num_threads, 1));
+    for (Scratch &scratch : scratch_by_thread) {
+        scratch.noop_costs.resize(num_facts);
+    }
+}
+
+void H2Engine::enqueue_operator(int op_id) {
+    if (!is_queued[op_id]) {
+        is_queued[op_id] = true;
+        next_operators.push_back(op_id);
+    }
+}
+
+void H2Engine::decrease_cost(int fact1, int fact2, size_t index, int cost) {
+    assert(cost < costs[index]);
+    costs[index] = cost;
+    for (int op_id : precondition_of[fact1]) {
+        enqueue_operator(op_id);
+    }
+    if (fact1 == fact2) {
+        for (int op_id : operators_without_preconditions) {
+            enqueue_operator(op_id);
+        }
+    } else {
+        for (int op_id : precondition_of[fact2]) {
+            enqueue_operator(op_id);
+        }
+    }
+}
+
+void H2Engine::apply_operator(int op_id, Scratch &scratch, bool buffer_updates) {
+    auto update = [&](int fact1, int fact2, size_t index, int cost) {
+        if (cost < costs[index]) {
+            if (buffer_updates) {
+                scratch.updates.push_back({fact1, fact2, cost});
+            } else {
+                decrease_cost(fact1, fact2, index, cost);
+            }
+        }
+    };
+
+    const vector<int> &preconditions = operator_preconditions[op_id];
+    int precondition_cost = evaluate(preconditions);
+    if (precondition_cost == INF)
+        return;
+    int op_cost = operator_costs[op_id];
+
+    // Pairs of two effects.
+    const vector<int> &effects = operator_effects[op_id];
+    int num_effects = effects.size();
+    for (int i = 0; i < num_effects; ++i) {
+        for (int j = i; j < num_effects; ++j) {
+            update(effects[i], effects[j], get_pair_index(effects[i], effects[j]),
+                   precondition_cost + op_cost);
+        }
+    }
+
+    /*
+      Pairs of an effect and a fact that holds before and after applying the
+      operator. We first compute for each fact the cost of reaching it
+      together with the precondition. The costs of pairs are at least the
+      costs of the contained facts, so we only need to consider the cost of
+      the fact itself if there are no preconditions.
+    */
+    vector<int> &noop_costs = scratch.noop_costs;
+    if (preconditions.empty()) {
+        for (int fact = 0; fact < num_facts; ++fact) {
+            noop_costs[fact] = costs[get_pair_index(fact, fact)];
+        }
+    } else {
+        fill(noop_costs.begin(), noop_costs.end(), precondition_cost);
+        for (int pre : preconditions) {
+            for_each_pair_with(pre, [&](int fact, size_t index) {
+                    noop_costs[fact] = max(noop_costs[fact], costs[index]);
+                });
+        }
+    }
+    // Exclude facts that the operator changes or that contradict the precondition.
+    for (int pre : preconditions) {
+        int var = fact_variables[pre];
+        for (int value = 0; value < domain_sizes[var]; ++value) {
+            int fact = get_fact(var, value);
+            if (fact != pre)
+                noop_costs[fact] = INF;
+        }
+    }
+    for (int eff : effects) {
+        int var = fact_variables[eff];
+        for (int value = 0; value < domain_sizes[var]; ++value) {
+            noop_costs[get_fact(var, value)] = INF;
+        }
+    }
+    for (int eff : effects) {
+        for_each_pair_with(eff, [&](int fact, size_t index) {
+                int cost = noop_costs[fact];
+                if (cost != INF)
+                    update(eff, fact, index, cost + op_cost);
+            });
+    }
+}
+
+void H2Engine::run_round() {
+    int num_operators = current_operators.size();
+    int num_chunks = (num_operators + OPERATORS_PER_CHUNK - 1) / OPERATORS_PER_CHUNK;
+    int num_used_threads = min(num_threads, num_operators / MIN_OPERATORS_PER_THREAD);
+    if (num_used_threads <= 1) {
+        /*
+          Apply the operators in place, so later operators of the round
+          already see the updates of earlier ones.
+        */
+        for (int op_id : current_operators) {
+            is_queued[op_id] = false;
+            apply_operator(op_id, scratch_by_thread[0], false);
+        }
+    } else {
+        for (int op_id : current_operators) {
+            is_queued[op_id] = false;
+        }
+        utils::parallel_for(
+            num_used_threads, num_chunks,
+            [&](int thread_id, int chunk) {
+                int end = min((chunk + 1) * OPERATORS_PER_CHUNK, num_operators);
+                for (int i = chunk * OPERATORS_PER_CHUNK; i < end; ++i) {
+                    apply_operator(current_operators[i],
+                                   scratch_by_thread[thread_id], true);
+                }
+            });
+        for (Scratch &scratch : scratch_by_thread) {
+            for (const Update &update : scratch.updates) {
+                size_t index = get_pair_index(update.fact1, update.fact2);
+                if (update.cost < costs[index]) {
+                    decrease_cost(update.fact1, update.fact2, index, update.cost);
+                }
+            }
+            scratch.updates.clear();
+        }
+    }
+}
+
+int H2Engine::evaluate(const vector<int> &facts) const {
+    int cost = 0;
+    int num_facts_to_evaluate = facts.size();
+    for (int i = 0; i < num_facts_to_evaluate; ++i) {
+        for (int j = i; j < num_facts_to_evaluate; ++j) {
+            cost = max(cost, costs[get_pair_index(facts[i], facts[j])]);
+            if (cost == INF)
+                return INF;
+        }
+    }
+    return cost;
+}
+
+int H2Engine::compute_value(const State &state, const vector<FactPair> &facts) {
+    fill(costs.begin(), costs.end(), INF);
+    int num_variables = variable_offsets.size();
+    for (int var1 = 0; var1 < num_variables; ++var1) {
+        int fact1 = get_fact(var1, state[var1].get_value());
+        for (int var2 = var1; var2 < num_variables; ++var2) {
+            costs[get_pair_index(fact1, get_fact(var2, state[var2].get_value()))] = 0;
+        }
+    }
+
+    assert(next_operators.empty());
+    int num_operators = operator_costs.size();
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        enqueue_operator(op_id);
+    }
+    while (!next_operators.empty()) {
+        swap(current_operators, next_operators);
+        next_operators.clear();
+        run_round();
+    }
+
+    vector<int> fact_ids;
+    fact_ids.reserve(facts.size());
+    for (const FactPair &fact : facts) {
+        fact_ids.push_back(get_fact(fact.var, fact.value));
+    }
+    return evaluate(fact_ids);
+}
+}
@@ -0,0 +1,111 @@
+#ifndef HEURISTICS_H2_ENGINE_H
+#define HEURISTICS_H2_ENGINE_H
+
+#include "../task_proxy.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace hm_heuristic {
+/*
+  Computes the h^2 values of all fact pairs for a given state.
+
+  Facts are numbered consecutively (all values of variable 0, then all
+  values of variable 1, ...), and the cost of the pair {f, g} with f <= g
+  is stored at index g * (g + 1) / 2 + f of a triangular array. The
+  diagonal holds the costs of single facts. Pairs of different values of
+  the same variable are never reached and keep infinite cost.
+
+  The costs are computed with a fixpoint iteration over the operators that
+  only reapplies operators which depend on a pair whose cost decreased in
+  the previous round. With more than one thread, the operators of large
+  rounds are applied in parallel against the costs of the previous round
+  and the resulting updates are merged afterwards. Small rounds are run
+  serially. All thread counts compute the same costs.
+
+  Like the generic implementation, we ignore the conditions of
+  conditional effects and we ignore axioms.
+*/
+class H2Engine {
+    struct Update {
+        int fact1;
+        int fact2;
+        int cost;
+    };
+
+    // Data used by a single thread while applying operators.
+    struct Scratch {
+        std::vector<int> noop_costs;
+        std::vector<Update> updates;
+    };
+
+    const int num_threads;
+    std::vector<int> variable_offsets;
+    std::vector<int> domain_sizes;
+    std::vector<int> fact_variables;
+    int num_facts;
+
+    std::vector<std::vector<int>> operator_preconditions;
+    std::vector<std::vector<int>> operator_effects;
+    std::vector<int> operator_costs;
+    std::vector<std::vector<int>> precondition_of;
+    std::vector<int> operators_without_preconditions;
+
+    std::vector<int> costs;
+    std::vector<int> current_operators;
+    std::vector<int> next_operators;
+    std::vector<bool> is_queued;
+    std::vector<Scratch> scratch_by_thread;
+
+    int get_fact(int var, int value) const {
+        return variable_offsets[var] + value;
+    }
+
+    int get_fact(const FactProxy &fact) const {
+        return get_fact(fact.get_variable().get_id(), fact.get_value());
+    }
+
+    size_t get_pair_index(int fact1, int fact2) const {
+        if (fact1 > fact2)
+            std::swap(fact1, fact2);
+        return static_cast<size_t>(fact2) * (fact2 + 1) / 2 + fact1;
+    }
+
+    /*
+      Call func(other, index) for all facts with the index of their pair
+      with the given fact. The pairs with smaller facts are stored
+      consecutively, the others are visited with growing strides.
+    */
+    template<typename Func>
+    void for_each_pair_with(int fact, const Func &func) const {
+        size_t index = get_pair_index(0, fact);
+        for (int other = 0; other <= fact; ++other) {
+            func(other, index++);
+        }
+        --index;
+        for (int other = fact + 1; other < num_facts; ++other) {
+            index += other;
+            func(other, index);
+        }
+    }
+
+    void enqueue_operator(int op_id);
+    void decrease_cost(int fact1, int fact2, size_t index, int cost);
+    void apply_operator(int op_id, Scratch &scratch, bool buffer_updates);
+    void run_round();
+    int evaluate(const std::vector<int> &facts) const;
+public:
+    static const int INF = std::numeric_limits<int>::max();
+
+    H2Engine(const TaskProxy &task_proxy, int num_threads);
+
+    /*
+      Return the h^2 value of the given facts in the given state or INF if
+      they are unreachable.
+    */
+    int compute_value(const State &state, const std::vector<FactPair> &facts);
+};
+}
+
+#endif
@@ -1,10 +1,14 @@
 #include "hm_heuristic.h"
 
+#include "h2_engine.h"
+
 #include "../option_parser.h"
 #include "../plugin.h"
 
 #include "../task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
+#include "../utils/parallel_options.h"
 
 #include <cassert>
 #include <limits>
@@ -19,10 +23,18 @@ HMHeuristic::HMHeuristic(const Options &opts)
       has_cond_effects(task_properties::has_conditional_effects(task_proxy)),
       goals(task_properties::get_fact_pairs(task_proxy.get_goals())) {
     cout << "Using h^" << m << "." << endl;
-    cout << "The implementation of the h^m heuristic is preliminary." << endl
-         << "It is SLOOOOOOOOOOOW." << endl
-         << "Please do not use this for comparison!" << endl;
-    generate_all_tuples();
+    if (m == 2) {
+        h2_engine = utils::make_unique_ptr<H2Engine>(
+            task_proxy, utils::parse_num_threads_from_options(opts));
+    } else {
+        cout << "The implementation of the h^m heuristic is preliminary." << endl
+             << "It is SLOOOOOOOOOOOW." << endl
+             << "Please do not use this for comparison!" << endl;
+        generate_all_tuples();
+    }
+}
+
+HMHeuristic::~HMHeuristic() {
 }
 
 
@@ -32,9 +44,14 @@ bool HMHeuristic::dead_ends_are_reliable() const {
 
 
 int HMHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     if (task_properties::is_goal_state(task_proxy, state)) {
         return 0;
+    } else if (h2_engine) {
+        int h = h2_engine->compute_value(state, goals);
+        if (h == H2Engine::INF)
+            return DEAD_END;
+        return h;
     } else {
         Tuple s_tup = task_properties::get_fact_pairs(state);
 
@@ -277,7 +294,17 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
                              "effects or axioms");
     parser.document_property("preferred operators", "no");
 
+    parser.document_note(
+        "Implementation",
+        "For m=2, the heuristic uses a specialized implementation that stores "
+        "the costs of all fact pairs in an array and only reapplies operators "
+        "if a pair with one of their preconditions became cheaper. The option "
+        "num_threads "
+        "parallelizes the application of the operators in each state. All "
+        "other values of m use a generic implementation that is very slow.");
+
     parser.add_option<int>("m", "subset size", "2", Bounds("1", "infinity"));
+    utils::add_parallel_options(parser);
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -14,11 +15,14 @@ class Options;
 }
 
 namespace hm_heuristic {
+class H2Engine;
+
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
+  For m = 2, we use the specialized H2Engine. The generic implementation
+  for other values of m is very slow and should not be used for speed
+  benchmarks.
 */
 
 class HMHeuristic : public Heuristic {
@@ -29,6 +33,8 @@ class HMHeuristic : public Heuristic {
 
     const Tuple goals;
 
+    std::unique_ptr<H2Engine> h2_engine;
+
     // h^m table
     std::map<Tuple, int> hm_table;
     bool was_updated;
@@ -62,6 +68,7 @@ protected:
 
 public:
     explicit HMHeuristic(const options::Options &opts);
+    virtual ~HMHeuristic() override;
 
     virtual bool dead_ends_are_reliable() const;
 };
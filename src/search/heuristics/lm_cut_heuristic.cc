@@ -16,7 +16,8 @@ using namespace std;
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
     : Heuristic(opts),
-      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(
+                             task_proxy, opts.get<bool>("incremental"))) {
     cout << "Initializing landmark cut heuristic..." << endl;
 }
 
@@ -24,7 +25,7 @@ LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
 int LandmarkCutHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -49,6 +50,21 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("consistent", "no");
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
+    parser.document_note(
+        "Incremental computation",
+        "With incremental=true, the h^max values of the previously "
+        "evaluated state are repaired for the facts that differ in the "
+        "evaluated state instead of being computed from scratch. Since "
+        "successors of a state are usually evaluated one after another, "
+        "this saves time if the h^max values of most facts do not depend "
+        "on the facts changed by an operator. The heuristic values can differ from "
+        "the non-incremental computation because h^max supporters are "
+        "chosen differently among operators with equal costs.");
+
+    parser.add_option<bool>(
+        "incremental",
+        "reuse the h^max values of the previously evaluated state",
+        "false");
 
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
@@ -9,24 +9,45 @@
 using namespace std;
 
 namespace lm_cut_heuristic {
+/*
+  Fraction of the propositions that may be invalidated when repairing the
+  h^max values of the reference state before we recompute them from scratch.
+*/
+static const double MAX_INVALIDATED_FRACTION = 0.25;
+
 // construction and destruction
-LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
+LandmarkCutLandmarks::LandmarkCutLandmarks(
+    const TaskProxy &task_proxy, bool incremental)
+    : incremental(incremental),
+      has_reference_state(false) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
 
     // Build propositions.
-    num_propositions = 2; // artificial goal and artificial precondition
+    num_propositions = 0;
     VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-        int var_id = fact.get_variable().get_id();
-        propositions[var_id].push_back(RelaxedProposition());
-        ++num_propositions;
+    variable_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        variable_offsets.push_back(num_propositions);
+        num_propositions += var.get_domain_size();
     }
+    artificial_precondition = num_propositions++;
+    artificial_goal = num_propositions++;
+    propositions.resize(num_propositions);
 
     // Build relaxed operators for operators and axioms.
-    for (OperatorProxy op : task_proxy.get_operators())
-        build_relaxed_operator(op);
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        vector<int> precondition;
+        vector<int> effects;
+        for (FactProxy pre : op.get_preconditions()) {
+            precondition.push_back(get_proposition(pre));
+        }
+        for (EffectProxy eff : op.get_effects()) {
+            effects.push_back(get_proposition(eff.get_fact()));
+        }
+        add_relaxed_operator(
+            move(precondition), move(effects), op.get_id(), op.get_cost());
+    }
 
     // Simplify relaxed operators.
     // simplify();
@@ -35,74 +56,84 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
        unary operators hurts. */
 
     // Build artificial goal proposition and operator.
-    vector<RelaxedProposition *> goal_op_pre, goal_op_eff;
+    vector<int> goal_op_pre, goal_op_eff;
     for (FactProxy goal : task_proxy.get_goals()) {
         goal_op_pre.push_back(get_proposition(goal));
     }
-    goal_op_eff.push_back(&artificial_goal);
+    goal_op_eff.push_back(artificial_goal);
     /* Use the invalid operator ID -1 so accessing
        the artificial operator will generate an error. */
     add_relaxed_operator(move(goal_op_pre), move(goal_op_eff), -1, 0);
 
-    // Cross-reference relaxed operators.
-    for (RelaxedOperator &op : relaxed_operators) {
-        for (RelaxedProposition *pre : op.preconditions)
-            pre->precondition_of.push_back(&op);
-        for (RelaxedProposition *eff : op.effects)
-            eff->effect_of.push_back(&op);
+    cross_reference_relaxed_operators();
+
+    if (incremental) {
+        is_affected_operator.resize(relaxed_operators.size(), false);
+        is_newly_reached.resize(num_propositions, false);
     }
 }
 
 LandmarkCutLandmarks::~LandmarkCutLandmarks() {
 }
 
-void LandmarkCutLandmarks::build_relaxed_operator(const OperatorProxy &op) {
-    vector<RelaxedProposition *> precondition;
-    vector<RelaxedProposition *> effects;
-    for (FactProxy pre : op.get_preconditions()) {
-        precondition.push_back(get_proposition(pre));
-    }
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(get_proposition(eff.get_fact()));
-    }
-    add_relaxed_operator(
-        move(precondition), move(effects), op.get_id(), op.get_cost());
-}
-
 void LandmarkCutLandmarks::add_relaxed_operator(
-    vector<RelaxedProposition *> &&precondition,
-    vector<RelaxedProposition *> &&effects,
+    vector<int> &&precondition, vector<int> &&effects,
     int op_id, int base_cost) {
-    RelaxedOperator relaxed_op(
-        move(precondition), move(effects), op_id, base_cost);
-    if (relaxed_op.preconditions.empty())
-        relaxed_op.preconditions.push_back(&artificial_precondition);
-    relaxed_operators.push_back(relaxed_op);
+    if (precondition.empty())
+        precondition.push_back(artificial_precondition);
+    int preconditions_begin = operator_propositions.size();
+    operator_propositions.insert(
+        operator_propositions.end(), precondition.begin(), precondition.end());
+    int effects_begin = operator_propositions.size();
+    operator_propositions.insert(
+        operator_propositions.end(), effects.begin(), effects.end());
+    int effects_end = operator_propositions.size();
+    relaxed_operators.emplace_back(
+        op_id, base_cost, preconditions_begin, effects_begin, effects_end);
+}
+
+void LandmarkCutLandmarks::cross_reference_relaxed_operators() {
+    vector<vector<int>> precondition_of(num_propositions);
+    vector<vector<int>> effect_of(num_propositions);
+    int num_operators = relaxed_operators.size();
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        for (int pre : get_preconditions(op_id))
+            precondition_of[pre].push_back(op_id);
+        for (int eff : get_effects(op_id))
+            effect_of[eff].push_back(op_id);
+    }
+    for (int prop_id = 0; prop_id < num_propositions; ++prop_id) {
+        RelaxedProposition &prop = propositions[prop_id];
+        prop.precondition_of_begin = proposition_operators.size();
+        proposition_operators.insert(
+            proposition_operators.end(),
+            precondition_of[prop_id].begin(), precondition_of[prop_id].end());
+        prop.effect_of_begin = proposition_operators.size();
+        proposition_operators.insert(
+            proposition_operators.end(),
+            effect_of[prop_id].begin(), effect_of[prop_id].end());
+        prop.effect_of_end = proposition_operators.size();
+    }
 }
 
-RelaxedProposition *LandmarkCutLandmarks::get_proposition(
-    const FactProxy &fact) {
+int LandmarkCutLandmarks::get_proposition(const FactProxy &fact) const {
     int var_id = fact.get_variable().get_id();
     int val = fact.get_value();
-    return &propositions[var_id][val];
+    return variable_offsets[var_id] + val;
 }
 
 // heuristic computation
 void LandmarkCutLandmarks::setup_exploration_queue() {
     priority_queue.clear();
 
-    for (auto &var_props : propositions) {
-        for (RelaxedProposition &prop : var_props) {
-            prop.status = UNREACHED;
-        }
+    for (RelaxedProposition &prop : propositions) {
+        prop.status = UNREACHED;
     }
 
-    artificial_goal.status = UNREACHED;
-    artificial_precondition.status = UNREACHED;
-
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.unsatisfied_preconditions = op.preconditions.size();
-        op.h_max_supporter = 0;
+    for (size_t op_id = 0; op_id < relaxed_operators.size(); ++op_id) {
+        RelaxedOperator &op = relaxed_operators[op_id];
+        op.unsatisfied_preconditions = get_preconditions(op_id).size();
+        op.h_max_supporter = NO_PROPOSITION;
         op.h_max_supporter_cost = numeric_limits<int>::max();
     }
 }
@@ -111,7 +142,7 @@ void LandmarkCutLandmarks::setup_exploration_queue_state(const State &state) {
     for (FactProxy init_fact : state) {
         enqueue_if_necessary(get_proposition(init_fact), 0);
     }
-    enqueue_if_necessary(&artificial_precondition, 0);
+    enqueue_if_necessary(artificial_precondition, 0);
 }
 
 void LandmarkCutLandmarks::first_exploration(const State &state) {
@@ -119,32 +150,27 @@ void LandmarkCutLandmarks::first_exploration(const State &state) {
     setup_exploration_queue();
     setup_exploration_queue_state(state);
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, int> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        int prop_id = top_pair.second;
+        int prop_cost = propositions[prop_id].h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            --relaxed_op->unsatisfied_preconditions;
-            assert(relaxed_op->unsatisfied_preconditions >= 0);
-            if (relaxed_op->unsatisfied_preconditions == 0) {
-                relaxed_op->h_max_supporter = prop;
-                relaxed_op->h_max_supporter_cost = prop_cost;
-                int target_cost = prop_cost + relaxed_op->cost;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    enqueue_if_necessary(effect, target_cost);
-                }
+        for (int op_id : get_precondition_of(prop_id)) {
+            RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            --relaxed_op.unsatisfied_preconditions;
+            assert(relaxed_op.unsatisfied_preconditions >= 0);
+            if (relaxed_op.unsatisfied_preconditions == 0) {
+                relaxed_op.h_max_supporter = prop_id;
+                relaxed_op.h_max_supporter_cost = prop_cost;
+                enqueue_effects(op_id, prop_cost + relaxed_op.cost);
             }
         }
     }
 }
 
-void LandmarkCutLandmarks::first_exploration_incremental(
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::first_exploration_incremental(vector<int> &cut) {
     assert(priority_queue.empty());
     /* We pretend that this queue has had as many pushes already as we
        have propositions to avoid switching from bucket-based to
@@ -152,33 +178,29 @@ void LandmarkCutLandmarks::first_exploration_incremental(
        to heap-based in problems where action costs are at most 1.
     */
     priority_queue.add_virtual_pushes(num_propositions);
-    for (RelaxedOperator *relaxed_op : cut) {
-        int cost = relaxed_op->h_max_supporter_cost + relaxed_op->cost;
-        for (RelaxedProposition *effect : relaxed_op->effects)
-            enqueue_if_necessary(effect, cost);
+    for (int op_id : cut) {
+        const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+        enqueue_effects(op_id, relaxed_op.h_max_supporter_cost + relaxed_op.cost);
     }
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, int> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        int prop_id = top_pair.second;
+        int prop_cost = propositions[prop_id].h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
-                int old_supp_cost = relaxed_op->h_max_supporter_cost;
+        for (int op_id : get_precondition_of(prop_id)) {
+            RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (relaxed_op.h_max_supporter == prop_id) {
+                int old_supp_cost = relaxed_op.h_max_supporter_cost;
                 if (old_supp_cost > prop_cost) {
-                    relaxed_op->update_h_max_supporter();
-                    int new_supp_cost = relaxed_op->h_max_supporter_cost;
+                    update_h_max_supporter(op_id);
+                    int new_supp_cost = relaxed_op.h_max_supporter_cost;
                     if (new_supp_cost != old_supp_cost) {
                         // This operator has become cheaper.
                         assert(new_supp_cost < old_supp_cost);
-                        int target_cost = new_supp_cost + relaxed_op->cost;
-                        for (RelaxedProposition *effect : relaxed_op->effects)
-                            enqueue_if_necessary(effect, target_cost);
+                        enqueue_effects(op_id, new_supp_cost + relaxed_op.cost);
                     }
                 }
             }
@@ -186,42 +208,222 @@ void LandmarkCutLandmarks::first_exploration_incremental(
     }
 }
 
+void LandmarkCutLandmarks::invalidate_proposition(int prop_id) {
+    RelaxedProposition &prop = propositions[prop_id];
+    if (prop.status != UNREACHED) {
+        prop.status = UNREACHED;
+        invalidated_propositions.push_back(prop_id);
+    }
+}
+
+bool LandmarkCutLandmarks::remove_facts_incremental(
+    const vector<int> &state_values) {
+    /*
+      Compute h^max for the facts that are true in both the reference
+      state and the new state. Removing facts can only increase h^max
+      values, so we reset all propositions whose cost may have been derived
+      from a removed fact and compute their costs again with a Dijkstra
+      exploration that starts from the remaining propositions.
+
+      If too many propositions are affected, we give up and return false,
+      since a computation from scratch is cheaper.
+    */
+    assert(invalidated_propositions.empty() && affected_operators.empty());
+    priority_queue.clear();
+    int num_variables = variable_offsets.size();
+    for (int var = 0; var < num_variables; ++var) {
+        int old_value = reference_state_values[var];
+        if (state_values[var] != old_value) {
+            invalidate_proposition(variable_offsets[var] + old_value);
+        }
+    }
+    if (invalidated_propositions.empty())
+        return true;
+
+    /*
+      Operators with an invalidated precondition may become more expensive.
+      Their effects lose their cost if the operator is a cheapest achiever.
+    */
+    int max_invalidated_propositions =
+        num_propositions * MAX_INVALIDATED_FRACTION;
+    for (size_t i = 0; i < invalidated_propositions.size(); ++i) {
+        if (static_cast<int>(i) > max_invalidated_propositions) {
+            for (int op_id : affected_operators)
+                is_affected_operator[op_id] = false;
+            affected_operators.clear();
+            invalidated_propositions.clear();
+            return false;
+        }
+        int prop_id = invalidated_propositions[i];
+        for (int op_id : get_precondition_of(prop_id)) {
+            if (is_affected_operator[op_id])
+                continue;
+            is_affected_operator[op_id] = true;
+            affected_operators.push_back(op_id);
+            const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (relaxed_op.unsatisfied_preconditions)
+                continue;
+            int op_cost = relaxed_op.h_max_supporter_cost + relaxed_op.cost;
+            for (int effect : get_effects(op_id)) {
+                if (propositions[effect].h_max_cost != op_cost)
+                    continue;
+                if (effect != artificial_goal) {
+                    // Propositions that hold in both states keep cost 0.
+                    int var = upper_bound(variable_offsets.begin(),
+                                          variable_offsets.end(), effect) -
+                        variable_offsets.begin() - 1;
+                    int value = effect - variable_offsets[var];
+                    if (state_values[var] == value &&
+                        reference_state_values[var] == value)
+                        continue;
+                }
+                invalidate_proposition(effect);
+            }
+        }
+    }
+
+    for (int op_id : affected_operators) {
+        RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+        relaxed_op.unsatisfied_preconditions = 0;
+        for (int pre : get_preconditions(op_id)) {
+            if (propositions[pre].status == UNREACHED)
+                ++relaxed_op.unsatisfied_preconditions;
+        }
+        if (relaxed_op.unsatisfied_preconditions) {
+            relaxed_op.h_max_supporter = NO_PROPOSITION;
+            relaxed_op.h_max_supporter_cost = numeric_limits<int>::max();
+        } else {
+            compute_h_max_supporter(op_id);
+        }
+        is_affected_operator[op_id] = false;
+    }
+    affected_operators.clear();
+
+    priority_queue.add_virtual_pushes(num_propositions);
+    for (int prop_id : invalidated_propositions) {
+        for (int op_id : get_effect_of(prop_id)) {
+            const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (!relaxed_op.unsatisfied_preconditions)
+                enqueue_if_necessary(
+                    prop_id, relaxed_op.h_max_supporter_cost + relaxed_op.cost);
+        }
+    }
+    invalidated_propositions.clear();
+
+    while (!priority_queue.empty()) {
+        pair<int, int> top_pair = priority_queue.pop();
+        int popped_cost = top_pair.first;
+        int prop_id = top_pair.second;
+        int prop_cost = propositions[prop_id].h_max_cost;
+        assert(prop_cost <= popped_cost);
+        if (prop_cost < popped_cost)
+            continue;
+        // Only invalidated propositions are enqueued, and all their
+        // operators have been counted as unsatisfied above.
+        for (int op_id : get_precondition_of(prop_id)) {
+            RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            --relaxed_op.unsatisfied_preconditions;
+            assert(relaxed_op.unsatisfied_preconditions >= 0);
+            if (relaxed_op.unsatisfied_preconditions == 0) {
+                compute_h_max_supporter(op_id);
+                enqueue_effects(
+                    op_id, relaxed_op.h_max_supporter_cost + relaxed_op.cost);
+            }
+        }
+    }
+    return true;
+}
+
+void LandmarkCutLandmarks::add_facts_incremental(
+    const vector<int> &state_values) {
+    /*
+      Adding facts can only decrease h^max values. Propositions that were
+      unreached before count as satisfied preconditions for the first time
+      when they are popped; for all others we update the h^max supporters
+      as in first_exploration_incremental.
+    */
+    assert(priority_queue.empty());
+    priority_queue.add_virtual_pushes(num_propositions);
+    int num_variables = variable_offsets.size();
+    for (int var = 0; var < num_variables; ++var) {
+        if (state_values[var] != reference_state_values[var]) {
+            int prop_id = variable_offsets[var] + state_values[var];
+            if (propositions[prop_id].status == UNREACHED)
+                is_newly_reached[prop_id] = true;
+            enqueue_if_necessary(prop_id, 0);
+        }
+    }
+    while (!priority_queue.empty()) {
+        pair<int, int> top_pair = priority_queue.pop();
+        int popped_cost = top_pair.first;
+        int prop_id = top_pair.second;
+        int prop_cost = propositions[prop_id].h_max_cost;
+        assert(prop_cost <= popped_cost);
+        if (prop_cost < popped_cost)
+            continue;
+        bool newly_reached = is_newly_reached[prop_id];
+        is_newly_reached[prop_id] = false;
+        for (int op_id : get_precondition_of(prop_id)) {
+            RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (newly_reached) {
+                --relaxed_op.unsatisfied_preconditions;
+                assert(relaxed_op.unsatisfied_preconditions >= 0);
+                if (relaxed_op.unsatisfied_preconditions == 0) {
+                    compute_h_max_supporter(op_id);
+                    enqueue_effects_incremental(
+                        op_id, relaxed_op.h_max_supporter_cost + relaxed_op.cost);
+                }
+            } else if (relaxed_op.h_max_supporter == prop_id &&
+                       relaxed_op.h_max_supporter_cost > prop_cost) {
+                int old_supp_cost = relaxed_op.h_max_supporter_cost;
+                update_h_max_supporter(op_id);
+                int new_supp_cost = relaxed_op.h_max_supporter_cost;
+                if (new_supp_cost != old_supp_cost) {
+                    assert(new_supp_cost < old_supp_cost);
+                    enqueue_effects_incremental(
+                        op_id, new_supp_cost + relaxed_op.cost);
+                }
+            }
+        }
+    }
+}
+
 void LandmarkCutLandmarks::second_exploration(
-    const State &state, vector<RelaxedProposition *> &second_exploration_queue,
-    vector<RelaxedOperator *> &cut) {
+    const State &state, vector<int> &second_exploration_queue,
+    vector<int> &cut) {
     assert(second_exploration_queue.empty());
     assert(cut.empty());
 
-    artificial_precondition.status = BEFORE_GOAL_ZONE;
-    second_exploration_queue.push_back(&artificial_precondition);
+    propositions[artificial_precondition].status = BEFORE_GOAL_ZONE;
+    second_exploration_queue.push_back(artificial_precondition);
 
     for (FactProxy init_fact : state) {
-        RelaxedProposition *init_prop = get_proposition(init_fact);
-        init_prop->status = BEFORE_GOAL_ZONE;
+        int init_prop = get_proposition(init_fact);
+        propositions[init_prop].status = BEFORE_GOAL_ZONE;
         second_exploration_queue.push_back(init_prop);
     }
 
     while (!second_exploration_queue.empty()) {
-        RelaxedProposition *prop = second_exploration_queue.back();
+        int prop_id = second_exploration_queue.back();
         second_exploration_queue.pop_back();
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
+        for (int op_id : get_precondition_of(prop_id)) {
+            const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (relaxed_op.h_max_supporter == prop_id) {
                 bool reached_goal_zone = false;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    if (effect->status == GOAL_ZONE) {
-                        assert(relaxed_op->cost > 0);
+                for (int effect : get_effects(op_id)) {
+                    if (propositions[effect].status == GOAL_ZONE) {
+                        assert(relaxed_op.cost > 0);
                         reached_goal_zone = true;
-                        cut.push_back(relaxed_op);
+                        cut.push_back(op_id);
                         break;
                     }
                 }
                 if (!reached_goal_zone) {
-                    for (RelaxedProposition *effect : relaxed_op->effects) {
-                        if (effect->status != BEFORE_GOAL_ZONE) {
-                            assert(effect->status == REACHED);
-                            effect->status = BEFORE_GOAL_ZONE;
+                    for (int effect : get_effects(op_id)) {
+                        RelaxedProposition &effect_prop = propositions[effect];
+                        if (effect_prop.status != BEFORE_GOAL_ZONE) {
+                            assert(effect_prop.status == REACHED);
+                            effect_prop.status = BEFORE_GOAL_ZONE;
                             second_exploration_queue.push_back(effect);
                         }
                     }
@@ -231,16 +433,18 @@ void LandmarkCutLandmarks::second_exploration(
     }
 }
 
-void LandmarkCutLandmarks::mark_goal_plateau(RelaxedProposition *subgoal) {
-    // NOTE: subgoal can be null if we got here via recursion through
-    // a zero-cost action that is relaxed unreachable. (This can only
-    // happen in domains which have zero-cost actions to start with.)
+void LandmarkCutLandmarks::mark_goal_plateau(int subgoal) {
+    // NOTE: subgoal can be NO_PROPOSITION if we got here via recursion
+    // through a zero-cost action that is relaxed unreachable. (This can
+    // only happen in domains which have zero-cost actions to start with.)
     // For example, this happens in pegsol-strips #01.
-    if (subgoal && subgoal->status != GOAL_ZONE) {
-        subgoal->status = GOAL_ZONE;
-        for (RelaxedOperator *achiever : subgoal->effect_of)
-            if (achiever->cost == 0)
-                mark_goal_plateau(achiever->h_max_supporter);
+    if (subgoal != NO_PROPOSITION && propositions[subgoal].status != GOAL_ZONE) {
+        propositions[subgoal].status = GOAL_ZONE;
+        for (int achiever : get_effect_of(subgoal)) {
+            const RelaxedOperator &relaxed_op = relaxed_operators[achiever];
+            if (relaxed_op.cost == 0)
+                mark_goal_plateau(relaxed_op.h_max_supporter);
+        }
     }
 }
 
@@ -249,24 +453,25 @@ void LandmarkCutLandmarks::validate_h_max() const {
     // Using conditional compilation to avoid complaints about unused
     // variables when using NDEBUG. This whole code does nothing useful
     // when assertions are switched off anyway.
-    for (const RelaxedOperator &op : relaxed_operators) {
+    for (size_t op_id = 0; op_id < relaxed_operators.size(); ++op_id) {
+        const RelaxedOperator &op = relaxed_operators[op_id];
         if (op.unsatisfied_preconditions) {
             bool reachable = true;
-            for (RelaxedProposition *pre : op.preconditions) {
-                if (pre->status == UNREACHED) {
+            for (int pre : get_preconditions(op_id)) {
+                if (propositions[pre].status == UNREACHED) {
                     reachable = false;
                     break;
                 }
             }
             assert(!reachable);
-            assert(!op.h_max_supporter);
+            assert(op.h_max_supporter == NO_PROPOSITION);
         } else {
-            assert(op.h_max_supporter);
+            assert(op.h_max_supporter != NO_PROPOSITION);
             int h_max_cost = op.h_max_supporter_cost;
-            assert(h_max_cost == op.h_max_supporter->h_max_cost);
-            for (RelaxedProposition *pre : op.preconditions) {
-                assert(pre->status != UNREACHED);
-                assert(pre->h_max_cost <= h_max_cost);
+            assert(h_max_cost == propositions[op.h_max_supporter].h_max_cost);
+            for (int pre : get_preconditions(op_id)) {
+                assert(propositions[pre].status != UNREACHED);
+                assert(propositions[pre].h_max_cost <= h_max_cost);
             }
         }
     }
@@ -276,41 +481,58 @@ void LandmarkCutLandmarks::validate_h_max() const {
 bool LandmarkCutLandmarks::compute_landmarks(
     State state, CostCallback cost_callback,
     LandmarkCallback landmark_callback) {
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.cost = op.base_cost;
+    if (incremental && has_reference_state) {
+        // The reference data is computed with the original operator costs.
+        swap(relaxed_operators, reference_operators);
+        swap(propositions, reference_propositions);
+        const vector<int> &state_values = state.get_values();
+        if (remove_facts_incremental(state_values))
+            add_facts_incremental(state_values);
+        else
+            first_exploration(state);
+    } else {
+        for (RelaxedOperator &op : relaxed_operators) {
+            op.cost = op.base_cost;
+        }
+        first_exploration(state);
+    }
+    // validate_h_max();  // too expensive to use even in regular debug mode
+    if (incremental) {
+        reference_operators = relaxed_operators;
+        reference_propositions = propositions;
+        reference_state_values = state.get_values();
+        has_reference_state = true;
     }
+    if (propositions[artificial_goal].status == UNREACHED)
+        return true;
+
     // The following three variables could be declared inside the loop
     // ("second_exploration_queue" even inside second_exploration),
     // but having them here saves reallocations and hence provides a
     // measurable speed boost.
-    vector<RelaxedOperator *> cut;
+    vector<int> cut;
     Landmark landmark;
-    vector<RelaxedProposition *> second_exploration_queue;
-    first_exploration(state);
-    // validate_h_max();  // too expensive to use even in regular debug mode
-    if (artificial_goal.status == UNREACHED)
-        return true;
-
+    vector<int> second_exploration_queue;
     int num_iterations = 0;
-    while (artificial_goal.h_max_cost != 0) {
+    while (propositions[artificial_goal].h_max_cost != 0) {
         ++num_iterations;
-        mark_goal_plateau(&artificial_goal);
+        mark_goal_plateau(artificial_goal);
         assert(cut.empty());
         second_exploration(state, second_exploration_queue, cut);
         assert(!cut.empty());
         int cut_cost = numeric_limits<int>::max();
-        for (RelaxedOperator *op : cut)
-            cut_cost = min(cut_cost, op->cost);
-        for (RelaxedOperator *op : cut)
-            op->cost -= cut_cost;
+        for (int op_id : cut)
+            cut_cost = min(cut_cost, relaxed_operators[op_id].cost);
+        for (int op_id : cut)
+            relaxed_operators[op_id].cost -= cut_cost;
 
         if (cost_callback) {
             cost_callback(cut_cost);
         }
         if (landmark_callback) {
             landmark.clear();
-            for (RelaxedOperator *op : cut) {
-                landmark.push_back(op->original_op_id);
+            for (int op_id : cut) {
+                landmark.push_back(relaxed_operators[op_id].original_op_id);
             }
             landmark_callback(landmark, cut_cost);
         }
@@ -325,14 +547,10 @@ bool LandmarkCutLandmarks::compute_landmarks(
           or something based on total_cost, so that we don't need a per-round
           reinitialization.
         */
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                    prop.status = REACHED;
-            }
+        for (RelaxedProposition &prop : propositions) {
+            if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
+                prop.status = REACHED;
         }
-        artificial_goal.status = REACHED;
-        artificial_precondition.status = REACHED;
     }
     return false;
 }
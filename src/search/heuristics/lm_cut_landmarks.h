@@ -7,12 +7,12 @@
 
 #include <cassert>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <vector>
 
 namespace lm_cut_heuristic {
 // TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
 
 enum PropositionStatus {
     UNREACHED = 0,
@@ -21,71 +21,185 @@ enum PropositionStatus {
     BEFORE_GOAL_ZONE = 3
 };
 
+const int NO_PROPOSITION = -1;
+
+/*
+  Relaxed operators and propositions refer to each other by index. The
+  preconditions and effects of all operators are stored consecutively in
+  one vector of proposition IDs, and the operators that have a proposition
+  as precondition or effect in one vector of operator IDs. Operators and
+  propositions only store where their entries begin and end.
+*/
 struct RelaxedOperator {
     int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
     int base_cost; // 0 for axioms, 1 for regular operators
+    // Preconditions end where the effects begin.
+    int preconditions_begin;
+    int effects_begin;
+    int effects_end;
 
     int cost;
     int unsatisfied_preconditions;
     int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base) {
+    int h_max_supporter;
+    RelaxedOperator(int op_id, int base, int preconditions_begin,
+                    int effects_begin, int effects_end)
+        : original_op_id(op_id),
+          base_cost(base),
+          preconditions_begin(preconditions_begin),
+          effects_begin(effects_begin),
+          effects_end(effects_end),
+          cost(base),
+          unsatisfied_preconditions(0),
+          h_max_supporter_cost(std::numeric_limits<int>::max()),
+          h_max_supporter(NO_PROPOSITION) {
     }
-
-    inline void update_h_max_supporter();
 };
 
 struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
+    // Operators with this precondition end where the achievers begin.
+    int precondition_of_begin;
+    int effect_of_begin;
+    int effect_of_end;
 
     PropositionStatus status;
     int h_max_cost;
+
+    RelaxedProposition()
+        : precondition_of_begin(0),
+          effect_of_begin(0),
+          effect_of_end(0),
+          status(UNREACHED),
+          h_max_cost(0) {
+    }
+};
+
+class IndexRange {
+    const int *first;
+    const int *last;
+public:
+    IndexRange(const int *first, const int *last)
+        : first(first), last(last) {
+    }
+
+    const int *begin() const {
+        return first;
+    }
+
+    const int *end() const {
+        return last;
+    }
+
+    int size() const {
+        return last - first;
+    }
 };
 
 class LandmarkCutLandmarks {
     std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
+    std::vector<RelaxedProposition> propositions;
+    // Index of the proposition for value 0 of each variable.
+    std::vector<int> variable_offsets;
+    std::vector<int> operator_propositions;
+    std::vector<int> proposition_operators;
+    int artificial_precondition;
+    int artificial_goal;
     int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
+    priority_queues::AdaptiveQueue<int> priority_queue;
 
-    void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
+    /*
+      In incremental mode, we keep the h^max values (for the original
+      costs) of the previously evaluated state and repair them for the
+      facts that differ in the next state instead of computing them from
+      scratch.
+    */
+    const bool incremental;
+    bool has_reference_state;
+    std::vector<int> reference_state_values;
+    std::vector<RelaxedOperator> reference_operators;
+    std::vector<RelaxedProposition> reference_propositions;
+    std::vector<int> invalidated_propositions;
+    std::vector<int> affected_operators;
+    std::vector<bool> is_affected_operator;
+    std::vector<bool> is_newly_reached;
+
+    void add_relaxed_operator(std::vector<int> &&precondition,
+                              std::vector<int> &&effects,
                               int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
+    void cross_reference_relaxed_operators();
+    int get_proposition(const FactProxy &fact) const;
+
+    IndexRange get_preconditions(int op_id) const {
+        const RelaxedOperator &op = relaxed_operators[op_id];
+        const int *data = operator_propositions.data();
+        return IndexRange(data + op.preconditions_begin, data + op.effects_begin);
+    }
+
+    IndexRange get_effects(int op_id) const {
+        const RelaxedOperator &op = relaxed_operators[op_id];
+        const int *data = operator_propositions.data();
+        return IndexRange(data + op.effects_begin, data + op.effects_end);
+    }
+
+    IndexRange get_precondition_of(int prop_id) const {
+        const RelaxedProposition &prop = propositions[prop_id];
+        const int *data = proposition_operators.data();
+        return IndexRange(data + prop.precondition_of_begin,
+                          data + prop.effect_of_begin);
+    }
+
+    IndexRange get_effect_of(int prop_id) const {
+        const RelaxedProposition &prop = propositions[prop_id];
+        const int *data = proposition_operators.data();
+        return IndexRange(data + prop.effect_of_begin, data + prop.effect_of_end);
+    }
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
+    void first_exploration_incremental(std::vector<int> &cut);
     void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
+                            std::vector<int> &second_exploration_queue,
+                            std::vector<int> &cut);
+
+    bool remove_facts_incremental(const std::vector<int> &state_values);
+    void add_facts_incremental(const std::vector<int> &state_values);
+    void invalidate_proposition(int prop_id);
 
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    void enqueue_if_necessary(int prop_id, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
-            priority_queue.push(cost, prop);
+        RelaxedProposition &prop = propositions[prop_id];
+        if (prop.status == UNREACHED || prop.h_max_cost > cost) {
+            prop.status = REACHED;
+            prop.h_max_cost = cost;
+            priority_queue.push(cost, prop_id);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    void enqueue_effects(int op_id, int cost) {
+        for (int effect : get_effects(op_id))
+            enqueue_if_necessary(effect, cost);
+    }
+
+    // Like enqueue_effects, but remember propositions reached for the first time.
+    void enqueue_effects_incremental(int op_id, int cost) {
+        for (int effect : get_effects(op_id)) {
+            if (propositions[effect].status == UNREACHED)
+                is_newly_reached[effect] = true;
+            enqueue_if_necessary(effect, cost);
+        }
+    }
+
+    inline void compute_h_max_supporter(int op_id);
+    inline void update_h_max_supporter(int op_id);
+    void mark_goal_plateau(int subgoal);
     void validate_h_max() const;
 public:
     using Landmark = std::vector<int>;
     using CostCallback = std::function<void (int)>;
     using LandmarkCallback = std::function<void (const Landmark &, int)>;
 
-    LandmarkCutLandmarks(const TaskProxy &task_proxy);
+    explicit LandmarkCutLandmarks(
+        const TaskProxy &task_proxy, bool incremental = false);
     virtual ~LandmarkCutLandmarks();
 
     /*
@@ -105,12 +219,28 @@ public:
                            LandmarkCallback landmark_callback);
 };
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
+// Set the h^max supporter of a reached operator from scratch.
+inline void LandmarkCutLandmarks::compute_h_max_supporter(int op_id) {
+    RelaxedOperator &op = relaxed_operators[op_id];
+    assert(!op.unsatisfied_preconditions);
+    op.h_max_supporter = NO_PROPOSITION;
+    for (int pre : get_preconditions(op_id)) {
+        if (op.h_max_supporter == NO_PROPOSITION ||
+            propositions[pre].h_max_cost >
+            propositions[op.h_max_supporter].h_max_cost)
+            op.h_max_supporter = pre;
+    }
+    op.h_max_supporter_cost = propositions[op.h_max_supporter].h_max_cost;
+}
+
+inline void LandmarkCutLandmarks::update_h_max_supporter(int op_id) {
+    RelaxedOperator &op = relaxed_operators[op_id];
+    assert(!op.unsatisfied_preconditions);
+    for (int pre : get_preconditions(op_id))
+        if (propositions[pre].h_max_cost >
+            propositions[op.h_max_supporter].h_max_cost)
+            op.h_max_supporter = pre;
+    op.h_max_supporter_cost = propositions[op.h_max_supporter].h_max_cost;
 }
 }
 
@@ -24,9 +24,9 @@ NoveltyHeuristic::NoveltyHeuristic(const Options &opts)
 int NoveltyHeuristic::compute_heuristic(const GlobalState &global_state) {
     solution_found_by_heuristic = false;
 
-    const State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     SearchStatistics statistics;
-    EvaluationContext eval_context(global_state, 0, false, &statistics);
+    EvaluationContext eval_context(get_current_eval_context(), 0, false, &statistics);
     int heuristic_value = eval_context.get_evaluator_value_or_infinity(novelty_heuristic.get());
     if (heuristic_value == EvaluationResult::INFTY)
         return DEAD_END;
@@ -16,6 +16,11 @@ public:
 
     virtual bool found_solution() const { return novelty_heuristic->found_solution(); }
     virtual const std::vector<OperatorID>& get_solution() const;
+    virtual void get_involved_evaluators(
+        std::set<const Evaluator *> &evals) const override {
+        evals.insert(this);
+        novelty_heuristic->get_involved_evaluators(evals);
+    }
 
 };
 }
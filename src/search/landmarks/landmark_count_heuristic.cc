@@ -87,6 +87,25 @@ LandmarkCountHeuristic::LandmarkCountHeuristic(const options::Options &opts)
         /* Ideally, we should reuse the successor generator of the main task in cases
            where it's compatible. See issue564. */
         successor_generator = utils::make_unique_ptr<successor_generator::SuccessorGenerator>(task_proxy);
+        compute_landmark_effects();
+    }
+}
+
+void LandmarkCountHeuristic::compute_landmark_effects() {
+    OperatorsProxy operators = task_proxy.get_operators();
+    landmark_effects_by_operator.resize(operators.size());
+    for (OperatorProxy op : operators) {
+        vector<LandmarkEffect> &landmark_effects =
+            landmark_effects_by_operator[op.get_id()];
+        EffectsProxy effects = op.get_effects();
+        for (size_t effect_id = 0; effect_id < effects.size(); ++effect_id) {
+            FactPair fact = effects[effect_id].get_fact().get_pair();
+            LandmarkNode *landmark = lgraph->get_landmark(fact);
+            if (landmark) {
+                landmark_effects.emplace_back(effect_id, landmark);
+            }
+        }
+        landmark_effects.shrink_to_fit();
     }
 }
 
@@ -125,7 +144,7 @@ int LandmarkCountHeuristic::get_heuristic_value(const GlobalState &global_state)
 }
 
 int LandmarkCountHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
 
     if (task_properties::is_goal_state(task_proxy, state))
         return 0;
@@ -157,21 +176,33 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
      return false. If a simple landmark can be achieved, return only operators
      that achieve simple landmarks, else return operators that achieve
      disjunctive landmarks */
-    assert(successor_generator);
-    vector<OperatorID> applicable_operators;
-    successor_generator->generate_applicable_ops(state, applicable_operators);
+    /*
+      Reuse the applicable operators if the search engine has generated
+      them already. This is safe because our task has the same operators
+      as the root task (see the check in the constructor).
+    */
+    const vector<OperatorID> *applicable_operators = get_applicable_operators();
+    vector<OperatorID> generated_operators;
+    if (!applicable_operators) {
+        assert(successor_generator);
+        successor_generator->generate_applicable_ops(state, generated_operators);
+        applicable_operators = &generated_operators;
+    }
     vector<OperatorID> ha_simple;
     vector<OperatorID> ha_disj;
 
-    for (OperatorID op_id : applicable_operators) {
-        OperatorProxy op = task_proxy.get_operators()[op_id];
-        EffectsProxy effects = op.get_effects();
-        for (EffectProxy effect : effects) {
-            if (!does_fire(effect, state))
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : *applicable_operators) {
+        const vector<LandmarkEffect> &landmark_effects =
+            landmark_effects_by_operator[op_id.get_index()];
+        if (landmark_effects.empty())
+            continue;
+        EffectsProxy effects = operators[op_id].get_effects();
+        for (const LandmarkEffect &landmark_effect : landmark_effects) {
+            if (!does_fire(effects[landmark_effect.effect_id], state))
                 continue;
-            FactProxy fact_proxy = effect.get_fact();
-            LandmarkNode *lm_p = lgraph->get_landmark(fact_proxy.get_pair());
-            if (lm_p != 0 && landmark_is_interesting(state, reached, *lm_p)) {
+            LandmarkNode *lm_p = landmark_effect.landmark;
+            if (landmark_is_interesting(state, reached, *lm_p)) {
                 if (lm_p->disjunctive) {
                     ha_disj.push_back(op_id);
                 } else {
@@ -183,7 +214,6 @@ bool LandmarkCountHeuristic::generate_helpful_actions(const State &state,
     if (ha_disj.empty() && ha_simple.empty())
         return false;
 
-    OperatorsProxy operators = task_proxy.get_operators();
     if (ha_simple.empty()) {
         for (OperatorID op_id : ha_disj) {
             set_preferred(operators[op_id]);
@@ -26,6 +26,22 @@ class LandmarkCountHeuristic : public Heuristic {
     std::unique_ptr<LandmarkCostAssignment> lm_cost_assignment;
     std::unique_ptr<successor_generator::SuccessorGenerator> successor_generator;
 
+    struct LandmarkEffect {
+        int effect_id;
+        LandmarkNode *landmark;
+
+        LandmarkEffect(int effect_id, LandmarkNode *landmark)
+            : effect_id(effect_id), landmark(landmark) {
+        }
+    };
+    /*
+      For each operator, the effects whose facts are landmarks. Only
+      computed for preferred operators.
+    */
+    std::vector<std::vector<LandmarkEffect>> landmark_effects_by_operator;
+
+    void compute_landmark_effects();
+
     int get_heuristic_value(const GlobalState &global_state);
 
     bool check_node_orders_disobeyed(
@@ -10,6 +10,8 @@
 #include "../task_proxy.h"
 
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
+#include "../utils/parallel_options.h"
 #include "../utils/timer.h"
 
 #include <fstream>
@@ -24,7 +26,11 @@ LandmarkFactory::LandmarkFactory(const options::Options &opts)
       only_causal_landmarks(opts.get<bool>("only_causal_landmarks")),
       disjunctive_landmarks(opts.get<bool>("disjunctive_landmarks")),
       conjunctive_landmarks(opts.get<bool>("conjunctive_landmarks")),
-      no_orders(opts.get<bool>("no_orders")) {
+      no_orders(opts.get<bool>("no_orders")),
+      num_threads(utils::parse_num_threads_from_options(opts)) {
+}
+
+LandmarkFactory::~LandmarkFactory() {
 }
 /*
   Note: To allow reusing landmark graphs, we use the following temporary
@@ -103,6 +109,23 @@ void LandmarkFactory::generate(const TaskProxy &task_proxy, Exploration &explora
     calc_achievers(task_proxy, exploration);
 }
 
+void LandmarkFactory::for_each_with_exploration(
+    const TaskProxy &task_proxy, Exploration &exploration, int num_items,
+    const function<void(Exploration &, int)> &func) {
+    int num_used_threads = utils::get_num_used_threads(num_threads, num_items);
+    while (static_cast<int>(thread_explorations.size()) < num_used_threads - 1) {
+        thread_explorations.push_back(
+            utils::make_unique_ptr<Exploration>(task_proxy));
+    }
+    utils::parallel_for(
+        num_used_threads, num_items,
+        [&](int thread_id, int item) {
+            Exploration &thread_exploration = (thread_id == 0) ?
+                exploration : *thread_explorations[thread_id - 1];
+            func(thread_exploration, item);
+        });
+}
+
 bool LandmarkFactory::achieves_non_conditional(const OperatorProxy &o,
                                                const LandmarkNode *lmp) const {
     /* Test whether the landmark is achieved by the operator unconditionally.
@@ -606,20 +629,32 @@ void LandmarkFactory::edge_add(LandmarkNode &from, LandmarkNode &to,
 }
 
 void LandmarkFactory::discard_noncausal_landmarks(const TaskProxy &task_proxy, Exploration &exploration) {
+    /*
+      Whether a landmark is causal only depends on the landmark itself, not
+      on the other landmarks in the graph. We can therefore test all
+      landmarks (possibly concurrently) before removing any of them.
+    */
+    vector<LandmarkNode *> landmark_nodes(
+        lm_graph->get_nodes().begin(), lm_graph->get_nodes().end());
+    int num_landmarks = landmark_nodes.size();
+    // Use char instead of bool to allow concurrent writes.
+    vector<char> is_causal(num_landmarks, false);
+    for_each_with_exploration(
+        task_proxy, exploration, num_landmarks,
+        [&](Exploration &thread_exploration, int i) {
+            is_causal[i] = is_causal_landmark(
+                task_proxy, thread_exploration, *landmark_nodes[i]);
+        });
+
     int number_of_noncausal_landmarks = 0;
-    bool change = true;
     VariablesProxy variables = task_proxy.get_variables();
-    while (change) {
-        change = false;
-        for (LandmarkNode *landmark_node : lm_graph->get_nodes()) {
-            if (!is_causal_landmark(task_proxy, exploration, *landmark_node)) {
-                cout << "Discarding non-causal landmark: ";
-                lm_graph->dump_node(variables, landmark_node);
-                lm_graph->rm_landmark_node(landmark_node);
-                ++number_of_noncausal_landmarks;
-                change = true;
-                break;
-            }
+    for (int i = 0; i < num_landmarks; ++i) {
+        if (!is_causal[i]) {
+            LandmarkNode *landmark_node = landmark_nodes[i];
+            cout << "Discarding non-causal landmark: ";
+            lm_graph->dump_node(variables, landmark_node);
+            lm_graph->rm_landmark_node(landmark_node);
+            ++number_of_noncausal_landmarks;
         }
     }
     cout << "Discarded " << number_of_noncausal_landmarks
@@ -807,27 +842,34 @@ void LandmarkFactory::compute_predecessor_information(
 
 void LandmarkFactory::calc_achievers(const TaskProxy &task_proxy, Exploration &exploration) {
     VariablesProxy variables = task_proxy.get_variables();
-    for (LandmarkNode *lmn : lm_graph->get_nodes()) {
-        for (const FactPair &lm_fact : lmn->facts) {
-            const vector<int> &ops = lm_graph->get_operators_including_eff(lm_fact);
-            lmn->possible_achievers.insert(ops.begin(), ops.end());
-
-            if (variables[lm_fact.var].is_derived())
-                lmn->is_derived = true;
-        }
+    vector<LandmarkNode *> landmark_nodes(
+        lm_graph->get_nodes().begin(), lm_graph->get_nodes().end());
+    // Each landmark only modifies its own achiever sets.
+    for_each_with_exploration(
+        task_proxy, exploration, landmark_nodes.size(),
+        [&](Exploration &thread_exploration, int i) {
+            LandmarkNode *lmn = landmark_nodes[i];
+            for (const FactPair &lm_fact : lmn->facts) {
+                const vector<int> &ops = lm_graph->get_operators_including_eff(lm_fact);
+                lmn->possible_achievers.insert(ops.begin(), ops.end());
+
+                if (variables[lm_fact.var].is_derived())
+                    lmn->is_derived = true;
+            }
 
-        vector<vector<int>> lvl_var;
-        vector<utils::HashMap<FactPair, int>> lvl_op;
-        compute_predecessor_information(task_proxy, exploration, lmn, lvl_var, lvl_op);
+            vector<vector<int>> lvl_var;
+            vector<utils::HashMap<FactPair, int>> lvl_op;
+            compute_predecessor_information(
+                task_proxy, thread_exploration, lmn, lvl_var, lvl_op);
 
-        for (int op_or_axom_id : lmn->possible_achievers) {
-            OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
+            for (int op_or_axom_id : lmn->possible_achievers) {
+                OperatorProxy op = get_operator_or_axiom(task_proxy, op_or_axom_id);
 
-            if (_possibly_reaches_lm(op, lvl_var, lmn)) {
-                lmn->first_achievers.insert(op_or_axom_id);
+                if (_possibly_reaches_lm(op, lvl_var, lmn)) {
+                    lmn->first_achievers.insert(op_or_axom_id);
+                }
             }
-        }
-    }
+        });
 }
 
 void _add_options_to_parser(OptionParser &parser) {
@@ -846,6 +888,7 @@ void _add_options_to_parser(OptionParser &parser) {
     parser.add_option<bool>("no_orders",
                             "discard all orderings",
                             "false");
+    utils::add_parallel_options(parser);
 }
 
 
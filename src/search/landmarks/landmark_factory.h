@@ -3,6 +3,7 @@
 
 #include "landmark_graph.h"
 
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -27,7 +28,7 @@ enum class EdgeType;
 class LandmarkFactory {
 public:
     explicit LandmarkFactory(const options::Options &opts);
-    virtual ~LandmarkFactory() = default;
+    virtual ~LandmarkFactory();
 
     LandmarkFactory(const LandmarkFactory &) = delete;
 
@@ -64,6 +65,18 @@ protected:
                                          std::vector<std::vector<int>> &lvl_var,
                                          std::vector<utils::HashMap<FactPair, int>> &lvl_op);
 
+    /*
+      Call func(exploration, item) for all items in [0, num_items), using
+      up to num_threads threads. Each thread uses its own Exploration
+      object, the main thread uses the given one. The order in which the
+      items are processed is unspecified, so func may only write data
+      owned by the item.
+    */
+    void for_each_with_exploration(
+        const TaskProxy &task_proxy, Exploration &exploration, int num_items,
+        const std::function<void(Exploration &, int)> &func);
+    int get_num_threads() const {return num_threads;}
+
     // protected not private for LandmarkFactoryRpgSearch
     bool achieves_non_conditional(const OperatorProxy &o, const LandmarkNode *lmp) const;
     bool is_landmark_precondition(const OperatorProxy &op, const LandmarkNode *lmp) const;
@@ -74,6 +87,10 @@ private:
     const bool disjunctive_landmarks;
     const bool conjunctive_landmarks;
     const bool no_orders;
+    const int num_threads;
+
+    // Explorations for the additional threads, created on demand.
+    std::vector<std::unique_ptr<Exploration>> thread_explorations;
 
     bool interferes(const TaskProxy &task_proxy,
                     const LandmarkNode *node_a,
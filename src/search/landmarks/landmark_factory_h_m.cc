@@ -6,6 +6,7 @@
 
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 using namespace std;
@@ -592,54 +593,60 @@ void LandmarkFactoryHM::calc_achievers(const TaskProxy &task_proxy, Exploration
     VariablesProxy variables = task_proxy.get_variables();
     // first_achievers are already filled in by compute_h_m_landmarks
     // here only have to do possible_achievers
-    for (LandmarkNode *lmn : lm_graph->get_nodes()) {
-        set<int> candidates;
-        // put all possible adders in candidates set
-        for (const FactPair &lm_fact : lmn->facts) {
-            const vector<int> &ops =
-                lm_graph->get_operators_including_eff(lm_fact);
-            candidates.insert(ops.begin(), ops.end());
-        }
-
-        for (int op_id : candidates) {
-            FluentSet post = get_operator_postcondition(variables.size(), operators[op_id]);
-            FluentSet pre = get_operator_precondition(operators[op_id]);
-            size_t j;
-            for (j = 0; j < lmn->facts.size(); ++j) {
-                const FactPair &lm_fact = lmn->facts[j];
-                // action adds this element of lm as well
-                if (find(post.begin(), post.end(), lm_fact) != post.end())
-                    continue;
-                bool is_mutex = false;
-                for (const FactPair &fluent : post) {
-                    if (variables[fluent.var].get_fact(fluent.value).is_mutex(
-                            variables[lm_fact.var].get_fact(lm_fact.value))) {
-                        is_mutex = true;
+    vector<LandmarkNode *> landmark_nodes(
+        lm_graph->get_nodes().begin(), lm_graph->get_nodes().end());
+    // Each landmark only modifies its own set of possible achievers.
+    utils::parallel_for(
+        get_num_threads(), landmark_nodes.size(),
+        [&](int, int i) {
+            LandmarkNode *lmn = landmark_nodes[i];
+            set<int> candidates;
+            // put all possible adders in candidates set
+            for (const FactPair &lm_fact : lmn->facts) {
+                const vector<int> &ops =
+                    lm_graph->get_operators_including_eff(lm_fact);
+                candidates.insert(ops.begin(), ops.end());
+            }
+
+            for (int op_id : candidates) {
+                FluentSet post = get_operator_postcondition(variables.size(), operators[op_id]);
+                FluentSet pre = get_operator_precondition(operators[op_id]);
+                size_t j;
+                for (j = 0; j < lmn->facts.size(); ++j) {
+                    const FactPair &lm_fact = lmn->facts[j];
+                    // action adds this element of lm as well
+                    if (find(post.begin(), post.end(), lm_fact) != post.end())
+                        continue;
+                    bool is_mutex = false;
+                    for (const FactPair &fluent : post) {
+                        if (variables[fluent.var].get_fact(fluent.value).is_mutex(
+                                variables[lm_fact.var].get_fact(lm_fact.value))) {
+                            is_mutex = true;
+                            break;
+                        }
+                    }
+                    if (is_mutex) {
                         break;
                     }
-                }
-                if (is_mutex) {
-                    break;
-                }
-                for (const FactPair &fluent : pre) {
-                    // we know that lm_val is not added by the operator
-                    // so if it incompatible with the pc, this can't be an achiever
-                    if (variables[fluent.var].get_fact(fluent.value).is_mutex(
-                            variables[lm_fact.var].get_fact(lm_fact.value))) {
-                        is_mutex = true;
+                    for (const FactPair &fluent : pre) {
+                        // we know that lm_val is not added by the operator
+                        // so if it incompatible with the pc, this can't be an achiever
+                        if (variables[fluent.var].get_fact(fluent.value).is_mutex(
+                                variables[lm_fact.var].get_fact(lm_fact.value))) {
+                            is_mutex = true;
+                            break;
+                        }
+                    }
+                    if (is_mutex) {
                         break;
                     }
                 }
-                if (is_mutex) {
-                    break;
+                if (j == lmn->facts.size()) {
+                    // not inconsistent with any of the other landmark fluents
+                    lmn->possible_achievers.insert(op_id);
                 }
             }
-            if (j == lmn->facts.size()) {
-                // not inconsistent with any of the other landmark fluents
-                lmn->possible_achievers.insert(op_id);
-            }
-        }
-    }
+        });
 }
 
 void LandmarkFactoryHM::free_unneeded_memory() {
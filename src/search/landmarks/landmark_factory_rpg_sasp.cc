@@ -425,6 +425,8 @@ void LandmarkFactoryRpgSasp::generate_landmarks(
 
     State initial_state = task_proxy.get_initial_state();
     while (!open_landmarks.empty()) {
+        if (get_num_threads() > 1 && precomputed_explorations.empty())
+            precompute_explorations(task_proxy, exploration, initial_state);
         LandmarkNode *bp = open_landmarks.front();
         open_landmarks.pop_front();
         assert(bp->forward_orders.empty());
@@ -432,11 +434,9 @@ void LandmarkFactoryRpgSasp::generate_landmarks(
         if (!bp->is_true_in_state(initial_state)) {
             // Backchain from landmark bp and compute greedy necessary predecessors.
             // Firstly, collect information about the earliest possible time step in a
-            // relaxed plan that propositions are achieved (in lvl_var) and operators
-            // applied (in lvl_ops).
+            // relaxed plan that propositions are achieved (in lvl_var).
             vector<vector<int>> lvl_var;
-            vector<utils::HashMap<FactPair, int>> lvl_op;
-            compute_predecessor_information(task_proxy, exploration, bp, lvl_var, lvl_op);
+            get_predecessor_information(task_proxy, exploration, bp, lvl_var);
             // Use this information to determine all operators that can possibly achieve bp
             // for the first time, and collect any precondition propositions that all such
             // operators share (if there are any).
@@ -458,11 +458,61 @@ void LandmarkFactoryRpgSasp::generate_landmarks(
                 if (preconditions.size() < 5) { // We don't want disj. LMs to get too big
                     found_disj_lm_and_order(task_proxy, preconditions, *bp, EdgeType::greedy_necessary);
                 }
+        } else {
+            precomputed_explorations.erase(bp);
         }
     }
     add_lm_forward_orders();
 }
 
+void LandmarkFactoryRpgSasp::precompute_explorations(
+    const TaskProxy &task_proxy, Exploration &exploration,
+    const State &initial_state) {
+    /*
+      The relaxed exploration for a landmark only depends on its facts, so
+      we can compute the explorations of the next open landmarks
+      concurrently. The landmarks are then still processed one after the
+      other in the same order as with a single thread, which guarantees
+      that we obtain the same landmark graph.
+    */
+    const int max_batch_size = 16 * get_num_threads();
+    vector<LandmarkNode *> batch;
+    for (LandmarkNode *node : open_landmarks) {
+        if (static_cast<int>(batch.size()) == max_batch_size)
+            break;
+        if (!node->is_true_in_state(initial_state))
+            batch.push_back(node);
+    }
+    vector<PrecomputedExploration> results(batch.size());
+    for_each_with_exploration(
+        task_proxy, exploration, batch.size(),
+        [&](Exploration &thread_exploration, int i) {
+            results[i].facts = batch[i]->facts;
+            vector<utils::HashMap<FactPair, int>> lvl_op;
+            compute_predecessor_information(
+                task_proxy, thread_exploration, batch[i], results[i].lvl_var, lvl_op);
+        });
+    for (size_t i = 0; i < batch.size(); ++i) {
+        precomputed_explorations[batch[i]] = move(results[i]);
+    }
+}
+
+void LandmarkFactoryRpgSasp::get_predecessor_information(
+    const TaskProxy &task_proxy, Exploration &exploration, LandmarkNode *bp,
+    vector<vector<int>> &lvl_var) {
+    auto it = precomputed_explorations.find(bp);
+    if (it != precomputed_explorations.end()) {
+        bool up_to_date = (it->second.facts == bp->facts);
+        if (up_to_date)
+            lvl_var = move(it->second.lvl_var);
+        precomputed_explorations.erase(it);
+        if (up_to_date)
+            return;
+    }
+    vector<utils::HashMap<FactPair, int>> lvl_op;
+    compute_predecessor_information(task_proxy, exploration, bp, lvl_var, lvl_op);
+}
+
 void LandmarkFactoryRpgSasp::approximate_lookahead_orders(
     const TaskProxy &task_proxy, const vector<vector<int>> &lvl_var, LandmarkNode *lmp) {
     // Find all var-val pairs that can only be reached after the landmark
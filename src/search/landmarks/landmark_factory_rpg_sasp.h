@@ -16,6 +16,27 @@ class LandmarkFactoryRpgSasp : public LandmarkFactory {
     // domain transition graph for the variable
     std::vector<std::vector<std::unordered_set<int>>> dtg_successors;
 
+    /*
+      Relaxed explorations for landmarks in open_landmarks that have been
+      computed ahead of time (concurrently) when using multiple threads.
+      We store the facts of the landmark at the time of the exploration,
+      because processing other landmarks can turn a disjunctive landmark
+      into a simple one, in which case we have to recompute it.
+    */
+    struct PrecomputedExploration {
+        std::vector<FactPair> facts;
+        std::vector<std::vector<int>> lvl_var;
+    };
+    std::unordered_map<const LandmarkNode *, PrecomputedExploration> precomputed_explorations;
+
+    void precompute_explorations(const TaskProxy &task_proxy,
+                                 Exploration &exploration,
+                                 const State &initial_state);
+    void get_predecessor_information(const TaskProxy &task_proxy,
+                                     Exploration &exploration,
+                                     LandmarkNode *bp,
+                                     std::vector<std::vector<int>> &lvl_var);
+
     void build_dtg_successors(const TaskProxy &task_proxy);
     void add_dtg_successor(int var_id, int pre, int post);
     void find_forward_orders(const VariablesProxy &variables,
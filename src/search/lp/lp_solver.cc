@@ -1,9 +1,11 @@
 #include "lp_solver.h"
 
 #include "lp_internals.h"
+#include "native_lp_solver.h"
 
 #include "../option_parser.h"
 
+#include "../utils/memory.h"
 #include "../utils/system.h"
 
 #ifdef USE_LP
@@ -20,6 +22,7 @@
 #endif
 
 #include <cassert>
+#include <limits>
 #include <numeric>
 
 using namespace std;
@@ -29,8 +32,8 @@ namespace lp {
 void add_lp_solver_option_to_parser(OptionParser &parser) {
     parser.document_note(
         "Note",
-        "to use an LP solver, you must build the planner with LP support. "
-        "See LPBuildInstructions.");
+        "to use an LP solver other than the native one, you must build the "
+        "planner with LP support. See LPBuildInstructions.");
     vector<string> lp_solvers;
     vector<string> lp_solvers_doc;
     lp_solvers.push_back("CLP");
@@ -39,6 +42,12 @@ void add_lp_solver_option_to_parser(OptionParser &parser) {
     lp_solvers_doc.push_back("commercial solver by IBM");
     lp_solvers.push_back("GUROBI");
     lp_solvers_doc.push_back("commercial solver");
+    lp_solvers.push_back("NATIVE");
+    lp_solvers_doc.push_back(
+        "built-in dual simplex solver that is also available without LP "
+        "support. It reuses the basis of the previous solve, which makes it "
+        "fast for the small LPs that are resolved for every state, but it "
+        "stores the basis inverse densely and is not suited for large LPs");
     parser.add_enum_option(
         "lpsolver",
         lp_solvers,
@@ -73,17 +82,32 @@ LPVariable::LPVariable(double lower_bound, double upper_bound,
       objective_coefficient(objective_coefficient) {
 }
 
-LPSolver::~LPSolver() {
+#ifndef USE_LP
+NO_RETURN
+static void exit_without_lp_support() {
+    ABORT("LP method called but the planner was compiled without LP support.\n"
+          "See http://www.fast-downward.org/LPBuildInstructions\n"
+          "to install an LP solver and use it in the planner, or use lpsolver=native.");
 }
+#endif
 
-#ifdef USE_LP
+LPSolver::~LPSolver() {
+}
 
 LPSolver::LPSolver(LPSolverType solver_type)
     : is_initialized(false),
       is_solved(false),
       num_permanent_constraints(0),
       has_temporary_constraints_(false) {
+    if (solver_type == LPSolverType::NATIVE) {
+        native_solver = utils::make_unique_ptr<NativeLPSolver>();
+        return;
+    }
+#ifdef USE_LP
     lp_solver = create_lp_solver(solver_type);
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::clear_temporary_data() {
@@ -101,6 +125,11 @@ void LPSolver::clear_temporary_data() {
 void LPSolver::load_problem(LPObjectiveSense sense,
                             const vector<LPVariable> &variables,
                             const vector<LPConstraint> &constraints) {
+    if (native_solver) {
+        native_solver->load_problem(sense, variables, constraints);
+        return;
+    }
+#ifdef USE_LP
     clear_temporary_data();
     is_initialized = false;
     num_permanent_constraints = constraints.size();
@@ -161,9 +190,17 @@ void LPSolver::load_problem(LPObjectiveSense sense,
     }
 
     clear_temporary_data();
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints) {
+    if (native_solver) {
+        native_solver->add_temporary_constraints(constraints);
+        return;
+    }
+#ifdef USE_LP
     if (!constraints.empty()) {
         clear_temporary_data();
         int num_rows = constraints.size();
@@ -190,9 +227,17 @@ void LPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints
         has_temporary_constraints_ = true;
         is_solved = false;
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::clear_temporary_constraints() {
+    if (native_solver) {
+        native_solver->clear_temporary_constraints();
+        return;
+    }
+#ifdef USE_LP
     if (has_temporary_constraints_) {
         try {
             lp_solver->restoreBaseModel(num_permanent_constraints);
@@ -202,17 +247,35 @@ void LPSolver::clear_temporary_constraints() {
         has_temporary_constraints_ = false;
         is_solved = false;
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 double LPSolver::get_infinity() const {
+    if (native_solver) {
+        return numeric_limits<double>::infinity();
+    }
+#ifdef USE_LP
     try {
         return lp_solver->getInfinity();
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::set_objective_coefficients(const vector<double> &coefficients) {
+    if (native_solver) {
+        assert(static_cast<int>(coefficients.size()) == get_num_variables());
+        for (size_t i = 0; i < coefficients.size(); ++i) {
+            native_solver->set_objective_coefficient(i, coefficients[i]);
+        }
+        return;
+    }
+#ifdef USE_LP
     assert(static_cast<int>(coefficients.size()) == get_num_variables());
     vector<int> indices(coefficients.size());
     iota(indices.begin(), indices.end(), 0);
@@ -224,9 +287,17 @@ void LPSolver::set_objective_coefficients(const vector<double> &coefficients) {
         handle_coin_error(error);
     }
     is_solved = false;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::set_objective_coefficient(int index, double coefficient) {
+    if (native_solver) {
+        native_solver->set_objective_coefficient(index, coefficient);
+        return;
+    }
+#ifdef USE_LP
     assert(index < get_num_variables());
     try {
         lp_solver->setObjCoeff(index, coefficient);
@@ -234,9 +305,17 @@ void LPSolver::set_objective_coefficient(int index, double coefficient) {
         handle_coin_error(error);
     }
     is_solved = false;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::set_constraint_lower_bound(int index, double bound) {
+    if (native_solver) {
+        native_solver->set_constraint_lower_bound(index, bound);
+        return;
+    }
+#ifdef USE_LP
     assert(index < get_num_constraints());
     try {
         lp_solver->setRowLower(index, bound);
@@ -244,9 +323,17 @@ void LPSolver::set_constraint_lower_bound(int index, double bound) {
         handle_coin_error(error);
     }
     is_solved = false;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::set_constraint_upper_bound(int index, double bound) {
+    if (native_solver) {
+        native_solver->set_constraint_upper_bound(index, bound);
+        return;
+    }
+#ifdef USE_LP
     assert(index < get_num_constraints());
     try {
         lp_solver->setRowUpper(index, bound);
@@ -254,9 +341,17 @@ void LPSolver::set_constraint_upper_bound(int index, double bound) {
         handle_coin_error(error);
     }
     is_solved = false;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::set_variable_lower_bound(int index, double bound) {
+    if (native_solver) {
+        native_solver->set_variable_lower_bound(index, bound);
+        return;
+    }
+#ifdef USE_LP
     assert(index < get_num_variables());
     try {
         lp_solver->setColLower(index, bound);
@@ -264,9 +359,17 @@ void LPSolver::set_variable_lower_bound(int index, double bound) {
         handle_coin_error(error);
     }
     is_solved = false;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::set_variable_upper_bound(int index, double bound) {
+    if (native_solver) {
+        native_solver->set_variable_upper_bound(index, bound);
+        return;
+    }
+#ifdef USE_LP
     assert(index < get_num_variables());
     try {
         lp_solver->setColUpper(index, bound);
@@ -274,9 +377,17 @@ void LPSolver::set_variable_upper_bound(int index, double bound) {
         handle_coin_error(error);
     }
     is_solved = false;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::solve() {
+    if (native_solver) {
+        native_solver->solve();
+        return;
+    }
+#ifdef USE_LP
     try {
         if (is_initialized) {
             lp_solver->resolve();
@@ -295,9 +406,16 @@ void LPSolver::solve() {
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 bool LPSolver::has_optimal_solution() const {
+    if (native_solver) {
+        return native_solver->has_optimal_solution();
+    }
+#ifdef USE_LP
     assert(is_solved);
     try {
         return !lp_solver->isProvenPrimalInfeasible() &&
@@ -306,18 +424,32 @@ bool LPSolver::has_optimal_solution() const {
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 double LPSolver::get_objective_value() const {
+    if (native_solver) {
+        return native_solver->get_objective_value();
+    }
+#ifdef USE_LP
     assert(has_optimal_solution());
     try {
         return lp_solver->getObjValue();
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 vector<double> LPSolver::extract_solution() const {
+    if (native_solver) {
+        return native_solver->extract_solution();
+    }
+#ifdef USE_LP
     assert(has_optimal_solution());
     try {
         const double *sol = lp_solver->getColSolution();
@@ -325,32 +457,57 @@ vector<double> LPSolver::extract_solution() const {
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 int LPSolver::get_num_variables() const {
+    if (native_solver) {
+        return native_solver->get_num_variables();
+    }
+#ifdef USE_LP
     try {
         return lp_solver->getNumCols();
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 int LPSolver::get_num_constraints() const {
+    if (native_solver) {
+        return native_solver->get_num_constraints();
+    }
+#ifdef USE_LP
     try {
         return lp_solver->getNumRows();
     } catch (CoinError &error) {
         handle_coin_error(error);
     }
+#else
+    exit_without_lp_support();
+#endif
 }
 
 int LPSolver::has_temporary_constraints() const {
+    if (native_solver) {
+        return native_solver->has_temporary_constraints();
+    }
+#ifdef USE_LP
     return has_temporary_constraints_;
+#else
+    exit_without_lp_support();
+#endif
 }
 
 void LPSolver::print_statistics() const {
     cout << "LP variables: " << get_num_variables() << endl;
     cout << "LP constraints: " << get_num_constraints() << endl;
+    if (native_solver) {
+        native_solver->print_statistics();
+    }
 }
-
-#endif
 }
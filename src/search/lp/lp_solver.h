@@ -8,21 +8,6 @@
 #include <memory>
 #include <vector>
 
-/*
-  All methods that use COIN specific classes only do something useful
-  if the planner is compiled with USE_LP. Otherwise, they just print
-  an error message and abort.
-*/
-#ifdef USE_LP
-#define LP_METHOD(X) X;
-#else
-#define LP_METHOD(X) NO_RETURN X { \
-        ABORT("LP method called but the planner was compiled without LP support.\n" \
-              "See http://www.fast-downward.org/LPBuildInstructions\n" \
-              "to install an LP solver and use it in the planner."); \
-}
-#endif
-
 class CoinPackedVectorBase;
 class OsiSolverInterface;
 
@@ -31,8 +16,10 @@ class OptionParser;
 }
 
 namespace lp {
+class NativeLPSolver;
+
 enum class LPSolverType {
-    CLP, CPLEX, GUROBI
+    CLP, CPLEX, GUROBI, NATIVE
 };
 
 enum class LPObjectiveSense {
@@ -73,10 +60,12 @@ struct LPVariable {
                double objective_coefficient);
 };
 
-#ifdef __GNUG__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#endif
+/*
+  Interface to the LP solvers. The external solvers are accessed via OSI and
+  are only available if the planner is compiled with USE_LP. Otherwise, using
+  them prints an error message and aborts. The native solver (see
+  NativeLPSolver) is always available.
+*/
 class LPSolver {
     bool is_initialized;
     bool is_solved;
@@ -85,6 +74,7 @@ class LPSolver {
 #ifdef USE_LP
     std::unique_ptr<OsiSolverInterface> lp_solver;
 #endif
+    std::unique_ptr<NativeLPSolver> native_solver;
 
     /*
       Temporary data for assigning a new problem. We keep the vectors
@@ -101,31 +91,30 @@ class LPSolver {
     std::vector<CoinPackedVectorBase *> rows;
     void clear_temporary_data();
 public:
-    LP_METHOD(explicit LPSolver(LPSolverType solver_type))
+    explicit LPSolver(LPSolverType solver_type);
     /*
-      Note that the destructor does not use LP_METHOD because it should not
-      have the attribute NO_RETURN. It also cannot be set to the default
-      destructor here (~LPSolver() = default;) because OsiSolverInterface
-      is a forward declaration and the incomplete type cannot be destroyed.
+      Note that the destructor cannot be set to the default destructor here
+      (~LPSolver() = default;) because OsiSolverInterface and NativeLPSolver
+      are forward declarations and the incomplete types cannot be destroyed.
     */
     ~LPSolver();
 
-    LP_METHOD(void load_problem(
-                  LPObjectiveSense sense,
-                  const std::vector<LPVariable> &variables,
-                  const std::vector<LPConstraint> &constraints))
-    LP_METHOD(void add_temporary_constraints(const std::vector<LPConstraint> &constraints))
-    LP_METHOD(void clear_temporary_constraints())
-    LP_METHOD(double get_infinity() const)
+    void load_problem(
+        LPObjectiveSense sense,
+        const std::vector<LPVariable> &variables,
+        const std::vector<LPConstraint> &constraints);
+    void add_temporary_constraints(const std::vector<LPConstraint> &constraints);
+    void clear_temporary_constraints();
+    double get_infinity() const;
 
-    LP_METHOD(void set_objective_coefficients(const std::vector<double> &coefficients))
-    LP_METHOD(void set_objective_coefficient(int index, double coefficient))
-    LP_METHOD(void set_constraint_lower_bound(int index, double bound))
-    LP_METHOD(void set_constraint_upper_bound(int index, double bound))
-    LP_METHOD(void set_variable_lower_bound(int index, double bound))
-    LP_METHOD(void set_variable_upper_bound(int index, double bound))
+    void set_objective_coefficients(const std::vector<double> &coefficients);
+    void set_objective_coefficient(int index, double coefficient);
+    void set_constraint_lower_bound(int index, double bound);
+    void set_constraint_upper_bound(int index, double bound);
+    void set_variable_lower_bound(int index, double bound);
+    void set_variable_upper_bound(int index, double bound);
 
-    LP_METHOD(void solve())
+    void solve();
 
     /*
       Return true if the solving the LP showed that it is bounded feasible and
@@ -134,14 +123,14 @@ public:
       solutions due to numerical difficulties.
       The LP has to be solved with a call to solve() before calling this method.
     */
-    LP_METHOD(bool has_optimal_solution() const)
+    bool has_optimal_solution() const;
 
     /*
       Return the objective value found after solving an LP.
       The LP has to be solved with a call to solve() and has to have an optimal
       solution before calling this method.
     */
-    LP_METHOD(double get_objective_value() const)
+    double get_objective_value() const;
 
     /*
       Return the solution found after solving an LP as a vector with one entry
@@ -149,16 +138,13 @@ public:
       The LP has to be solved with a call to solve() and has to have an optimal
       solution before calling this method.
     */
-    LP_METHOD(std::vector<double> extract_solution() const)
+    std::vector<double> extract_solution() const;
 
-    LP_METHOD(int get_num_variables() const)
-    LP_METHOD(int get_num_constraints() const)
-    LP_METHOD(int has_temporary_constraints() const)
-    LP_METHOD(void print_statistics() const)
+    int get_num_variables() const;
+    int get_num_constraints() const;
+    int has_temporary_constraints() const;
+    void print_statistics() const;
 };
-#ifdef __GNUG__
-#pragma GCC diagnostic pop
-#endif
 }
 
 #endif
@@ -0,0 +1,812 @@
+#include "native_lp_solver.h"
+
+#include "lp_solver.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace lp {
+static const double INFINITE_BOUND = numeric_limits<double>::infinity();
+// Bounds with a larger absolute value are treated as infinite (like CPLEX).
+static const double LARGEST_FINITE_BOUND = 1e20;
+static const double PRIMAL_TOLERANCE = 1e-7;
+static const double DUAL_TOLERANCE = 1e-7;
+static const double PIVOT_TOLERANCE = 1e-7;
+static const double INITIAL_ARTIFICIAL_BOUND = 1e6;
+static const double MAX_ARTIFICIAL_BOUND = 1e12;
+static const int REFACTORIZATION_INTERVAL = 100;
+/*
+  After this many consecutive pivots that do not change the objective
+  value, we use Bland's rule until the objective value changes again.
+*/
+static const int MAX_DEGENERATE_PIVOTS = 50;
+
+static double normalize_bound(double bound) {
+    if (bound >= LARGEST_FINITE_BOUND) {
+        return INFINITE_BOUND;
+    } else if (bound <= -LARGEST_FINITE_BOUND) {
+        return -INFINITE_BOUND;
+    }
+    return bound;
+}
+
+static double get_tolerance(double base_tolerance, double bound) {
+    return base_tolerance * max(1.0, abs(bound));
+}
+
+NativeLPSolver::NativeLPSolver()
+    : num_structural_variables(0),
+      num_permanent_rows(0),
+      objective_sign(1),
+      artificial_bound(INITIAL_ARTIFICIAL_BOUND),
+      basis_is_factored(false),
+      num_updates_since_factorization(0),
+      solve_status(SolveStatus::UNSOLVED),
+      num_iterations(0),
+      num_solves(0) {
+}
+
+int NativeLPSolver::get_num_rows() const {
+    return rows.size();
+}
+
+int NativeLPSolver::get_num_all_variables() const {
+    return num_structural_variables + get_num_rows();
+}
+
+double NativeLPSolver::get_cost(int var) const {
+    if (var < num_structural_variables) {
+        return objective_sign * objective[var];
+    }
+    return 0;
+}
+
+void NativeLPSolver::reset_basis() {
+    int num_rows = get_num_rows();
+    int num_variables = get_num_all_variables();
+    statuses.assign(num_variables, VariableStatus::AT_LOWER);
+    basic_variables.resize(num_rows);
+    for (int row = 0; row < num_rows; ++row) {
+        int var = num_structural_variables + row;
+        basic_variables[row] = var;
+        statuses[var] = VariableStatus::BASIC;
+    }
+    basis_is_factored = false;
+}
+
+void NativeLPSolver::pivot_basis_inverse(int position, const vector<double> &column) {
+    int num_rows = get_num_rows();
+    double *pivot_inverse_row = &basis_inverse[position * num_rows];
+    double pivot = column[position];
+    vector<int> nonzero_indices;
+    for (int i = 0; i < num_rows; ++i) {
+        if (pivot_inverse_row[i] != 0) {
+            pivot_inverse_row[i] /= pivot;
+            nonzero_indices.push_back(i);
+        }
+    }
+    for (int pos = 0; pos < num_rows; ++pos) {
+        double factor = column[pos];
+        if (pos != position && factor != 0) {
+            double *inverse_row = &basis_inverse[pos * num_rows];
+            for (int i : nonzero_indices) {
+                inverse_row[i] -= factor * pivot_inverse_row[i];
+            }
+        }
+    }
+    ++num_updates_since_factorization;
+}
+
+void NativeLPSolver::compute_column(int var, vector<double> &column) const {
+    // Compute B^{-1} a_var, where a_var is the column of var in [A -I].
+    int num_rows = get_num_rows();
+    column.assign(num_rows, 0);
+    if (var < num_structural_variables) {
+        for (const MatrixEntry &entry : columns[var]) {
+            for (int pos = 0; pos < num_rows; ++pos) {
+                column[pos] += basis_inverse[pos * num_rows + entry.index] * entry.value;
+            }
+        }
+    } else {
+        int row = var - num_structural_variables;
+        for (int pos = 0; pos < num_rows; ++pos) {
+            column[pos] = -basis_inverse[pos * num_rows + row];
+        }
+    }
+}
+
+void NativeLPSolver::factorize() {
+    /*
+      Recompute the basis inverse starting from the basis of all logical
+      variables, whose inverse is -I. We then pivot in the structural
+      variables of the current basis one after the other, replacing logical
+      variables that are not part of the current basis. Structural variables
+      that are linearly dependent on the ones added before are skipped, and
+      the positions that are not taken by a structural variable keep their
+      logical variable. This way, we always get a regular basis, even if the
+      current basis is singular or has the wrong size (e.g., after removing
+      temporary constraints).
+    */
+    int num_rows = get_num_rows();
+    int num_structurals = num_structural_variables;
+    vector<int> candidates;
+    vector<bool> logical_is_basic(num_rows, false);
+    for (int var : basic_variables) {
+        if (var < num_structurals) {
+            candidates.push_back(var);
+        } else {
+            logical_is_basic[var - num_structurals] = true;
+        }
+    }
+
+    basic_variables.resize(num_rows);
+    basis_inverse.assign(num_rows * num_rows, 0);
+    for (int row = 0; row < num_rows; ++row) {
+        basic_variables[row] = num_structurals + row;
+        basis_inverse[row * num_rows + row] = -1;
+    }
+    num_updates_since_factorization = 0;
+
+    for (int var : candidates) {
+        compute_column(var, pivot_column);
+        int best_position = -1;
+        double best_pivot = PIVOT_TOLERANCE;
+        for (int pos = 0; pos < num_rows; ++pos) {
+            int row = basic_variables[pos] - num_structurals;
+            if (row >= 0 && !logical_is_basic[row] &&
+                abs(pivot_column[pos]) > best_pivot) {
+                best_position = pos;
+                best_pivot = abs(pivot_column[pos]);
+            }
+        }
+        if (best_position == -1) {
+            // The status is fixed by set_nonbasic_statuses before solving.
+            statuses[var] = VariableStatus::AT_LOWER;
+        } else {
+            pivot_basis_inverse(best_position, pivot_column);
+            basic_variables[best_position] = var;
+        }
+    }
+    for (int var : basic_variables) {
+        statuses[var] = VariableStatus::BASIC;
+    }
+    num_updates_since_factorization = 0;
+    basis_is_factored = true;
+}
+
+void NativeLPSolver::set_nonbasic_statuses() {
+    /*
+      Place all nonbasic variables at a bound that makes their reduced cost
+      dual feasible, introducing artificial bounds where necessary. Variables
+      with a reduced cost of zero keep their status if possible.
+    */
+    int num_variables = get_num_all_variables();
+    for (int var = 0; var < num_variables; ++var) {
+        double lower = lower_bounds[var];
+        double upper = upper_bounds[var];
+        working_lower_bounds[var] = lower;
+        working_upper_bounds[var] = upper;
+        VariableStatus &status = statuses[var];
+        if (status == VariableStatus::BASIC) {
+            continue;
+        }
+        bool has_lower = lower != -INFINITE_BOUND;
+        bool has_upper = upper != INFINITE_BOUND;
+        double reduced_cost = reduced_costs[var];
+        if (reduced_cost > DUAL_TOLERANCE) {
+            if (!has_lower) {
+                working_lower_bounds[var] = -artificial_bound;
+            }
+            status = VariableStatus::AT_LOWER;
+        } else if (reduced_cost < -DUAL_TOLERANCE) {
+            if (!has_upper) {
+                working_upper_bounds[var] = artificial_bound;
+            }
+            status = VariableStatus::AT_UPPER;
+        } else if (!((status == VariableStatus::AT_LOWER && has_lower) ||
+                     (status == VariableStatus::AT_UPPER && has_upper) ||
+                     (status == VariableStatus::AT_ZERO && !has_lower && !has_upper))) {
+            if (has_lower) {
+                status = VariableStatus::AT_LOWER;
+            } else if (has_upper) {
+                status = VariableStatus::AT_UPPER;
+            } else {
+                status = VariableStatus::AT_ZERO;
+            }
+        }
+    }
+}
+
+void NativeLPSolver::compute_values() {
+    // Solve B x_B = -N x_N for the basic variables.
+    int num_rows = get_num_rows();
+    int num_variables = get_num_all_variables();
+    vector<double> rhs(num_rows, 0);
+    for (int var = 0; var < num_variables; ++var) {
+        VariableStatus status = statuses[var];
+        if (status == VariableStatus::BASIC) {
+            continue;
+        }
+        double value = 0;
+        if (status == VariableStatus::AT_LOWER) {
+            value = working_lower_bounds[var];
+        } else if (status == VariableStatus::AT_UPPER) {
+            value = working_upper_bounds[var];
+        }
+        values[var] = value;
+        if (value != 0) {
+            if (var < num_structural_variables) {
+                for (const MatrixEntry &entry : columns[var]) {
+                    rhs[entry.index] -= entry.value * value;
+                }
+            } else {
+                rhs[var - num_structural_variables] += value;
+            }
+        }
+    }
+    for (int pos = 0; pos < num_rows; ++pos) {
+        const double *inverse_row = &basis_inverse[pos * num_rows];
+        double value = 0;
+        for (int row = 0; row < num_rows; ++row) {
+            value += inverse_row[row] * rhs[row];
+        }
+        values[basic_variables[pos]] = value;
+    }
+}
+
+void NativeLPSolver::compute_reduced_costs() {
+    // Compute the duals y = c_B B^{-1} and the reduced costs d = c - y [A -I].
+    int num_rows = get_num_rows();
+    vector<double> duals(num_rows, 0);
+    for (int pos = 0; pos < num_rows; ++pos) {
+        double cost = get_cost(basic_variables[pos]);
+        if (cost != 0) {
+            const double *inverse_row = &basis_inverse[pos * num_rows];
+            for (int row = 0; row < num_rows; ++row) {
+                duals[row] += cost * inverse_row[row];
+            }
+        }
+    }
+    for (int var = 0; var < num_structural_variables; ++var) {
+        double reduced_cost = 0;
+        if (statuses[var] != VariableStatus::BASIC) {
+            reduced_cost = get_cost(var);
+            for (const MatrixEntry &entry : columns[var]) {
+                reduced_cost -= duals[entry.index] * entry.value;
+            }
+        }
+        reduced_costs[var] = reduced_cost;
+    }
+    for (int row = 0; row < num_rows; ++row) {
+        int var = num_structural_variables + row;
+        if (statuses[var] == VariableStatus::BASIC) {
+            reduced_costs[var] = 0;
+        } else {
+            reduced_costs[var] = duals[row];
+        }
+    }
+}
+
+bool NativeLPSolver::is_at_artificial_bound(int var) const {
+    return (statuses[var] == VariableStatus::AT_LOWER &&
+            lower_bounds[var] == -INFINITE_BOUND) ||
+           (statuses[var] == VariableStatus::AT_UPPER &&
+            upper_bounds[var] == INFINITE_BOUND);
+}
+
+bool NativeLPSolver::is_blocked_by_artificial_bound(
+    int leaving, bool leaves_at_lower) const {
+    /*
+      No entering variable was found for the pivot row, so the leaving
+      variable cannot reach its target within the working bounds. This only
+      proves that the LP is infeasible if neither the target nor the bound of
+      a nonbasic variable in the pivot row is artificial.
+    */
+    if (leaves_at_lower ? lower_bounds[leaving] == -INFINITE_BOUND
+        : upper_bounds[leaving] == INFINITE_BOUND) {
+        return true;
+    }
+    int num_variables = get_num_all_variables();
+    for (int var = 0; var < num_variables; ++var) {
+        if (abs(pivot_row[var]) > PIVOT_TOLERANCE && is_at_artificial_bound(var)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int NativeLPSolver::choose_leaving_position(bool use_blands_rule) const {
+    /*
+      Choose the basic variable with the largest bound violation or, with
+      Bland's rule, the infeasible basic variable with the smallest index.
+    */
+    int num_rows = get_num_rows();
+    int best_position = -1;
+    double max_infeasibility = 0;
+    for (int pos = 0; pos < num_rows; ++pos) {
+        int var = basic_variables[pos];
+        double value = values[var];
+        double lower = working_lower_bounds[var];
+        double upper = working_upper_bounds[var];
+        double infeasibility = 0;
+        if (value < lower - get_tolerance(PRIMAL_TOLERANCE, lower)) {
+            infeasibility = lower - value;
+        } else if (value > upper + get_tolerance(PRIMAL_TOLERANCE, upper)) {
+            infeasibility = value - upper;
+        }
+        if (use_blands_rule) {
+            if (infeasibility > 0 &&
+                (best_position == -1 || var < basic_variables[best_position])) {
+                best_position = pos;
+            }
+        } else if (infeasibility > max_infeasibility) {
+            max_infeasibility = infeasibility;
+            best_position = pos;
+        }
+    }
+    return best_position;
+}
+
+void NativeLPSolver::compute_pivot_row(int position) {
+    // Compute row "position" of B^{-1} [A -I].
+    int num_rows = get_num_rows();
+    pivot_row.assign(get_num_all_variables(), 0);
+    const double *inverse_row = &basis_inverse[position * num_rows];
+    for (int row = 0; row < num_rows; ++row) {
+        double factor = inverse_row[row];
+        if (factor != 0) {
+            for (const MatrixEntry &entry : rows[row]) {
+                pivot_row[entry.index] += factor * entry.value;
+            }
+            pivot_row[num_structural_variables + row] = -factor;
+        }
+    }
+}
+
+int NativeLPSolver::choose_entering_variable(
+    double infeasibility, bool use_blands_rule) const {
+    /*
+      Harris ratio test: in the first pass, compute the largest dual step
+      that keeps all reduced costs dual feasible within the tolerance. In the
+      second pass, choose the variable with the largest pivot element among
+      all variables whose ratio does not exceed this step.
+
+      With Bland's rule, we use the textbook ratio test instead and choose
+      the variable with the smallest index among all variables with the
+      smallest ratio. Together with the leaving variable chosen by Bland's
+      rule, this prevents cycling.
+    */
+    int num_variables = get_num_all_variables();
+    double direction = infeasibility > 0 ? 1 : -1;
+    auto get_pivot = [&](int var) {
+            if (statuses[var] == VariableStatus::BASIC ||
+                working_lower_bounds[var] == working_upper_bounds[var]) {
+                return 0.0;
+            }
+            double pivot = direction * pivot_row[var];
+            if ((statuses[var] == VariableStatus::AT_LOWER && pivot > PIVOT_TOLERANCE) ||
+                (statuses[var] == VariableStatus::AT_UPPER && pivot < -PIVOT_TOLERANCE) ||
+                (statuses[var] == VariableStatus::AT_ZERO && abs(pivot) > PIVOT_TOLERANCE)) {
+                return abs(pivot);
+            }
+            return 0.0;
+        };
+    auto get_slack = [&](int var) {
+            double reduced_cost = reduced_costs[var];
+            if (statuses[var] == VariableStatus::AT_LOWER) {
+                return max(reduced_cost, 0.0);
+            } else if (statuses[var] == VariableStatus::AT_UPPER) {
+                return max(-reduced_cost, 0.0);
+            }
+            return abs(reduced_cost);
+        };
+
+    if (use_blands_rule) {
+        int entering = -1;
+        double min_ratio = INFINITE_BOUND;
+        for (int var = 0; var < num_variables; ++var) {
+            double pivot = get_pivot(var);
+            if (pivot != 0 && get_slack(var) / pivot < min_ratio) {
+                entering = var;
+                min_ratio = get_slack(var) / pivot;
+            }
+        }
+        return entering;
+    }
+
+    double max_step = INFINITE_BOUND;
+    for (int var = 0; var < num_variables; ++var) {
+        double pivot = get_pivot(var);
+        if (pivot != 0) {
+            max_step = min(max_step, (get_slack(var) + DUAL_TOLERANCE) / pivot);
+        }
+    }
+
+    int entering = -1;
+    double best_pivot = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        double pivot = get_pivot(var);
+        if (pivot > best_pivot && get_slack(var) / pivot <= max_step) {
+            entering = var;
+            best_pivot = pivot;
+        }
+    }
+    return entering;
+}
+
+NativeLPSolver::SolveStatus NativeLPSolver::run_dual_simplex() {
+    int num_rows = get_num_rows();
+    int num_degenerate_pivots = 0;
+    while (true) {
+        if (num_updates_since_factorization >= REFACTORIZATION_INTERVAL) {
+            factorize();
+            compute_reduced_costs();
+            set_nonbasic_statuses();
+            compute_values();
+        }
+
+        bool use_blands_rule = num_degenerate_pivots >= MAX_DEGENERATE_PIVOTS;
+        int position = choose_leaving_position(use_blands_rule);
+        if (position == -1) {
+            return SolveStatus::OPTIMAL;
+        }
+        int leaving = basic_variables[position];
+        bool leaves_at_lower = values[leaving] < working_lower_bounds[leaving];
+        double target = leaves_at_lower ?
+            working_lower_bounds[leaving] : working_upper_bounds[leaving];
+        double infeasibility = values[leaving] - target;
+
+        compute_pivot_row(position);
+        int entering = choose_entering_variable(infeasibility, use_blands_rule);
+        if (entering == -1) {
+            if (num_updates_since_factorization > 0) {
+                // Make sure that infeasibility is not caused by numerical errors.
+                num_updates_since_factorization = REFACTORIZATION_INTERVAL;
+                continue;
+            }
+            if (artificial_bound < MAX_ARTIFICIAL_BOUND &&
+                is_blocked_by_artificial_bound(leaving, leaves_at_lower)) {
+                artificial_bound *= 1000;
+                compute_reduced_costs();
+                set_nonbasic_statuses();
+                compute_values();
+                continue;
+            }
+            return SolveStatus::INFEASIBLE;
+        }
+        compute_column(entering, pivot_column);
+        double pivot = pivot_column[position];
+        if (abs(pivot - pivot_row[entering]) > 1e-6 * (1 + abs(pivot)) &&
+            num_updates_since_factorization > 0) {
+            // The basis inverse has become inaccurate.
+            num_updates_since_factorization = REFACTORIZATION_INTERVAL;
+            continue;
+        }
+
+        double primal_step = infeasibility / pivot;
+        for (int pos = 0; pos < num_rows; ++pos) {
+            values[basic_variables[pos]] -= primal_step * pivot_column[pos];
+        }
+        values[entering] += primal_step;
+        values[leaving] = target;
+
+        double dual_step = reduced_costs[entering] / pivot;
+        if (abs(reduced_costs[entering]) <= DUAL_TOLERANCE) {
+            ++num_degenerate_pivots;
+        } else {
+            num_degenerate_pivots = 0;
+        }
+        int num_variables = get_num_all_variables();
+        for (int var = 0; var < num_variables; ++var) {
+            if (statuses[var] != VariableStatus::BASIC) {
+                reduced_costs[var] -= dual_step * pivot_row[var];
+            }
+        }
+        reduced_costs[entering] = 0;
+        reduced_costs[leaving] = -dual_step;
+
+        statuses[leaving] = leaves_at_lower ?
+            VariableStatus::AT_LOWER : VariableStatus::AT_UPPER;
+        statuses[entering] = VariableStatus::BASIC;
+        basic_variables[position] = entering;
+        pivot_basis_inverse(position, pivot_column);
+        ++num_iterations;
+    }
+}
+
+void NativeLPSolver::load_problem(
+    LPObjectiveSense sense,
+    const vector<LPVariable> &variables,
+    const vector<LPConstraint> &constraints) {
+    int num_variables = variables.size();
+    int num_rows = constraints.size();
+    // Keep the basis for warm-starting if the problem has the same shape.
+    bool keep_basis = num_variables == num_structural_variables &&
+        num_rows == get_num_rows() && num_rows == num_permanent_rows;
+
+    num_structural_variables = num_variables;
+    num_permanent_rows = num_rows;
+    objective_sign = (sense == LPObjectiveSense::MINIMIZE) ? 1 : -1;
+    objective.clear();
+    lower_bounds.clear();
+    upper_bounds.clear();
+    for (const LPVariable &var : variables) {
+        objective.push_back(var.objective_coefficient);
+        lower_bounds.push_back(normalize_bound(var.lower_bound));
+        upper_bounds.push_back(normalize_bound(var.upper_bound));
+    }
+    rows.assign(num_rows, vector<MatrixEntry>());
+    columns.assign(num_variables, vector<MatrixEntry>());
+    for (int row = 0; row < num_rows; ++row) {
+        const LPConstraint &constraint = constraints[row];
+        const vector<int> &vars = constraint.get_variables();
+        const vector<double> &coefficients = constraint.get_coefficients();
+        for (size_t i = 0; i < vars.size(); ++i) {
+            if (coefficients[i] != 0) {
+                rows[row].emplace_back(vars[i], coefficients[i]);
+                columns[vars[i]].emplace_back(row, coefficients[i]);
+            }
+        }
+        lower_bounds.push_back(normalize_bound(constraint.get_lower_bound()));
+        upper_bounds.push_back(normalize_bound(constraint.get_upper_bound()));
+    }
+
+    int num_all_variables = get_num_all_variables();
+    working_lower_bounds.resize(num_all_variables);
+    working_upper_bounds.resize(num_all_variables);
+    values.assign(num_all_variables, 0);
+    reduced_costs.assign(num_all_variables, 0);
+    if (!keep_basis) {
+        reset_basis();
+    }
+    // The constraint matrix has changed, so the basis has to be refactored.
+    basis_is_factored = false;
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::add_temporary_constraints(const vector<LPConstraint> &constraints) {
+    int old_num_rows = get_num_rows();
+    int num_structurals = num_structural_variables;
+    for (const LPConstraint &constraint : constraints) {
+        int row = rows.size();
+        rows.emplace_back();
+        const vector<int> &vars = constraint.get_variables();
+        const vector<double> &coefficients = constraint.get_coefficients();
+        double activity = 0;
+        for (size_t i = 0; i < vars.size(); ++i) {
+            if (coefficients[i] != 0) {
+                rows[row].emplace_back(vars[i], coefficients[i]);
+                columns[vars[i]].emplace_back(row, coefficients[i]);
+                activity += coefficients[i] * values[vars[i]];
+            }
+        }
+        lower_bounds.push_back(normalize_bound(constraint.get_lower_bound()));
+        upper_bounds.push_back(normalize_bound(constraint.get_upper_bound()));
+        working_lower_bounds.push_back(lower_bounds.back());
+        working_upper_bounds.push_back(upper_bounds.back());
+        statuses.push_back(VariableStatus::BASIC);
+        values.push_back(activity);
+        reduced_costs.push_back(0);
+        basic_variables.push_back(num_structurals + row);
+    }
+
+    if (basis_is_factored) {
+        /*
+          With the logical variables of the new rows R in the basis, the new
+          basis matrix is [[B, 0], [R_B, -I]] with the inverse
+          [[B^{-1}, 0], [R_B B^{-1}, -I]].
+        */
+        int num_rows = get_num_rows();
+        vector<int> position_of_structural(num_structurals, -1);
+        for (int pos = 0; pos < old_num_rows; ++pos) {
+            int var = basic_variables[pos];
+            if (var < num_structurals) {
+                position_of_structural[var] = pos;
+            }
+        }
+        vector<double> new_inverse(num_rows * num_rows, 0);
+        for (int pos = 0; pos < old_num_rows; ++pos) {
+            copy(basis_inverse.begin() + pos * old_num_rows,
+                 basis_inverse.begin() + (pos + 1) * old_num_rows,
+                 new_inverse.begin() + pos * num_rows);
+        }
+        for (int row = old_num_rows; row < num_rows; ++row) {
+            double *inverse_row = &new_inverse[row * num_rows];
+            for (const MatrixEntry &entry : rows[row]) {
+                int pos = position_of_structural[entry.index];
+                if (pos != -1) {
+                    const double *old_inverse_row = &basis_inverse[pos * old_num_rows];
+                    for (int i = 0; i < old_num_rows; ++i) {
+                        inverse_row[i] += entry.value * old_inverse_row[i];
+                    }
+                }
+            }
+            inverse_row[row] = -1;
+        }
+        basis_inverse.swap(new_inverse);
+    }
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::clear_temporary_constraints() {
+    int old_num_rows = get_num_rows();
+    int num_rows = num_permanent_rows;
+    if (old_num_rows == num_rows) {
+        return;
+    }
+    int num_structurals = num_structural_variables;
+    int num_variables = num_structurals + num_rows;
+
+    bool temporary_logicals_are_basic = true;
+    for (int var = num_variables; var < num_structurals + old_num_rows; ++var) {
+        if (statuses[var] != VariableStatus::BASIC) {
+            temporary_logicals_are_basic = false;
+            break;
+        }
+    }
+    vector<int> new_basic_variables;
+    new_basic_variables.reserve(old_num_rows);
+    vector<double> new_inverse;
+    if (basis_is_factored && temporary_logicals_are_basic) {
+        /*
+          If all logical variables of the temporary rows are basic, the
+          inverse of the remaining basis is the part of the current inverse
+          that belongs to the permanent rows and the remaining positions.
+        */
+        new_inverse.reserve(num_rows * num_rows);
+        for (int pos = 0; pos < old_num_rows; ++pos) {
+            int var = basic_variables[pos];
+            if (var < num_variables) {
+                new_basic_variables.push_back(var);
+                auto inverse_row = basis_inverse.begin() + pos * old_num_rows;
+                new_inverse.insert(new_inverse.end(), inverse_row, inverse_row + num_rows);
+            }
+        }
+        assert(static_cast<int>(new_basic_variables.size()) == num_rows);
+    } else {
+        for (int var : basic_variables) {
+            if (var < num_variables) {
+                new_basic_variables.push_back(var);
+            }
+        }
+        basis_is_factored = false;
+    }
+    basic_variables.swap(new_basic_variables);
+    basis_inverse.swap(new_inverse);
+
+    for (int row = old_num_rows - 1; row >= num_rows; --row) {
+        for (const MatrixEntry &entry : rows[row]) {
+            assert(columns[entry.index].back().index == row);
+            columns[entry.index].pop_back();
+        }
+    }
+    rows.resize(num_rows);
+    lower_bounds.resize(num_variables);
+    upper_bounds.resize(num_variables);
+    working_lower_bounds.resize(num_variables);
+    working_upper_bounds.resize(num_variables);
+    statuses.resize(num_variables);
+    values.resize(num_variables);
+    reduced_costs.resize(num_variables);
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::set_objective_coefficient(int index, double coefficient) {
+    assert(index < num_structural_variables);
+    objective[index] = coefficient;
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::set_constraint_lower_bound(int index, double bound) {
+    assert(index < get_num_rows());
+    lower_bounds[num_structural_variables + index] = normalize_bound(bound);
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::set_constraint_upper_bound(int index, double bound) {
+    assert(index < get_num_rows());
+    upper_bounds[num_structural_variables + index] = normalize_bound(bound);
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::set_variable_lower_bound(int index, double bound) {
+    assert(index < num_structural_variables);
+    lower_bounds[index] = normalize_bound(bound);
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::set_variable_upper_bound(int index, double bound) {
+    assert(index < num_structural_variables);
+    upper_bounds[index] = normalize_bound(bound);
+    solve_status = SolveStatus::UNSOLVED;
+}
+
+void NativeLPSolver::solve() {
+    ++num_solves;
+    int num_variables = get_num_all_variables();
+    for (int var = 0; var < num_variables; ++var) {
+        if (lower_bounds[var] > upper_bounds[var] +
+            get_tolerance(PRIMAL_TOLERANCE, upper_bounds[var])) {
+            solve_status = SolveStatus::INFEASIBLE;
+            return;
+        }
+    }
+
+    if (!basis_is_factored) {
+        factorize();
+    }
+    artificial_bound = INITIAL_ARTIFICIAL_BOUND;
+    while (true) {
+        compute_reduced_costs();
+        set_nonbasic_statuses();
+        compute_values();
+        solve_status = run_dual_simplex();
+        if (solve_status != SolveStatus::OPTIMAL) {
+            return;
+        }
+
+        /*
+          Variables at an artificial bound with a reduced cost of zero do not
+          influence the objective value, so the solution is optimal. If the
+          reduced cost is not zero, the artificial bound limits the objective
+          value and we have to try again with a larger bound.
+        */
+        bool needs_larger_bound = false;
+        for (int var = 0; var < num_variables; ++var) {
+            if (is_at_artificial_bound(var) &&
+                abs(reduced_costs[var]) > DUAL_TOLERANCE) {
+                needs_larger_bound = true;
+                break;
+            }
+        }
+        if (!needs_larger_bound) {
+            return;
+        }
+        if (artificial_bound >= MAX_ARTIFICIAL_BOUND) {
+            solve_status = SolveStatus::UNBOUNDED;
+            return;
+        }
+        artificial_bound *= 1000;
+    }
+}
+
+bool NativeLPSolver::has_optimal_solution() const {
+    return solve_status == SolveStatus::OPTIMAL;
+}
+
+double NativeLPSolver::get_objective_value() const {
+    assert(has_optimal_solution());
+    double value = 0;
+    for (int var = 0; var < num_structural_variables; ++var) {
+        value += objective[var] * values[var];
+    }
+    return value;
+}
+
+vector<double> NativeLPSolver::extract_solution() const {
+    assert(has_optimal_solution());
+    return vector<double>(values.begin(), values.begin() + num_structural_variables);
+}
+
+int NativeLPSolver::get_num_variables() const {
+    return num_structural_variables;
+}
+
+int NativeLPSolver::get_num_constraints() const {
+    return get_num_rows();
+}
+
+bool NativeLPSolver::has_temporary_constraints() const {
+    return get_num_rows() > num_permanent_rows;
+}
+
+void NativeLPSolver::print_statistics() const {
+    cout << "LP solves: " << num_solves << endl;
+    cout << "LP simplex iterations: " << num_iterations << endl;
+}
+}
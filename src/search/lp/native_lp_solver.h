@@ -0,0 +1,154 @@
+#ifndef LP_NATIVE_LP_SOLVER_H
+#define LP_NATIVE_LP_SOLVER_H
+
+#include <vector>
+
+namespace lp {
+class LPConstraint;
+enum class LPObjectiveSense;
+struct LPVariable;
+
+/*
+  Built-in LP solver that does not depend on an external library.
+
+  The solver implements the bounded dual simplex method. Every constraint
+  l_i <= a_i x <= u_i gets a logical variable r_i = a_i x with bounds
+  [l_i, u_i], so the problem becomes min c x s.t. Ax - r = 0 with bounds on
+  all variables. The constraint matrix is stored sparsely (both by rows and
+  by columns) while the basis inverse is stored as a dense matrix. It is
+  updated after every pivot and recomputed from scratch periodically to
+  limit the accumulation of numerical errors. The dense basis inverse makes
+  the solver suitable for LPs with up to a few thousand constraints. For
+  larger LPs, an external solver should be used.
+
+  The main purpose of the solver is resolving similar LPs quickly, e.g.,
+  when only bounds or objective coefficients change between the states
+  evaluated by a heuristic. The final basis of a solve is used as the
+  starting basis of the next solve. Changing bounds and objective
+  coefficients keeps the basis, temporary constraints are added with their
+  logical variables in the basis and removing them again keeps as much of
+  the basis as possible.
+
+  The dual simplex method requires a dual feasible starting basis. If a
+  nonbasic variable has no finite bound on the side required by the sign of
+  its reduced cost, we give it an artificial bound. If a variable at an
+  artificial bound has a nonzero reduced cost in the final solution, we
+  solve again with a larger artificial bound and report the LP as unbounded
+  if this still happens with the largest artificial bound. Likewise, we
+  only report the LP as infeasible if the infeasibility does not depend on
+  an artificial bound smaller than the largest one.
+
+  To avoid cycling on degenerate LPs, we switch to Bland's rule after a
+  number of consecutive pivots that do not change the objective value.
+  There is no iteration limit, so every solve ends with an optimal
+  solution or a proof of infeasibility or unboundedness.
+*/
+class NativeLPSolver {
+    enum class VariableStatus {
+        BASIC, AT_LOWER, AT_UPPER, AT_ZERO
+    };
+
+    enum class SolveStatus {
+        UNSOLVED, OPTIMAL, INFEASIBLE, UNBOUNDED
+    };
+
+    struct MatrixEntry {
+        int index;
+        double value;
+
+        MatrixEntry(int index, double value)
+            : index(index), value(value) {
+        }
+    };
+
+    /*
+      Variables 0, ..., n-1 are the structural variables of the LP, variables
+      n, ..., n+m-1 are the logical variables of the m constraints.
+    */
+    int num_structural_variables;
+    int num_permanent_rows;
+    // 1 for minimization, -1 for maximization.
+    double objective_sign;
+    std::vector<double> objective;
+    // Bounds of all variables as specified by the user.
+    std::vector<double> lower_bounds;
+    std::vector<double> upper_bounds;
+    // Entries (column, coefficient) of the constraint matrix for each row.
+    std::vector<std::vector<MatrixEntry>> rows;
+    // Entries (row, coefficient) of the constraint matrix for each column.
+    std::vector<std::vector<MatrixEntry>> columns;
+
+    /*
+      Bounds used during the simplex iterations, which include artificial
+      bounds for variables without a finite bound in the required direction.
+    */
+    std::vector<double> working_lower_bounds;
+    std::vector<double> working_upper_bounds;
+    double artificial_bound;
+
+    std::vector<VariableStatus> statuses;
+    // The basic variable at each basis position.
+    std::vector<int> basic_variables;
+    // Dense inverse of the basis matrix (row-major, one row per position).
+    std::vector<double> basis_inverse;
+    bool basis_is_factored;
+    int num_updates_since_factorization;
+
+    std::vector<double> values;
+    std::vector<double> reduced_costs;
+    // Scratch space for the pivot row and column.
+    std::vector<double> pivot_row;
+    std::vector<double> pivot_column;
+
+    SolveStatus solve_status;
+    long long num_iterations;
+    int num_solves;
+
+    int get_num_rows() const;
+    int get_num_all_variables() const;
+    double get_cost(int var) const;
+
+    void reset_basis();
+    void pivot_basis_inverse(int position, const std::vector<double> &column);
+    void compute_column(int var, std::vector<double> &column) const;
+    void factorize();
+
+    void set_nonbasic_statuses();
+    void compute_values();
+    void compute_reduced_costs();
+    bool is_at_artificial_bound(int var) const;
+    bool is_blocked_by_artificial_bound(int leaving, bool leaves_at_lower) const;
+
+    int choose_leaving_position(bool use_blands_rule) const;
+    void compute_pivot_row(int position);
+    int choose_entering_variable(double infeasibility, bool use_blands_rule) const;
+    SolveStatus run_dual_simplex();
+public:
+    NativeLPSolver();
+
+    void load_problem(
+        LPObjectiveSense sense,
+        const std::vector<LPVariable> &variables,
+        const std::vector<LPConstraint> &constraints);
+    void add_temporary_constraints(const std::vector<LPConstraint> &constraints);
+    void clear_temporary_constraints();
+
+    void set_objective_coefficient(int index, double coefficient);
+    void set_constraint_lower_bound(int index, double bound);
+    void set_constraint_upper_bound(int index, double bound);
+    void set_variable_lower_bound(int index, double bound);
+    void set_variable_upper_bound(int index, double bound);
+
+    void solve();
+    bool has_optimal_solution() const;
+    double get_objective_value() const;
+    std::vector<double> extract_solution() const;
+
+    int get_num_variables() const;
+    int get_num_constraints() const;
+    bool has_temporary_constraints() const;
+    void print_statistics() const;
+};
+}
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "../utils/collections.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -42,7 +43,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(
     vector<unique_ptr<Distances>> &&distances,
     const bool compute_init_distances,
     const bool compute_goal_distances,
-    Verbosity verbosity)
+    Verbosity verbosity,
+    int num_threads)
     : labels(move(labels)),
       transition_systems(move(transition_systems)),
       mas_representations(move(mas_representations)),
@@ -50,11 +52,25 @@ FactoredTransitionSystem::FactoredTransitionSystem(
       compute_init_distances(compute_init_distances),
       compute_goal_distances(compute_goal_distances),
       num_active_entries(this->transition_systems.size()) {
-    for (size_t index = 0; index < this->transition_systems.size(); ++index) {
-        if (compute_init_distances || compute_goal_distances) {
-            this->distances[index]->compute_distances(
-                compute_init_distances, compute_goal_distances, verbosity);
-        }
+    /*
+      The distances of the atomic factors are independent of each other, so
+      we compute them concurrently. To avoid interleaved output, this is done
+      silently when using more than one thread.
+    */
+    int num_factors = this->transition_systems.size();
+    if (compute_init_distances || compute_goal_distances) {
+        Verbosity distances_verbosity =
+            utils::get_num_used_threads(num_threads, num_factors) > 1 ?
+            Verbosity::SILENT : verbosity;
+        utils::parallel_for(
+            num_threads, num_factors,
+            [&](int, int index) {
+                this->distances[index]->compute_distances(
+                    compute_init_distances, compute_goal_distances,
+                    distances_verbosity);
+            });
+    }
+    for (int index = 0; index < num_factors; ++index) {
         assert(is_component_valid(index));
     }
 }
@@ -90,7 +90,8 @@ public:
     FactoredTransitionSystem create(
         bool compute_init_distances,
         bool compute_goal_distances,
-        Verbosity verbosity);
+        Verbosity verbosity,
+        int num_threads);
 };
 
 
@@ -379,11 +380,25 @@ vector<unique_ptr<TransitionSystem>> FTSFactory::create_transition_systems(const
         ts_data.label_equivalence_relation =
             utils::make_unique_ptr<LabelEquivalenceRelation>(
                 labels, ts_data.label_groups);
+        /* Store the transitions of all groups in a single buffer, as
+           expected by TransitionSystem. */
+        vector<Transition> transitions;
+        vector<int> group_begin;
+        group_begin.reserve(ts_data.transitions_by_group_id.size() + 1);
+        for (const vector<Transition> &group_transitions :
+             ts_data.transitions_by_group_id) {
+            group_begin.push_back(transitions.size());
+            transitions.insert(transitions.end(),
+                               group_transitions.begin(), group_transitions.end());
+        }
+        group_begin.push_back(transitions.size());
+        utils::release_vector_memory(ts_data.transitions_by_group_id);
         result.push_back(utils::make_unique_ptr<TransitionSystem>(
                              ts_data.num_variables,
                              move(ts_data.incorporated_variables),
                              move(ts_data.label_equivalence_relation),
-                             move(ts_data.transitions_by_group_id),
+                             move(transitions),
+                             move(group_begin),
                              ts_data.num_states,
                              move(ts_data.goal_states),
                              ts_data.init_state
@@ -429,7 +444,8 @@ vector<unique_ptr<Distances>> FTSFactory::create_distances(
 FactoredTransitionSystem FTSFactory::create(
     const bool compute_init_distances,
     const bool compute_goal_distances,
-    Verbosity verbosity) {
+    Verbosity verbosity,
+    int num_threads) {
     if (verbosity >= Verbosity::NORMAL) {
         cout << "Building atomic transition systems... " << endl;
     }
@@ -452,17 +468,20 @@ FactoredTransitionSystem FTSFactory::create(
         move(distances),
         compute_init_distances,
         compute_goal_distances,
-        verbosity);
+        verbosity,
+        num_threads);
 }
 
 FactoredTransitionSystem create_factored_transition_system(
     const TaskProxy &task_proxy,
     const bool compute_init_distances,
     const bool compute_goal_distances,
-    Verbosity verbosity) {
+    Verbosity verbosity,
+    int num_threads) {
     return FTSFactory(task_proxy).create(
         compute_init_distances,
         compute_goal_distances,
-        verbosity);
+        verbosity,
+        num_threads);
 }
 }
@@ -21,6 +21,7 @@
 #include "../utils/countdown_timer.h"
 #include "../utils/markup.h"
 #include "../utils/math.h"
+#include "../utils/parallel_options.h"
 #include "../utils/system.h"
 #include "../utils/timer.h"
 
@@ -52,6 +53,7 @@ MergeAndShrinkAlgorithm::MergeAndShrinkAlgorithm(const Options &opts) :
     prune_irrelevant_states(opts.get<bool>("prune_irrelevant_states")),
     verbosity(static_cast<Verbosity>(opts.get_enum("verbosity"))),
     main_loop_max_time(opts.get<double>("main_loop_max_time")),
+    num_threads(utils::parse_num_threads_from_options(opts)),
     starting_peak_memory(0) {
     assert(max_states_before_merge > 0);
     assert(max_states >= max_states_before_merge);
@@ -105,6 +107,7 @@ void MergeAndShrinkAlgorithm::dump_options() const {
         break;
     }
     cout << endl;
+    cout << "Number of threads: " << num_threads << endl;
 }
 
 void MergeAndShrinkAlgorithm::warn_on_unusual_options() const {
@@ -356,7 +359,8 @@ FactoredTransitionSystem MergeAndShrinkAlgorithm::build_factored_transition_syst
             task_proxy,
             compute_init_distances,
             compute_goal_distances,
-            verbosity);
+            verbosity,
+            num_threads);
     if (verbosity >= Verbosity::NORMAL) {
         log_progress(timer, "after computation of atomic factors");
     }
@@ -471,6 +475,8 @@ void add_merge_and_shrink_algorithm_options_to_parser(OptionParser &parser) {
         "transformation is runtime-intense.",
         "infinity",
         Bounds("0.0", "infinity"));
+
+    utils::add_parallel_options(parser);
 }
 
 void add_transition_system_size_limit_options_to_parser(OptionParser &parser) {
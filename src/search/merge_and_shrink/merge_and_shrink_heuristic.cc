@@ -88,7 +88,7 @@ void MergeAndShrinkHeuristic::finalize(FactoredTransitionSystem &fts) {
 }
 
 int MergeAndShrinkHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     int heuristic = 0;
     for (const unique_ptr<MergeAndShrinkRepresentation> &mas_representation : mas_representations) {
         int cost = mas_representation->get_value(state);
@@ -192,6 +192,16 @@ static shared_ptr<Heuristic> _parse(options::OptionParser &parser) {
         "Note that for versions of Fast Downward prior to 2016-08-19, the "
         "syntax differs. See the recommendation in the file "
         "merge_and_shrink_heuristic.cc for an example configuration.");
+    parser.document_note(
+        "Multithreading",
+        "The option {{{num_threads}}} of {{{merge_and_shrink}}} only affects "
+        "the computation of distances of the atomic factors. The expensive "
+        "parts of the main loop are parallelized by the components that "
+        "perform them, which have their own {{{num_threads}}} options: "
+        "{{{shrink_bisimulation}}} computes and sorts state signatures in "
+        "parallel, and {{{dfp}}} and {{{sf_miasm}}} score merge candidates "
+        "in parallel. All of these produce the same abstraction for every "
+        "number of threads.");
 
     Heuristic::add_options_to_parser(parser);
     add_merge_and_shrink_algorithm_options_to_parser(parser);
@@ -7,15 +7,23 @@
 #include "transition_system.h"
 
 #include "../options/option_parser.h"
+#include "../options/options.h"
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
+#include "../utils/parallel_options.h"
 
 #include <cassert>
+#include <iostream>
 
 using namespace std;
 
 namespace merge_and_shrink {
+MergeScoringFunctionDFP::MergeScoringFunctionDFP(int num_threads)
+    : num_threads(num_threads) {
+}
+
 vector<int> MergeScoringFunctionDFP::compute_label_ranks(
     const FactoredTransitionSystem &fts, int index) const {
     const TransitionSystem &ts = fts.get_transition_system(index);
@@ -27,7 +35,7 @@ vector<int> MergeScoringFunctionDFP::compute_label_ranks(
 
     for (const GroupAndTransitions &gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionRange &transitions = gat.transitions;
         // Relevant labels with no transitions have a rank of infinity.
         int label_rank = INF;
         bool group_relevant = false;
@@ -66,36 +74,50 @@ vector<double> MergeScoringFunctionDFP::compute_scores(
     const vector<pair<int, int>> &merge_candidates) {
     int num_ts = fts.get_size();
 
+    // Compute the label ranks of all transition systems involved.
+    vector<bool> is_candidate_index(num_ts, false);
+    for (pair<int, int> merge_candidate : merge_candidates) {
+        is_candidate_index[merge_candidate.first] = true;
+        is_candidate_index[merge_candidate.second] = true;
+    }
+    vector<int> candidate_indices;
+    for (int index = 0; index < num_ts; ++index) {
+        if (is_candidate_index[index]) {
+            candidate_indices.push_back(index);
+        }
+    }
     vector<vector<int>> transition_system_label_ranks(num_ts);
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
+    utils::parallel_for(
+        num_threads, candidate_indices.size(),
+        [&](int, int i) {
+            int index = candidate_indices[i];
+            transition_system_label_ranks[index] =
+                compute_label_ranks(fts, index);
+        });
 
     // Go over all pairs of transition systems and compute their weight.
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int ts_index1 = merge_candidate.first;
-        int ts_index2 = merge_candidate.second;
-
-        vector<int> &label_ranks1 = transition_system_label_ranks[ts_index1];
-        if (label_ranks1.empty()) {
-            label_ranks1 = compute_label_ranks(fts, ts_index1);
-        }
-        vector<int> &label_ranks2 = transition_system_label_ranks[ts_index2];
-        if (label_ranks2.empty()) {
-            label_ranks2 = compute_label_ranks(fts, ts_index2);
-        }
-        assert(label_ranks1.size() == label_ranks2.size());
-
-        // Compute the weight associated with this pair
-        int pair_weight = INF;
-        for (size_t i = 0; i < label_ranks1.size(); ++i) {
-            if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
-                // label is relevant in both transition_systems
-                int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
-                pair_weight = min(pair_weight, max_label_rank);
+    vector<double> scores(merge_candidates.size());
+    utils::parallel_for(
+        num_threads, merge_candidates.size(),
+        [&](int, int candidate_id) {
+            const pair<int, int> &merge_candidate = merge_candidates[candidate_id];
+            const vector<int> &label_ranks1 =
+                transition_system_label_ranks[merge_candidate.first];
+            const vector<int> &label_ranks2 =
+                transition_system_label_ranks[merge_candidate.second];
+            assert(label_ranks1.size() == label_ranks2.size());
+
+            // Compute the weight associated with this pair
+            int pair_weight = INF;
+            for (size_t i = 0; i < label_ranks1.size(); ++i) {
+                if (label_ranks1[i] != -1 && label_ranks2[i] != -1) {
+                    // label is relevant in both transition_systems
+                    int max_label_rank = max(label_ranks1[i], label_ranks2[i]);
+                    pair_weight = min(pair_weight, max_label_rank);
+                }
             }
-        }
-        scores.push_back(pair_weight);
-    }
+            scores[candidate_id] = pair_weight;
+        });
     return scores;
 }
 
@@ -103,6 +125,10 @@ string MergeScoringFunctionDFP::name() const {
     return "dfp";
 }
 
+void MergeScoringFunctionDFP::dump_function_specific_options() const {
+    cout << "Number of threads: " << num_threads << endl;
+}
+
 static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
     parser.document_synopsis(
         "DFP scoring",
@@ -117,11 +143,14 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
             " Intelligence (AAAI 2014)",
             "2358-2366",
             "AAAI Press 2014"));
+    utils::add_parallel_options(parser);
 
+    options::Options opts = parser.parse();
     if (parser.dry_run())
         return nullptr;
     else
-        return make_shared<MergeScoringFunctionDFP>();
+        return make_shared<MergeScoringFunctionDFP>(
+            utils::parse_num_threads_from_options(opts));
 }
 
 static options::Plugin<MergeScoringFunction> _plugin("dfp", _parse);
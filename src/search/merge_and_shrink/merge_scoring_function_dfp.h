@@ -6,12 +6,15 @@
 namespace merge_and_shrink {
 class TransitionSystem;
 class MergeScoringFunctionDFP : public MergeScoringFunction {
+    const int num_threads;
+
     std::vector<int> compute_label_ranks(
         const FactoredTransitionSystem &fts, int index) const;
 protected:
     virtual std::string name() const override;
+    virtual void dump_function_specific_options() const override;
 public:
-    MergeScoringFunctionDFP() = default;
+    explicit MergeScoringFunctionDFP(int num_threads = 1);
     virtual ~MergeScoringFunctionDFP() override = default;
     virtual std::vector<double> compute_scores(
         const FactoredTransitionSystem &fts,
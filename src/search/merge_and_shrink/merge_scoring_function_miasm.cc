@@ -12,6 +12,10 @@
 #include "../options/plugin.h"
 
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
+#include "../utils/parallel_options.h"
+
+#include <iostream>
 
 using namespace std;
 
@@ -21,50 +25,64 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
     : shrink_strategy(options.get<shared_ptr<ShrinkStrategy>>("shrink_strategy")),
       max_states(options.get<int>("max_states")),
       max_states_before_merge(options.get<int>("max_states_before_merge")),
-      shrink_threshold_before_merge(options.get<int>("threshold_before_merge")) {
+      shrink_threshold_before_merge(options.get<int>("threshold_before_merge")),
+      num_threads(utils::parse_num_threads_from_options(options)) {
 }
 
-vector<double> MergeScoringFunctionMIASM::compute_scores(
+double MergeScoringFunctionMIASM::compute_score(
     const FactoredTransitionSystem &fts,
-    const vector<pair<int, int>> &merge_candidates) {
-    vector<double> scores;
-    scores.reserve(merge_candidates.size());
-    for (pair<int, int> merge_candidate : merge_candidates) {
-        int index1 = merge_candidate.first;
-        int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
-            fts,
-            index1,
-            index2,
-            *shrink_strategy,
-            max_states,
-            max_states_before_merge,
-            shrink_threshold_before_merge);
-
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        const Verbosity verbosity = Verbosity::SILENT;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
-        int num_states = product->get_size();
-        int alive_states_count = 0;
-        for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
-                ++alive_states_count;
-            }
-        }
+    const pair<int, int> &merge_candidate) const {
+    int index1 = merge_candidate.first;
+    int index2 = merge_candidate.second;
+    unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        fts,
+        index1,
+        index2,
+        *shrink_strategy,
+        max_states,
+        max_states_before_merge,
+        shrink_threshold_before_merge);
 
-        /*
-          Compute the score as the ratio of alive states of the product
-          compared to the number of states of the full product.
-        */
-        assert(num_states);
-        double score = static_cast<double>(alive_states_count) /
-            static_cast<double>(num_states);
-        scores.push_back(score);
+    // Compute distances for the product and count the alive states.
+    unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
+    const bool compute_init_distances = true;
+    const bool compute_goal_distances = true;
+    const Verbosity verbosity = Verbosity::SILENT;
+    distances->compute_distances(compute_init_distances, compute_goal_distances, verbosity);
+    int num_states = product->get_size();
+    int alive_states_count = 0;
+    for (int state = 0; state < num_states; ++state) {
+        if (distances->get_init_distance(state) != INF &&
+            distances->get_goal_distance(state) != INF) {
+            ++alive_states_count;
+        }
     }
+
+    /*
+      Compute the score as the ratio of alive states of the product
+      compared to the number of states of the full product.
+    */
+    assert(num_states);
+    return static_cast<double>(alive_states_count) /
+           static_cast<double>(num_states);
+}
+
+vector<double> MergeScoringFunctionMIASM::compute_scores(
+    const FactoredTransitionSystem &fts,
+    const vector<pair<int, int>> &merge_candidates) {
+    /*
+      The products of different candidates are independent, so we can compute
+      them concurrently unless the shrink strategy has internal state (e.g. a
+      random number generator) whose use must happen in a fixed order.
+    */
+    int used_threads = shrink_strategy->is_stateless() ? num_threads : 1;
+    vector<double> scores(merge_candidates.size());
+    utils::parallel_for(
+        used_threads, merge_candidates.size(),
+        [&](int, int candidate_id) {
+            scores[candidate_id] =
+                compute_score(fts, merge_candidates[candidate_id]);
+        });
     return scores;
 }
 
@@ -72,6 +90,10 @@ string MergeScoringFunctionMIASM::name() const {
     return "miasm";
 }
 
+void MergeScoringFunctionMIASM::dump_function_specific_options() const {
+    cout << "Number of threads: " << num_threads << endl;
+}
+
 static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
     parser.document_synopsis(
         "MIASM",
@@ -124,6 +146,7 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
         "We recommend setting this to match the shrink strategy configuration "
         "given to {{{merge_and_shrink}}}, see note below.");
     add_transition_system_size_limit_options_to_parser(parser);
+    utils::add_parallel_options(parser);
 
     options::Options options = parser.parse();
     if (parser.help_mode()) {
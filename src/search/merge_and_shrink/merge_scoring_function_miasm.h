@@ -16,8 +16,14 @@ class MergeScoringFunctionMIASM : public MergeScoringFunction {
     const int max_states;
     const int max_states_before_merge;
     const int shrink_threshold_before_merge;
+    const int num_threads;
+
+    double compute_score(
+        const FactoredTransitionSystem &fts,
+        const std::pair<int, int> &merge_candidate) const;
 protected:
     virtual std::string name() const override;
+    virtual void dump_function_specific_options() const override;
 public:
     explicit MergeScoringFunctionMIASM(const options::Options &options);
     virtual ~MergeScoringFunctionMIASM() override = default;
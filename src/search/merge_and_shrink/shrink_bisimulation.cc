@@ -10,6 +10,8 @@
 
 #include "../utils/collections.h"
 #include "../utils/markup.h"
+#include "../utils/parallel.h"
+#include "../utils/parallel_options.h"
 #include "../utils/system.h"
 
 #include <algorithm>
@@ -95,7 +97,8 @@ struct Signature {
 
 ShrinkBisimulation::ShrinkBisimulation(const Options &opts)
     : greedy(opts.get<bool>("greedy")),
-      at_limit(AtLimit(opts.get_enum("at_limit"))) {
+      at_limit(AtLimit(opts.get_enum("at_limit"))),
+      num_threads(utils::parse_num_threads_from_options(opts)) {
 }
 
 int ShrinkBisimulation::initialize_groups(
@@ -185,7 +188,7 @@ void ShrinkBisimulation::compute_signatures(
     */
     for (const GroupAndTransitions &gat : ts) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionRange &transitions = gat.transitions;
         for (const Transition &transition : transitions) {
             assert(signatures[transition.src + 1].state == transition.src);
             bool skip_transition = false;
@@ -224,16 +227,21 @@ void ShrinkBisimulation::compute_signatures(
        4. Two signatures compare equal according to Signature::operator<
           iff we don't want to distinguish their states in the current
           bisimulation round.
+
+       Since operator< is a total order (ties are broken by state), sorting
+       in parallel yields the same order as sorting sequentially.
      */
 
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
-    }
+    utils::parallel_for(
+        num_threads, signatures.size(),
+        [&signatures](int, int i) {
+            SuccessorSignature &succ_sig = signatures[i].succ_signature;
+            ::sort(succ_sig.begin(), succ_sig.end());
+            succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
+                           succ_sig.end());
+        });
 
-    ::sort(signatures.begin(), signatures.end());
+    utils::parallel_sort(num_threads, signatures.begin(), signatures.end());
 }
 
 StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
@@ -372,6 +380,7 @@ void ShrinkBisimulation::dump_strategy_specific_options() const {
         ABORT("Unknown setting for at_limit.");
     }
     cout << endl;
+    cout << "Number of threads: " << num_threads << endl;
 }
 
 static shared_ptr<ShrinkStrategy>_parse(OptionParser &parser) {
@@ -417,6 +426,7 @@ static shared_ptr<ShrinkStrategy>_parse(OptionParser &parser) {
     parser.add_enum_option(
         "at_limit", at_limit,
         "what to do when the size limit is hit", "RETURN");
+    utils::add_parallel_options(parser);
 
     Options opts = parser.parse();
 
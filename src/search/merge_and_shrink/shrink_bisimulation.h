@@ -18,6 +18,7 @@ class ShrinkBisimulation : public ShrinkStrategy {
 
     const bool greedy;
     const AtLimit at_limit;
+    const int num_threads;
 
     void compute_abstraction(
         const TransitionSystem &ts,
@@ -56,6 +56,11 @@ public:
         const TransitionSystem &ts,
         const Distances &distances,
         int target_size) const override;
+
+    virtual bool is_stateless() const override {
+        return false;
+    }
+
     static void add_options_to_parser(options::OptionParser &parser);
 };
 }
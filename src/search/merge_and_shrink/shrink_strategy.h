@@ -39,6 +39,15 @@ public:
     virtual bool requires_init_distances() const = 0;
     virtual bool requires_goal_distances() const = 0;
 
+    /*
+      Return true iff compute_equivalence_relation does not change any
+      internal state such as a random number generator. Only then may it be
+      called concurrently without affecting the result.
+    */
+    virtual bool is_stateless() const {
+        return true;
+    }
+
     void dump_options() const;
     std::string get_name() const;
 };
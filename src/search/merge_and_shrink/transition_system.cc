@@ -12,7 +12,7 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
-#include <set>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -27,18 +27,63 @@ ostream &operator<<(ostream &os, const Transition &trans) {
     return os;
 }
 
-// Sorts the given set of transitions and removes duplicates.
-static void normalize_given_transitions(vector<Transition> &transitions) {
-    sort(transitions.begin(), transitions.end());
-    transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
+/*
+  Stable counting sort of the transitions in [begin, end) into out by the
+  given key, which must lie in [0, num_keys).
+*/
+template<typename GetKey>
+static void counting_sort_transitions(
+    const Transition *begin, const Transition *end, Transition *out,
+    int num_keys, vector<int> &counts, GetKey get_key) {
+    counts.assign(num_keys + 1, 0);
+    for (const Transition *it = begin; it != end; ++it) {
+        ++counts[get_key(*it) + 1];
+    }
+    for (int key = 0; key < num_keys; ++key) {
+        counts[key + 1] += counts[key];
+    }
+    for (const Transition *it = begin; it != end; ++it) {
+        out[counts[get_key(*it)]++] = *it;
+    }
+}
+
+/*
+  Sort the transitions in [begin, end) and remove duplicates. Return the new
+  end of the range. Ranges that are large compared to the number of states
+  are sorted with a radix sort (by target, then by source) and all others
+  with std::sort.
+*/
+static Transition *normalize_transitions(
+    Transition *begin, Transition *end, int num_states,
+    vector<Transition> &scratch, vector<int> &counts) {
+    int num_transitions = end - begin;
+    if (num_transitions >= num_states) {
+        scratch.resize(num_transitions, Transition(0, 0));
+        counting_sort_transitions(
+            begin, end, scratch.data(), num_states, counts,
+            [](const Transition &transition) {return transition.target;});
+        counting_sort_transitions(
+            scratch.data(), scratch.data() + num_transitions, begin,
+            num_states, counts,
+            [](const Transition &transition) {return transition.src;});
+    } else {
+        sort(begin, end);
+    }
+    return unique(begin, end);
+}
+
+bool TransitionRange::operator==(const TransitionRange &other) const {
+    return size() == other.size() && equal(begin(), end(), other.begin());
 }
 
 TSConstIterator::TSConstIterator(
     const LabelEquivalenceRelation &label_equivalence_relation,
-    const vector<vector<Transition>> &transitions_by_group_id,
+    const vector<Transition> &transitions,
+    const vector<int> &group_begin,
     bool end)
     : label_equivalence_relation(label_equivalence_relation),
-      transitions_by_group_id(transitions_by_group_id),
+      transitions(transitions),
+      group_begin(group_begin),
       current_group_id((end ? label_equivalence_relation.get_size() : 0)) {
     next_valid_index();
 }
@@ -56,9 +101,11 @@ void TSConstIterator::operator++() {
 }
 
 GroupAndTransitions TSConstIterator::operator*() const {
+    const Transition *data = transitions.data();
     return GroupAndTransitions(
         label_equivalence_relation.get_group(current_group_id),
-        transitions_by_group_id[current_group_id]);
+        TransitionRange(data + group_begin[current_group_id],
+                        data + group_begin[current_group_id + 1]));
 }
 
 
@@ -81,14 +128,16 @@ TransitionSystem::TransitionSystem(
     int num_variables,
     vector<int> &&incorporated_variables,
     unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
-    vector<vector<Transition>> &&transitions_by_group_id,
+    vector<Transition> &&transitions,
+    vector<int> &&group_begin,
     int num_states,
     vector<bool> &&goal_states,
     int init_state)
     : num_variables(num_variables),
       incorporated_variables(move(incorporated_variables)),
       label_equivalence_relation(move(label_equivalence_relation)),
-      transitions_by_group_id(move(transitions_by_group_id)),
+      transitions(move(transitions)),
+      group_begin(move(group_begin)),
       num_states(num_states),
       goal_states(move(goal_states)),
       init_state(init_state) {
@@ -102,7 +151,8 @@ TransitionSystem::TransitionSystem(const TransitionSystem &other)
       label_equivalence_relation(
           utils::make_unique_ptr<LabelEquivalenceRelation>(
               *other.label_equivalence_relation)),
-      transitions_by_group_id(other.transitions_by_group_id),
+      transitions(other.transitions),
+      group_begin(other.group_begin),
       num_states(other.num_states),
       goal_states(other.goal_states),
       init_state(other.init_state) {
@@ -131,8 +181,6 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         ts2.incorporated_variables.begin(), ts2.incorporated_variables.end(),
         back_inserter(incorporated_variables));
     vector<vector<int>> label_groups;
-    vector<vector<Transition>> transitions_by_group_id;
-    transitions_by_group_id.reserve(labels.get_max_size());
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -159,12 +207,22 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
       (B) they are both dead in T (e.g., this includes the case where
           l is dead in T1 only and l' is dead in T2 only, so they are not
           locally equivalent in either of the components).
+
+      We first compute the new label groups together with the pair of
+      component groups whose transitions they combine. This tells us the
+      exact number of transitions of the product before creating them.
     */
-    int multiplier = ts2_size;
+    vector<pair<int, int>> component_group_ids;
     vector<int> dead_labels;
-    for (const GroupAndTransitions &gat : ts1) {
-        const LabelGroup &group1 = gat.label_group;
-        const vector<Transition> &transitions1 = gat.transitions;
+    size_t num_transitions = 0;
+    const LabelEquivalenceRelation &relation1 = *ts1.label_equivalence_relation;
+    for (int group1_id = 0; group1_id < relation1.get_size(); ++group1_id) {
+        if (relation1.is_empty_group(group1_id)) {
+            continue;
+        }
+        const LabelGroup &group1 = relation1.get_group(group1_id);
+        size_t num_transitions1 =
+            ts1.get_transitions_for_group_id(group1_id).size();
 
         // Distribute the labels of this group among the "buckets"
         // corresponding to the groups of ts2.
@@ -176,38 +234,66 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         // Now buckets contains all equivalence classes that are
         // refinements of group1.
 
-        // Now create the new groups together with their transitions.
+        // Now create the new groups if their transitions are not empty.
         for (auto &bucket : buckets) {
-            const vector<Transition> &transitions2 =
-                ts2.get_transitions_for_group_id(bucket.first);
-
-            // Create the new transitions for this bucket
-            vector<Transition> new_transitions;
-            if (!transitions1.empty() && !transitions2.empty()
-                && transitions1.size() > new_transitions.max_size() / transitions2.size())
-                utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
-            new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
-                    int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.push_back(Transition(src, target));
-                }
-            }
-
-            // Create a new group if the transitions are not empty
+            size_t num_transitions2 =
+                ts2.get_transitions_for_group_id(bucket.first).size();
             vector<int> &new_labels = bucket.second;
-            if (new_transitions.empty()) {
+            if (num_transitions1 == 0 || num_transitions2 == 0) {
                 dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
             } else {
-                sort(new_transitions.begin(), new_transitions.end());
+                if (num_transitions1 > (numeric_limits<size_t>::max() -
+                                        num_transitions) / num_transitions2)
+                    utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+                num_transitions += num_transitions1 * num_transitions2;
                 label_groups.push_back(move(new_labels));
-                transitions_by_group_id.push_back(move(new_transitions));
+                component_group_ids.emplace_back(group1_id, bucket.first);
+            }
+        }
+    }
+    if (num_transitions > static_cast<size_t>(numeric_limits<int>::max()))
+        utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+
+    /*
+      Create the transitions of all new groups in the order of the groups.
+      We enumerate the products of transitions with equal sources in
+      increasing order of both sources and then of both targets. Since the
+      transitions of both components are sorted and unique, the products
+      are sorted and unique as well and do not need to be normalized.
+    */
+    int multiplier = ts2_size;
+    vector<Transition> transitions;
+    transitions.reserve(num_transitions);
+    vector<int> group_begin;
+    group_begin.reserve(label_groups.size() + 2);
+    for (const pair<int, int> &group_ids : component_group_ids) {
+        group_begin.push_back(transitions.size());
+        TransitionRange transitions1 =
+            ts1.get_transitions_for_group_id(group_ids.first);
+        TransitionRange transitions2 =
+            ts2.get_transitions_for_group_id(group_ids.second);
+        const Transition *src_block1_begin = transitions1.begin();
+        while (src_block1_begin != transitions1.end()) {
+            int src1 = src_block1_begin->src;
+            const Transition *src_block1_end = src_block1_begin;
+            while (src_block1_end != transitions1.end() && src_block1_end->src == src1)
+                ++src_block1_end;
+            const Transition *src_block2_begin = transitions2.begin();
+            while (src_block2_begin != transitions2.end()) {
+                int src2 = src_block2_begin->src;
+                const Transition *src_block2_end = src_block2_begin;
+                while (src_block2_end != transitions2.end() && src_block2_end->src == src2)
+                    ++src_block2_end;
+                int src = src1 * multiplier + src2;
+                for (const Transition *t1 = src_block1_begin; t1 != src_block1_end; ++t1) {
+                    for (const Transition *t2 = src_block2_begin; t2 != src_block2_end; ++t2) {
+                        int target = t1->target * multiplier + t2->target;
+                        transitions.emplace_back(src, target);
+                    }
+                }
+                src_block2_begin = src_block2_end;
             }
+            src_block1_begin = src_block1_end;
         }
     }
 
@@ -221,10 +307,12 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
     if (!dead_labels.empty()) {
         label_groups.push_back(move(dead_labels));
         // Dead labels have empty transitions
-        transitions_by_group_id.emplace_back();
+        group_begin.push_back(transitions.size());
     }
+    group_begin.push_back(transitions.size());
 
-    assert(transitions_by_group_id.size() == label_groups.size());
+    assert(group_begin.size() == label_groups.size() + 1);
+    assert(transitions.size() == num_transitions);
 
     unique_ptr<LabelEquivalenceRelation> label_equivalence_relation =
         utils::make_unique_ptr<LabelEquivalenceRelation>(labels, label_groups);
@@ -233,7 +321,8 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         num_variables,
         move(incorporated_variables),
         move(label_equivalence_relation),
-        move(transitions_by_group_id),
+        move(transitions),
+        move(group_begin),
         num_states,
         move(goal_states),
         init_state
@@ -248,20 +337,36 @@ void TransitionSystem::compute_locally_equivalent_labels() {
     for (int group_id1 = 0; group_id1 < label_equivalence_relation->get_size();
          ++group_id1) {
         if (!label_equivalence_relation->is_empty_group(group_id1)) {
-            const vector<Transition> &transitions1 = transitions_by_group_id[group_id1];
+            TransitionRange transitions1 = get_transitions_for_group_id(group_id1);
             for (int group_id2 = group_id1 + 1;
                  group_id2 < label_equivalence_relation->get_size(); ++group_id2) {
                 if (!label_equivalence_relation->is_empty_group(group_id2)) {
-                    vector<Transition> &transitions2 = transitions_by_group_id[group_id2];
-                    if (transitions1 == transitions2) {
+                    if (transitions1 == get_transitions_for_group_id(group_id2)) {
                         label_equivalence_relation->move_group_into_group(
                             group_id2, group_id1);
-                        utils::release_vector_memory(transitions2);
                     }
                 }
             }
         }
     }
+    remove_transitions_of_empty_groups();
+}
+
+void TransitionSystem::remove_transitions_of_empty_groups() {
+    int num_groups = label_equivalence_relation->get_size();
+    int new_end = 0;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        int old_begin = group_begin[group_id];
+        int old_end = group_begin[group_id + 1];
+        group_begin[group_id] = new_end;
+        if (!label_equivalence_relation->is_empty_group(group_id)) {
+            move(transitions.begin() + old_begin, transitions.begin() + old_end,
+                 transitions.begin() + new_end);
+            new_end += old_end - old_begin;
+        }
+    }
+    group_begin[num_groups] = new_end;
+    transitions.erase(transitions.begin() + new_end, transitions.end());
 }
 
 void TransitionSystem::apply_abstraction(
@@ -293,34 +398,47 @@ void TransitionSystem::apply_abstraction(
     }
     goal_states = move(new_goal_states);
 
-    // Update all transitions.
-    for (vector<Transition> &transitions : transitions_by_group_id) {
-        if (!transitions.empty()) {
-            vector<Transition> new_transitions;
-            /*
-              We reserve more memory than necessary here, but this is better
-              than potentially resizing the vector several times when inserting
-              transitions one after the other. See issue604-v6.
-
-              An alternative could be to not use a new vector, but to modify
-              the existing transitions inplace, and to remove all empty
-              positions in the end. This would be more ugly, though.
-            */
-            new_transitions.reserve(transitions.size());
-            for (size_t i = 0; i < transitions.size(); ++i) {
-                const Transition &transition = transitions[i];
-                int src = abstraction_mapping[transition.src];
-                int target = abstraction_mapping[transition.target];
-                if (src != PRUNED_STATE && target != PRUNED_STATE)
-                    new_transitions.push_back(Transition(src, target));
-            }
-            normalize_given_transitions(new_transitions);
-            transitions = move(new_transitions);
+    /*
+      Update all transitions in place. Since the transitions of a group only
+      ever shrink, the new transitions of a group never overwrite old
+      transitions of a later group.
+    */
+    vector<Transition> scratch;
+    vector<int> counts;
+    int num_groups = label_equivalence_relation->get_size();
+    int new_end = 0;
+    for (int group_id = 0; group_id < num_groups; ++group_id) {
+        int old_begin = group_begin[group_id];
+        int old_end = group_begin[group_id + 1];
+        int new_begin = new_end;
+        group_begin[group_id] = new_begin;
+        for (int i = old_begin; i < old_end; ++i) {
+            const Transition &transition = transitions[i];
+            int src = abstraction_mapping[transition.src];
+            int target = abstraction_mapping[transition.target];
+            if (src != PRUNED_STATE && target != PRUNED_STATE)
+                transitions[new_end++] = Transition(src, target);
         }
+        Transition *data = transitions.data();
+        new_end = normalize_transitions(
+            data + new_begin, data + new_end, new_num_states,
+            scratch, counts) - data;
     }
+    group_begin[num_groups] = new_end;
+    transitions.erase(transitions.begin() + new_end, transitions.end());
+    utils::release_vector_memory(scratch);
 
     compute_locally_equivalent_labels();
 
+    /*
+      Release memory if pruning removed a large part of the transitions.
+      This temporarily requires memory for both copies, which is why we
+      avoid it for small reductions.
+    */
+    if (transitions.size() < transitions.capacity() / 2) {
+        transitions.shrink_to_fit();
+    }
+
     num_states = new_num_states;
     init_state = abstraction_mapping[init_state];
     if (verbosity >= Verbosity::VERBOSE && init_state == PRUNED_STATE) {
@@ -378,17 +496,18 @@ void TransitionSystem::apply_label_reduction(
             const vector<int> &old_label_nos = mapping.second;
             assert(old_label_nos.size() >= 2);
             unordered_set<int> seen_group_ids;
-            set<Transition> new_label_transitions;
+            vector<Transition> new_label_transitions;
             for (int old_label_no : old_label_nos) {
                 int group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
-                    const vector<Transition> &transitions = transitions_by_group_id[group_id];
-                    new_label_transitions.insert(transitions.begin(), transitions.end());
+                    TransitionRange transitions = get_transitions_for_group_id(group_id);
+                    new_label_transitions.insert(
+                        new_label_transitions.end(), transitions.begin(), transitions.end());
                 }
             }
-            new_transitions.emplace_back(
-                new_label_transitions.begin(), new_label_transitions.end());
+            utils::sort_unique(new_label_transitions);
+            new_transitions.push_back(move(new_label_transitions));
         }
         assert(label_mapping.size() == new_transitions.size());
 
@@ -402,36 +521,45 @@ void TransitionSystem::apply_label_reduction(
         label_equivalence_relation->apply_label_mapping(label_mapping, &affected_group_ids);
 
         /*
-          Go over the transitions of new labels and add them at the correct
-          position.
+          Rebuild the transition buffer. Groups of new labels receive the
+          collected transitions, other non-empty groups keep their
+          transitions and groups that became empty lose them.
 
-          NOTE: it is important that this happens in increasing order of label
-          numbers to ensure that transitions_by_group_id are synchronized with
-          label groups of label_equivalence_relation.
+          Every new label has its own group, which apply_label_mapping
+          appended after the old groups. Groups that are locally equivalent
+          are only combined afterwards by compute_locally_equivalent_labels.
         */
+        int num_old_groups = group_begin.size() - 1;
+        int num_groups = label_equivalence_relation->get_size();
+        assert(num_groups >= num_old_groups);
+        vector<int> group_to_new_label_index(num_groups, -1);
         for (size_t i = 0; i < label_mapping.size(); ++i) {
             int new_label_no = label_mapping[i].first;
-            vector<Transition> &transitions = new_transitions[i];
             int new_group_id = label_equivalence_relation->get_group_id(new_label_no);
-            if (!utils::in_bounds(new_group_id, transitions_by_group_id)) {
-                /* Labels reduced to new_label_no were not locally equivalent
-                   and hence assigned to a new group. */
-                assert(new_group_id == static_cast<int>(transitions_by_group_id.size()));
-                transitions_by_group_id.push_back(move(transitions));
-            } else {
-                /* Labels reduced to new_label_no were locally equivalent before
-                   and hence the new label is part of the same group. */
-                transitions_by_group_id[new_group_id] = move(transitions);
-            }
+            group_to_new_label_index[new_group_id] = i;
         }
 
-        // Go over all affected group IDs and remove their transitions if the
-        // group is empty.
-        for (int group_id : affected_group_ids) {
-            if (label_equivalence_relation->is_empty_group(group_id)) {
-                utils::release_vector_memory(transitions_by_group_id[group_id]);
+        vector<Transition> new_buffer;
+        vector<int> new_group_begin;
+        new_group_begin.reserve(num_groups + 1);
+        for (int group_id = 0; group_id < num_groups; ++group_id) {
+            new_group_begin.push_back(new_buffer.size());
+            int new_label_index = group_to_new_label_index[group_id];
+            if (new_label_index != -1) {
+                const vector<Transition> &group_transitions =
+                    new_transitions[new_label_index];
+                new_buffer.insert(new_buffer.end(),
+                                  group_transitions.begin(), group_transitions.end());
+            } else if (group_id < num_old_groups &&
+                       !label_equivalence_relation->is_empty_group(group_id)) {
+                TransitionRange group_transitions = get_transitions_for_group_id(group_id);
+                new_buffer.insert(new_buffer.end(),
+                                  group_transitions.begin(), group_transitions.end());
             }
         }
+        new_group_begin.push_back(new_buffer.size());
+        transitions = move(new_buffer);
+        group_begin = move(new_group_begin);
 
         compute_locally_equivalent_labels();
     }
@@ -448,15 +576,19 @@ string TransitionSystem::tag() const {
 
 bool TransitionSystem::are_transitions_sorted_unique() const {
     for (const GroupAndTransitions &gat : *this) {
-        if (!utils::is_sorted_unique(gat.transitions))
-            return false;
+        const TransitionRange &transitions = gat.transitions;
+        for (size_t i = 1; i < transitions.size(); ++i) {
+            if (transitions[i - 1] >= transitions[i])
+                return false;
+        }
     }
     return true;
 }
 
 bool TransitionSystem::in_sync_with_label_equivalence_relation() const {
-    return label_equivalence_relation->get_size() ==
-           static_cast<int>(transitions_by_group_id.size());
+    return label_equivalence_relation->get_size() + 1 ==
+           static_cast<int>(group_begin.size()) &&
+           group_begin.back() == static_cast<int>(transitions.size());
 }
 
 bool TransitionSystem::is_solvable(const Distances &distances) const {
@@ -470,11 +602,7 @@ bool TransitionSystem::is_solvable(const Distances &distances) const {
 }
 
 int TransitionSystem::compute_total_transitions() const {
-    int total = 0;
-    for (const GroupAndTransitions &gat : *this) {
-        total += gat.transitions.size();
-    }
-    return total;
+    return transitions.size();
 }
 
 string TransitionSystem::get_description() const {
@@ -505,7 +633,7 @@ void TransitionSystem::dump_dot_graph() const {
     }
     for (const GroupAndTransitions &gat : *this) {
         const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionRange &transitions = gat.transitions;
         for (const Transition &transition : transitions) {
             int src = transition.src;
             int target = transition.target;
@@ -536,7 +664,7 @@ void TransitionSystem::dump_labels_and_transitions() const {
         }
         cout << endl;
         cout << "transitions: ";
-        const vector<Transition> &transitions = gat.transitions;
+        const TransitionRange &transitions = gat.transitions;
         for (size_t i = 0; i < transitions.size(); ++i) {
             int src = transitions[i].src;
             int target = transitions[i].target;
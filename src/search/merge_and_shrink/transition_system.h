@@ -3,6 +3,7 @@
 
 #include "types.h"
 
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -37,11 +38,47 @@ struct Transition {
     }
 };
 
+/*
+  View of the transitions of one label group. The transitions are stored
+  in the contiguous transition buffer of the transition system, so the view
+  is only valid until the transition system is modified.
+*/
+class TransitionRange {
+    const Transition *first;
+    const Transition *last;
+public:
+    TransitionRange(const Transition *first, const Transition *last)
+        : first(first), last(last) {
+    }
+
+    const Transition *begin() const {
+        return first;
+    }
+
+    const Transition *end() const {
+        return last;
+    }
+
+    std::size_t size() const {
+        return last - first;
+    }
+
+    bool empty() const {
+        return first == last;
+    }
+
+    const Transition &operator[](std::size_t index) const {
+        return first[index];
+    }
+
+    bool operator==(const TransitionRange &other) const;
+};
+
 struct GroupAndTransitions {
     const LabelGroup &label_group;
-    const std::vector<Transition> &transitions;
+    const TransitionRange transitions;
     GroupAndTransitions(const LabelGroup &label_group,
-                        const std::vector<Transition> &transitions)
+                        const TransitionRange &transitions)
         : label_group(label_group),
           transitions(transitions) {
     }
@@ -55,14 +92,16 @@ class TSConstIterator {
       easily exchanged.
     */
     const LabelEquivalenceRelation &label_equivalence_relation;
-    const std::vector<std::vector<Transition>> &transitions_by_group_id;
+    const std::vector<Transition> &transitions;
+    const std::vector<int> &group_begin;
     // current_group_id is the actual iterator
     int current_group_id;
 
     void next_valid_index();
 public:
     TSConstIterator(const LabelEquivalenceRelation &label_equivalence_relation,
-                    const std::vector<std::vector<Transition>> &transitions_by_group_id,
+                    const std::vector<Transition> &transitions,
+                    const std::vector<int> &group_begin,
                     bool end);
     void operator++();
     GroupAndTransitions operator*() const;
@@ -100,17 +139,18 @@ private:
     std::unique_ptr<LabelEquivalenceRelation> label_equivalence_relation;
 
     /*
-      The transitions of a label group are indexed via its ID. The ID of a
-      group does not change, and hence its transitions are never moved.
-
-      We tested different alternatives to store the transitions, but they all
-      performed worse: storing a vector transitions in the label group increases
-      memory usage and runtime; storing the transitions more compactly and
-      incrementally increasing the size of transitions_of_groups whenever a
-      new label group is added also increases runtime. See also issue492 and
-      issue521.
+      The transitions of all label groups are stored in a single buffer,
+      ordered by group ID. The transitions of the group with ID i are
+      transitions[group_begin[i]] to transitions[group_begin[i + 1] - 1],
+      so group_begin has one more entry than there are groups. Groups that
+      have become empty own an empty range.
+
+      Compared to storing one vector per group, this avoids the allocation
+      overhead of many small vectors and lets us rebuild all transitions in
+      place when applying abstractions.
     */
-    std::vector<std::vector<Transition>> transitions_by_group_id;
+    std::vector<Transition> transitions;
+    std::vector<int> group_begin;
 
     int num_states;
     std::vector<bool> goal_states;
@@ -122,8 +162,13 @@ private:
     */
     void compute_locally_equivalent_labels();
 
-    const std::vector<Transition> &get_transitions_for_group_id(int group_id) const {
-        return transitions_by_group_id[group_id];
+    // Remove the transitions of all groups that no longer contain labels.
+    void remove_transitions_of_empty_groups();
+
+    TransitionRange get_transitions_for_group_id(int group_id) const {
+        const Transition *data = transitions.data();
+        return TransitionRange(data + group_begin[group_id],
+                               data + group_begin[group_id + 1]);
     }
 
     // Statistics and output
@@ -134,7 +179,8 @@ public:
         int num_variables,
         std::vector<int> &&incorporated_variables,
         std::unique_ptr<LabelEquivalenceRelation> &&label_equivalence_relation,
-        std::vector<std::vector<Transition>> &&transitions_by_group_id,
+        std::vector<Transition> &&transitions,
+        std::vector<int> &&group_begin,
         int num_states,
         std::vector<bool> &&goal_states,
         int init_state);
@@ -175,13 +221,15 @@ public:
 
     TSConstIterator begin() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_begin,
                                false);
     }
 
     TSConstIterator end() const {
         return TSConstIterator(*label_equivalence_relation,
-                               transitions_by_group_id,
+                               transitions,
+                               group_begin,
                                true);
     }
 
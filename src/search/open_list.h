@@ -90,6 +90,10 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    // Add all evaluators that this open list uses (directly or indirectly).
+    virtual void get_involved_evaluators(
+        std::set<const Evaluator *> &evals) const = 0;
+
     /*
       Accessor method for only_preferred.
 
@@ -55,6 +55,8 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_involved_evaluators(
+        set<const Evaluator *> &evals) const override;
     virtual bool empty() const override;
     virtual void clear() override;
 };
@@ -124,6 +126,12 @@ void EpsilonGreedyOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void EpsilonGreedyOpenList<Entry>::get_involved_evaluators(
+    set<const Evaluator *> &evals) const {
+    evaluator->get_involved_evaluators(evals);
+}
+
 template<class Entry>
 bool EpsilonGreedyOpenList<Entry>::empty() const {
     return size == 0;
@@ -44,6 +44,8 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_involved_evaluators(
+        set<const Evaluator *> &evals) const override;
 };
 
 template<class Entry>
@@ -135,6 +137,14 @@ void TypeBasedOpenList<Entry>::get_path_dependent_evaluators(
     }
 }
 
+template<class Entry>
+void TypeBasedOpenList<Entry>::get_involved_evaluators(
+    set<const Evaluator *> &evals) const {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators) {
+        evaluator->get_involved_evaluators(evals);
+    }
+}
+
 TypeBasedOpenListFactory::TypeBasedOpenListFactory(
     const Options &options)
     : options(options) {
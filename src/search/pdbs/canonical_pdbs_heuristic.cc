@@ -2,6 +2,7 @@
 
 #include "dominance_pruning.h"
 #include "pattern_generator.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -22,6 +23,8 @@ CanonicalPDBs get_canonical_pdbs_from_options(
     utils::Timer timer;
     PatternCollectionInformation pattern_collection_info =
         pattern_generator->generate(task);
+    pattern_collection_info.set_pdb_cache(
+        create_pdb_cache_from_options(opts, TaskProxy(*task)));
     shared_ptr<PDBCollection> pdbs = pattern_collection_info.get_pdbs();
     shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets =
         pattern_collection_info.get_max_additive_subsets();
@@ -42,7 +45,7 @@ CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -89,6 +92,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "systematic(1)");
 
     add_canonical_pdbs_options_to_parser(parser);
+    add_pdb_cache_options_to_parser(parser);
 
     Heuristic::add_options_to_parser(parser);
 
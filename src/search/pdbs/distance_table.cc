@@ -0,0 +1,98 @@
+#include "distance_table.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+using namespace std;
+
+namespace pdbs {
+DistanceTable::DistanceTable()
+    : num_words(0),
+      num_entries(0) {
+    set_bits_per_entry(32);
+}
+
+DistanceTable::DistanceTable(
+    const shared_ptr<const uint32_t> &words, size_t num_entries,
+    int bits_per_entry)
+    : words(words),
+      num_words(compute_num_words(num_entries, bits_per_entry)),
+      num_entries(num_entries) {
+    set_bits_per_entry(bits_per_entry);
+}
+
+void DistanceTable::set_bits_per_entry(int bits_per_entry) {
+    assert(bits_per_entry == 4 || bits_per_entry == 8 ||
+           bits_per_entry == 16 || bits_per_entry == 32);
+    log_bits_per_entry = 0;
+    while ((1 << log_bits_per_entry) < bits_per_entry)
+        ++log_bits_per_entry;
+    log_entries_per_word = 5 - log_bits_per_entry;
+    mask = (bits_per_entry == 32) ? numeric_limits<uint32_t>::max()
+                                  : (uint32_t(1) << bits_per_entry) - 1;
+}
+
+size_t DistanceTable::compute_num_words(size_t num_entries, int bits_per_entry) {
+    size_t entries_per_word = 32 / bits_per_entry;
+    return (num_entries + entries_per_word - 1) / entries_per_word;
+}
+
+DistanceTableBuilder::DistanceTableBuilder(size_t num_entries)
+    : data(nullptr) {
+    table.num_entries = num_entries;
+    repack(4);
+}
+
+void DistanceTableBuilder::repack(int bits_per_entry) {
+    DistanceTable old_table = table;
+    size_t num_entries = old_table.size();
+    size_t num_words = DistanceTable::compute_num_words(num_entries, bits_per_entry);
+    // Filling all bits marks all entries as dead ends.
+    uint32_t *new_data = new uint32_t[num_words];
+    fill(new_data, new_data + num_words, numeric_limits<uint32_t>::max());
+    table = DistanceTable(
+        shared_ptr<const uint32_t>(new_data, default_delete<uint32_t[]>()),
+        num_entries, bits_per_entry);
+    data = new_data;
+    if (old_table.get_num_words() == 0)
+        return;
+    for (size_t index = 0; index < num_entries; ++index) {
+        int distance = old_table.get(index);
+        if (distance != numeric_limits<int>::max())
+            set(index, distance);
+    }
+}
+
+void DistanceTableBuilder::widen(uint32_t value) {
+    int bits_per_entry = 2 * table.get_bits_per_entry();
+    while (bits_per_entry < 32 && value >= (uint32_t(1) << bits_per_entry) - 1)
+        bits_per_entry *= 2;
+    repack(bits_per_entry);
+}
+
+DistanceTable DistanceTableBuilder::finish() {
+    int max_finite_distance = 0;
+    for (size_t index = 0; index < table.size(); ++index) {
+        int distance = table.get(index);
+        if (distance != numeric_limits<int>::max())
+            max_finite_distance = max(max_finite_distance, distance);
+    }
+
+    /*
+      Choose the smallest width whose largest value (the dead-end
+      sentinel) exceeds all finite distances. 32-bit entries can store
+      all finite distances since they are below numeric_limits<int>::max().
+    */
+    int bits_per_entry = 4;
+    while (bits_per_entry < 32 &&
+           static_cast<uint32_t>(max_finite_distance) >=
+           (uint32_t(1) << bits_per_entry) - 1) {
+        bits_per_entry *= 2;
+    }
+    if (bits_per_entry != table.get_bits_per_entry())
+        repack(bits_per_entry);
+    data = nullptr;
+    return move(table);
+}
+}
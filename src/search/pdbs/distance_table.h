@@ -0,0 +1,131 @@
+#ifndef PDBS_DISTANCE_TABLE_H
+#define PDBS_DISTANCE_TABLE_H
+
+#include "../utils/language.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace pdbs {
+/*
+  Stores the goal distances of all abstract states of a PDB using the
+  smallest entry width out of 4, 8, 16 and 32 bits that can represent
+  all finite distances. The largest value of the chosen width is
+  reserved for dead ends (infinite distance).
+
+  Entries are stored in 32-bit words. Since all widths are powers of
+  two, no entry crosses a word boundary and a lookup only needs a
+  shift and a mask.
+
+  The words are immutable and shared between copies. They are either
+  owned by the table or live in memory owned by someone else, e.g., a
+  memory-mapped file (see PDBCache).
+*/
+class DistanceTable {
+    friend class DistanceTableBuilder;
+
+    std::shared_ptr<const std::uint32_t> words;
+    std::size_t num_words;
+    std::size_t num_entries;
+    int log_bits_per_entry;
+    int log_entries_per_word;
+    std::uint32_t mask;
+
+    void set_bits_per_entry(int bits_per_entry);
+public:
+    DistanceTable();
+    /*
+      Use already packed data. The caller is responsible for passing
+      words that hold num_entries entries of the given width.
+    */
+    DistanceTable(const std::shared_ptr<const std::uint32_t> &words,
+                  std::size_t num_entries, int bits_per_entry);
+
+    // Returns numeric_limits<int>::max() for dead ends.
+    int get(std::size_t index) const {
+        std::uint32_t word = words.get()[index >> log_entries_per_word];
+        int shift = static_cast<int>(
+            index & ((std::size_t(1) << log_entries_per_word) - 1)) << log_bits_per_entry;
+        std::uint32_t value = (word >> shift) & mask;
+        return value == mask ? std::numeric_limits<int>::max() : static_cast<int>(value);
+    }
+
+    // Hint that the entry with the given index will be looked up soon.
+    void prefetch(std::size_t index) const {
+#if defined(__GNUC__)
+        __builtin_prefetch(&words.get()[index >> log_entries_per_word]);
+#else
+        utils::unused_variable(index);
+#endif
+    }
+
+    std::size_t size() const {
+        return num_entries;
+    }
+
+    int get_bits_per_entry() const {
+        return 1 << log_bits_per_entry;
+    }
+
+    const std::uint32_t *get_words() const {
+        return words.get();
+    }
+
+    std::size_t get_num_words() const {
+        return num_words;
+    }
+
+    static std::size_t compute_num_words(std::size_t num_entries, int bits_per_entry);
+
+    std::size_t get_memory_in_bytes() const {
+        return num_words * sizeof(std::uint32_t);
+    }
+};
+
+/*
+  Packed distances that can be changed, used while computing a PDB. All
+  entries start as dead ends. The entry width starts at 4 bits and is
+  doubled whenever a distance does not fit, which repacks all entries.
+  finish() repacks the entries into the smallest width that can
+  represent the final distances, so the result does not depend on the
+  intermediate distances that were stored.
+*/
+class DistanceTableBuilder {
+    DistanceTable table;
+    // The words of table, which are owned by table.
+    std::uint32_t *data;
+
+    void repack(int bits_per_entry);
+    void widen(std::uint32_t value);
+public:
+    explicit DistanceTableBuilder(std::size_t num_entries);
+
+    // Returns numeric_limits<int>::max() for dead ends.
+    int get(std::size_t index) const {
+        return table.get(index);
+    }
+
+    void set(std::size_t index, int distance) {
+        assert(distance >= 0 && distance != std::numeric_limits<int>::max());
+        std::uint32_t value = static_cast<std::uint32_t>(distance);
+        if (value >= table.mask)
+            widen(value);
+        int shift = static_cast<int>(
+            index & ((std::size_t(1) << table.log_entries_per_word) - 1))
+            << table.log_bits_per_entry;
+        std::uint32_t &word = data[index >> table.log_entries_per_word];
+        word = (word & ~(table.mask << shift)) | (value << shift);
+    }
+
+    std::size_t size() const {
+        return table.size();
+    }
+
+    DistanceTable finish();
+};
+}
+
+#endif
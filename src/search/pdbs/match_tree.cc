@@ -1,65 +1,25 @@
 #include "match_tree.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <utility>
 
 using namespace std;
 
 namespace pdbs {
-struct MatchTree::Node {
-    static const int LEAF_NODE = -1;
-    Node();
-    ~Node();
-    vector<int> applicable_operator_ids;
-    // The variable which this node represents.
-    int var_id;
-    int var_domain_size;
-    /*
-      Each node has one outgoing edge for each possible value of the variable
-      and one "star-edge" that is used when the value of the variable is
-      undefined.
-    */
-    Node **successors;
-    Node *star_successor;
-
-    void initialize(int var_id, int var_domain_size);
-    bool is_leaf_node() const;
-};
-
-MatchTree::Node::Node()
-    : var_id(LEAF_NODE),
-      var_domain_size(0),
-      successors(nullptr),
-      star_successor(nullptr) {
-}
+/*
+  Patterns with at most this many abstract states precompute their
+  applicable operators per state if the table does not exceed
+  max_bucket_table_entries.
+*/
+static const size_t max_states_for_bucket_table = 1 << 16;
+static const size_t max_bucket_table_entries = 1 << 22;
 
-MatchTree::Node::~Node() {
-    if (successors) {
-        for (int i = 0; i < var_domain_size; ++i) {
-            delete successors[i];
-        }
-        delete[] successors;
-    }
-    delete star_successor;
-}
-
-void MatchTree::Node::initialize(int var_id_, int var_domain_size_) {
-    assert(is_leaf_node());
-    assert(var_id_ >= 0);
-    var_id = var_id_;
-    var_domain_size = var_domain_size_;
-    if (var_domain_size > 0) {
-        successors = new Node *[var_domain_size];
-        for (int val = 0; val < var_domain_size; ++val) {
-            successors[val] = nullptr;
-        }
-    }
-}
-
-bool MatchTree::Node::is_leaf_node() const {
-    return var_id == LEAF_NODE;
-}
+const int MatchTree::NO_NODE;
+const int MatchTree::LEAF_NODE;
 
 MatchTree::MatchTree(const TaskProxy &task_proxy,
                      const Pattern &pattern,
@@ -67,140 +27,290 @@ MatchTree::MatchTree(const TaskProxy &task_proxy,
     : task_proxy(task_proxy),
       pattern(pattern),
       hash_multipliers(hash_multipliers),
-      root(nullptr) {
+      num_states(1),
+      buffer_size(0),
+      finalized(false) {
+    VariablesProxy variables = task_proxy.get_variables();
+    domain_sizes.reserve(pattern.size());
+    for (int var_id : pattern) {
+        int domain_size = variables[var_id].get_domain_size();
+        domain_sizes.push_back(domain_size);
+        num_states *= domain_size;
+    }
 }
 
-MatchTree::~MatchTree() {
-    delete root;
+void MatchTree::insert(int op_id, const vector<FactPair> &regression_preconditions) {
+    assert(!finalized);
+    assert(is_sorted(regression_preconditions.begin(),
+                     regression_preconditions.end()));
+    inserted_operator_ids.push_back(op_id);
+    inserted_preconditions_begin.push_back(inserted_preconditions.size());
+    inserted_preconditions.insert(inserted_preconditions.end(),
+                                  regression_preconditions.begin(),
+                                  regression_preconditions.end());
 }
 
-void MatchTree::insert_recursive(
-    int op_id, const vector<FactPair> &regression_preconditions,
-    int pre_index, Node **edge_from_parent) {
-    if (*edge_from_parent == 0) {
-        // We don't exist yet: create a new node.
-        *edge_from_parent = new Node();
-    }
+/*
+  Create the node for the given inserted operators (entries), whose
+  preconditions before precondition_pos[entry] are already tested by
+  the ancestors, and its descendants in preorder. The node tests the
+  smallest variable of the remaining preconditions; operators without
+  remaining preconditions are stored at the node.
+*/
+int MatchTree::build_node(vector<int> &entries, vector<int> &precondition_pos) {
+    int node_id = nodes.size();
+    nodes.emplace_back();
+    nodes[node_id].operators_begin = operator_ids.size();
 
-    Node *node = *edge_from_parent;
-    if (pre_index == static_cast<int>(regression_preconditions.size())) {
-        // All preconditions have been checked, insert operator ID.
-        node->applicable_operator_ids.push_back(op_id);
-    } else {
-        const FactPair &fact = regression_preconditions[pre_index];
-        int pattern_var_id = fact.var;
-        int var_id = pattern[pattern_var_id];
-        VariableProxy var = task_proxy.get_variables()[var_id];
-        int var_domain_size = var.get_domain_size();
-
-        // Set up node correctly or insert a new node if necessary.
-        if (node->is_leaf_node()) {
-            node->initialize(pattern_var_id, var_domain_size);
-        } else if (node->var_id > pattern_var_id) {
-            /* The variable to test has been left out: must insert new
-               node and treat it as the "node". */
-            Node *new_node = new Node();
-            new_node->initialize(pattern_var_id, var_domain_size);
-            // The new node gets the left out variable as its variable.
-            *edge_from_parent = new_node;
-            new_node->star_successor = node;
-            // The new node is now the node of interest.
-            node = new_node;
+    int var_id = numeric_limits<int>::max();
+    vector<int> remaining_entries;
+    for (int entry : entries) {
+        int pos = precondition_pos[entry];
+        if (pos == inserted_preconditions_begin[entry + 1]) {
+            operator_ids.push_back(inserted_operator_ids[entry]);
+        } else {
+            remaining_entries.push_back(entry);
+            var_id = min(var_id, inserted_preconditions[pos].var);
         }
+    }
+    nodes[node_id].operators_end = operator_ids.size();
+    vector<int>().swap(entries);
+
+    if (remaining_entries.empty()) {
+        nodes[node_id].var_id = LEAF_NODE;
+        nodes[node_id].var_domain_size = 0;
+        nodes[node_id].hash_multiplier = 0;
+        nodes[node_id].successors_begin = NO_NODE;
+        nodes[node_id].star_successor = NO_NODE;
+        return node_id;
+    }
+
+    int var_domain_size = domain_sizes[var_id];
+    int successors_begin = successors.size();
+    nodes[node_id].var_id = var_id;
+    nodes[node_id].var_domain_size = var_domain_size;
+    nodes[node_id].hash_multiplier = hash_multipliers[var_id];
+    nodes[node_id].successors_begin = successors_begin;
+    successors.resize(successors.size() + var_domain_size, NO_NODE);
 
-        /* Set up edge to the correct child (for which we want to call
-           this function recursively). */
-        Node **edge_to_child = 0;
-        if (node->var_id == fact.var) {
+    vector<vector<int>> entries_by_value(var_domain_size);
+    vector<int> star_entries;
+    for (int entry : remaining_entries) {
+        const FactPair &fact = inserted_preconditions[precondition_pos[entry]];
+        if (fact.var == var_id) {
             // Operator has a precondition on the variable tested by node.
-            edge_to_child = &node->successors[fact.value];
-            ++pre_index;
+            entries_by_value[fact.value].push_back(entry);
+            ++precondition_pos[entry];
         } else {
-            // Operator doesn't have a precondition on the variable tested by
-            // node: follow/create the star-edge.
-            assert(node->var_id < fact.var);
-            edge_to_child = &node->star_successor;
+            // Otherwise, it follows the star-edge.
+            assert(fact.var > var_id);
+            star_entries.push_back(entry);
         }
-
-        insert_recursive(op_id, regression_preconditions, pre_index, edge_to_child);
     }
+    for (int val = 0; val < var_domain_size; ++val) {
+        if (!entries_by_value[val].empty()) {
+            int child = build_node(entries_by_value[val], precondition_pos);
+            successors[successors_begin + val] = child;
+        }
+    }
+    int star_successor = NO_NODE;
+    if (!star_entries.empty())
+        star_successor = build_node(star_entries, precondition_pos);
+    nodes[node_id].star_successor = star_successor;
+    return node_id;
 }
 
-void MatchTree::insert(int op_id, const vector<FactPair> &regression_preconditions) {
-    insert_recursive(op_id, regression_preconditions, 0, &root);
+bool MatchTree::use_bucket_table() const {
+    if (num_states > max_states_for_bucket_table)
+        return false;
+    size_t num_entries = 0;
+    for (size_t entry = 0; entry < inserted_operator_ids.size(); ++entry) {
+        size_t num_matching_states = num_states;
+        for (int pos = inserted_preconditions_begin[entry];
+             pos < inserted_preconditions_begin[entry + 1]; ++pos) {
+            num_matching_states /= domain_sizes[inserted_preconditions[pos].var];
+        }
+        num_entries += num_matching_states;
+        if (num_entries > max_bucket_table_entries)
+            return false;
+    }
+    return true;
 }
 
-void MatchTree::get_applicable_operator_ids_recursive(
-    Node *node, const size_t state_index, vector<int> &operator_ids) const {
-    /*
-      Note: different from the code that builds the match tree, we do
-      the test if node == 0 *before* calling traverse rather than *at
-      the start* of traverse since this turned out to be faster in
-      some informal experiments.
-     */
-
-    operator_ids.insert(operator_ids.end(),
-                        node->applicable_operator_ids.begin(),
-                        node->applicable_operator_ids.end());
-
-    if (node->is_leaf_node())
-        return;
-
-    int temp = state_index / hash_multipliers[node->var_id];
-    int val = temp % node->var_domain_size;
+/*
+  Call callback(state_index) for all abstract states that satisfy the
+  preconditions of the given inserted operator by enumerating the
+  values of the remaining pattern variables.
+*/
+template<typename Callback>
+void MatchTree::for_each_matching_state(int entry, const Callback &callback) const {
+    size_t state_index = 0;
+    vector<int> free_vars;
+    int pos = inserted_preconditions_begin[entry];
+    int end = inserted_preconditions_begin[entry + 1];
+    for (size_t var = 0; var < pattern.size(); ++var) {
+        if (pos != end && inserted_preconditions[pos].var == static_cast<int>(var)) {
+            state_index += inserted_preconditions[pos].value * hash_multipliers[var];
+            ++pos;
+        } else {
+            free_vars.push_back(var);
+        }
+    }
+    vector<int> values(free_vars.size(), 0);
+    while (true) {
+        callback(state_index);
+        size_t i = 0;
+        for (; i < free_vars.size(); ++i) {
+            int var = free_vars[i];
+            if (++values[i] < domain_sizes[var]) {
+                state_index += hash_multipliers[var];
+                break;
+            }
+            state_index -= (domain_sizes[var] - 1) * hash_multipliers[var];
+            values[i] = 0;
+        }
+        if (i == free_vars.size())
+            break;
+    }
+}
 
-    if (node->successors[val]) {
-        // Follow the correct successor edge, if it exists.
-        get_applicable_operator_ids_recursive(
-            node->successors[val], state_index, operator_ids);
+void MatchTree::build_bucket_table() {
+    int num_entries = inserted_operator_ids.size();
+    bucket_begin.assign(num_states + 1, 0);
+    for (int entry = 0; entry < num_entries; ++entry) {
+        for_each_matching_state(entry, [&](size_t state_index) {
+                                    ++bucket_begin[state_index + 1];
+                                });
     }
-    if (node->star_successor) {
-        // Always follow the star edge, if it exists.
-        get_applicable_operator_ids_recursive(
-            node->star_successor, state_index, operator_ids);
+    for (size_t state_index = 0; state_index < num_states; ++state_index) {
+        bucket_begin[state_index + 1] += bucket_begin[state_index];
+    }
+    bucket_operator_ids.resize(bucket_begin[num_states]);
+    vector<int> next_pos(bucket_begin.begin(), bucket_begin.end() - 1);
+    for (int entry = 0; entry < num_entries; ++entry) {
+        int op_id = inserted_operator_ids[entry];
+        for_each_matching_state(entry, [&](size_t state_index) {
+                                    bucket_operator_ids[next_pos[state_index]++] = op_id;
+                                });
     }
 }
 
-void MatchTree::get_applicable_operator_ids(
-    size_t state_index, vector<int> &operator_ids) const {
-    if (root)
-        get_applicable_operator_ids_recursive(root, state_index, operator_ids);
+void MatchTree::finalize() {
+    assert(!finalized);
+    finalized = true;
+    inserted_preconditions_begin.push_back(inserted_preconditions.size());
+    if (use_bucket_table()) {
+        build_bucket_table();
+        for (size_t state_index = 0; state_index < num_states; ++state_index) {
+            buffer_size = max(
+                buffer_size,
+                bucket_begin[state_index + 1] - bucket_begin[state_index]);
+        }
+    } else {
+        if (!inserted_operator_ids.empty()) {
+            vector<int> entries(inserted_operator_ids.size());
+            iota(entries.begin(), entries.end(), 0);
+            vector<int> precondition_pos(
+                inserted_preconditions_begin.begin(),
+                inserted_preconditions_begin.end() - 1);
+            build_node(entries, precondition_pos);
+        }
+        /*
+          Every operator is stored at a single node and the stack contains
+          at most one star successor per pattern variable.
+        */
+        buffer_size = operator_ids.size() + pattern.size();
+    }
+    vector<int>().swap(inserted_operator_ids);
+    vector<int>().swap(inserted_preconditions_begin);
+    vector<FactPair>().swap(inserted_preconditions);
 }
 
-void MatchTree::dump_recursive(Node *node) const {
-    if (!node) {
-        // Node is the root node.
-        cout << "Empty MatchTree" << endl;
-        return;
+int MatchTree::get_buffer_size() const {
+    assert(finalized);
+    return buffer_size;
+}
+
+int MatchTree::get_applicable_operator_ids(
+    size_t state_index, int *buffer) const {
+    assert(finalized);
+    if (!bucket_begin.empty()) {
+        const int *begin = bucket_operator_ids.data() + bucket_begin[state_index];
+        const int *end = bucket_operator_ids.data() + bucket_begin[state_index + 1];
+        copy(begin, end, buffer);
+        return end - begin;
     }
+    if (nodes.empty())
+        return 0;
+
+    /*
+      Star successors that still have to be visited are pushed onto a
+      stack that grows downwards from the end of the buffer.
+    */
+    int *stack_bottom = buffer + buffer_size;
+    int *stack_top = stack_bottom;
+    int num_operators = 0;
+    int node_id = 0;
+    while (true) {
+        const Node &node = nodes[node_id];
+        for (int i = node.operators_begin; i < node.operators_end; ++i) {
+            buffer[num_operators++] = operator_ids[i];
+        }
+
+        int next_node_id = NO_NODE;
+        if (!node.is_leaf_node()) {
+            int val = (state_index / node.hash_multiplier) % node.var_domain_size;
+            // Follow the correct successor edge and the star edge, if they exist.
+            next_node_id = successors[node.successors_begin + val];
+            if (node.star_successor != NO_NODE) {
+                if (next_node_id == NO_NODE) {
+                    next_node_id = node.star_successor;
+                } else {
+                    *--stack_top = node.star_successor;
+                }
+            }
+        }
+        if (next_node_id == NO_NODE) {
+            if (stack_top == stack_bottom)
+                break;
+            next_node_id = *stack_top++;
+        }
+        node_id = next_node_id;
+    }
+    assert(buffer + num_operators <= stack_top);
+    return num_operators;
+}
+
+void MatchTree::dump_recursive(int node_id) const {
+    const Node &node = nodes[node_id];
     cout << endl;
-    cout << "node->var_id = " << node->var_id << endl;
+    cout << "node->var_id = " << node.var_id << endl;
     cout << "Number of applicable operators at this node: "
-         << node->applicable_operator_ids.size() << endl;
-    for (int op_id : node->applicable_operator_ids) {
-        cout << "AbstractOperator #" << op_id << endl;
+         << node.operators_end - node.operators_begin << endl;
+    for (int i = node.operators_begin; i < node.operators_end; ++i) {
+        cout << "AbstractOperator #" << operator_ids[i] << endl;
     }
-    if (node->is_leaf_node()) {
+    if (node.is_leaf_node()) {
         cout << "leaf node." << endl;
-        assert(!node->successors);
-        assert(!node->star_successor);
+        assert(node.star_successor == NO_NODE);
     } else {
-        for (int val = 0; val < node->var_domain_size; ++val) {
-            if (node->successors[val]) {
+        for (int val = 0; val < node.var_domain_size; ++val) {
+            int child = successors[node.successors_begin + val];
+            if (child != NO_NODE) {
                 cout << "recursive call for child with value " << val << endl;
-                dump_recursive(node->successors[val]);
+                dump_recursive(child);
                 cout << "back from recursive call (for successors[" << val
-                     << "]) to node with var_id = " << node->var_id
+                     << "]) to node with var_id = " << node.var_id
                      << endl;
             } else {
                 cout << "no child for value " << val << endl;
             }
         }
-        if (node->star_successor) {
+        if (node.star_successor != NO_NODE) {
             cout << "recursive call for star_successor" << endl;
-            dump_recursive(node->star_successor);
+            dump_recursive(node.star_successor);
             cout << "back from recursive call (for star_successor) "
-                 << "to node with var_id = " << node->var_id << endl;
+                 << "to node with var_id = " << node.var_id << endl;
         } else {
             cout << "no star_successor" << endl;
         }
@@ -208,6 +318,14 @@ void MatchTree::dump_recursive(Node *node) const {
 }
 
 void MatchTree::dump() const {
-    dump_recursive(root);
+    if (!bucket_begin.empty()) {
+        cout << "MatchTree with bucket table for " << num_states
+             << " abstract states and " << bucket_operator_ids.size()
+             << " entries" << endl;
+    } else if (nodes.empty()) {
+        cout << "Empty MatchTree" << endl;
+    } else {
+        dump_recursive(0);
+    }
 }
 }
@@ -12,42 +12,104 @@ namespace pdbs {
 /*
   Successor Generator for abstract operators.
 
+  Operators are first inserted and the match tree is then built by
+  finalize(). The tree is stored in flat arrays: the nodes in preorder,
+  the successor slots of all nodes in one table and the operator IDs of
+  all nodes in compressed sparse row form. It is traversed iteratively
+  and writes into a buffer provided by the caller, so that queries
+  never allocate memory and can be answered concurrently.
+
+  For small patterns, finalize() instead precomputes the applicable
+  operators of every abstract state in a bucket table, which reduces
+  queries to copying a contiguous range.
+
   NOTE: MatchTree keeps a reference to the task proxy passed to the constructor.
   Therefore, users of the class must ensure that the task lives at least as long
   as the match tree.
 */
 
 class MatchTree {
+    static const int NO_NODE = -1;
+    static const int LEAF_NODE = -1;
+
+    struct Node {
+        // The pattern index of the variable which this node tests.
+        int var_id;
+        int var_domain_size;
+        std::size_t hash_multiplier;
+        // Range of this node's operators in operator_ids.
+        int operators_begin;
+        int operators_end;
+        /*
+          Each inner node has one outgoing edge for each possible value of
+          the variable, stored at successors[successors_begin + value], and
+          one "star-edge" that is used when the value of the variable is
+          undefined.
+        */
+        int successors_begin;
+        int star_successor;
+
+        bool is_leaf_node() const {
+            return var_id == LEAF_NODE;
+        }
+    };
+
     TaskProxy task_proxy;
-    struct Node;
     // See PatternDatabase for documentation on pattern and hash_multipliers.
     Pattern pattern;
     std::vector<size_t> hash_multipliers;
-    Node *root;
-    void insert_recursive(int op_id,
-                          const std::vector<FactPair> &regression_preconditions,
-                          int pre_index,
-                          Node **edge_from_parent);
-    void get_applicable_operator_ids_recursive(
-        Node *node, size_t state_index, std::vector<int> &operator_ids) const;
-    void dump_recursive(Node *node) const;
+    std::vector<int> domain_sizes;
+    std::size_t num_states;
+
+    // Inserted operators, only needed until the tree is finalized.
+    std::vector<int> inserted_operator_ids;
+    std::vector<int> inserted_preconditions_begin;
+    std::vector<FactPair> inserted_preconditions;
+
+    // Flat match tree. The root is the first node.
+    std::vector<Node> nodes;
+    std::vector<int> successors;
+    std::vector<int> operator_ids;
+
+    // Applicable operators by abstract state, empty if not used.
+    std::vector<int> bucket_begin;
+    std::vector<int> bucket_operator_ids;
+
+    int buffer_size;
+    bool finalized;
+
+    int build_node(std::vector<int> &entries, std::vector<int> &precondition_pos);
+    bool use_bucket_table() const;
+    void build_bucket_table();
+    template<typename Callback>
+    void for_each_matching_state(int entry, const Callback &callback) const;
+    void dump_recursive(int node_id) const;
 public:
     // Initialize an empty match tree.
     MatchTree(const TaskProxy &task_proxy,
               const Pattern &pattern,
               const std::vector<size_t> &hash_multipliers);
-    ~MatchTree();
-    /* Insert an abstract operator into the match tree, creating or
-       enlarging it. */
+    ~MatchTree() = default;
+    /* Insert an abstract operator into the match tree. Preconditions must
+       be sorted by variable. */
     void insert(int op_id, const std::vector<FactPair> &regression_preconditions);
 
+    // Build the match tree. Must be called after inserting all operators.
+    void finalize();
+
+    /*
+      Buffers passed to get_applicable_operator_ids need at least this
+      many entries. The last entries are used as a traversal stack.
+    */
+    int get_buffer_size() const;
+
     /*
-      Extracts all IDs of applicable abstract operators for the abstract state
-      given by state_index (the index is converted back to variable/values
-      pairs).
+      Writes the IDs of all applicable abstract operators for the abstract
+      state given by state_index (the index is converted back to
+      variable/values pairs) to the start of the buffer and returns their
+      number.
     */
-    void get_applicable_operator_ids(
-        size_t state_index, std::vector<int> &operator_ids) const;
+    int get_applicable_operator_ids(size_t state_index, int *buffer) const;
     void dump() const;
 };
 }
@@ -0,0 +1,76 @@
+#include "multi_pdb_lookup.h"
+
+#include "pattern_database.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <unordered_map>
+
+using namespace std;
+
+namespace pdbs {
+MultiPDBLookup::MultiPDBLookup(const MaxAdditivePDBSubsets &subsets) {
+    // PDBs can occur in multiple subsets, but are only looked up once.
+    unordered_map<const PatternDatabase *, int> pdb_ids;
+    subset_begin.reserve(subsets.size() + 1);
+    for (const PDBCollection &subset : subsets) {
+        subset_begin.push_back(subset_pdbs.size());
+        for (const shared_ptr<PatternDatabase> &pdb : subset) {
+            auto result = pdb_ids.emplace(pdb.get(), pdbs.size());
+            if (result.second)
+                pdbs.push_back(pdb);
+            subset_pdbs.push_back(result.first->second);
+        }
+    }
+    subset_begin.push_back(subset_pdbs.size());
+
+    hash_begin.reserve(pdbs.size() + 1);
+    distance_tables.reserve(pdbs.size());
+    for (const shared_ptr<PatternDatabase> &pdb : pdbs) {
+        hash_begin.push_back(hash_vars.size());
+        const Pattern &pattern = pdb->get_pattern();
+        const vector<size_t> &multipliers = pdb->get_hash_multipliers();
+        hash_vars.insert(hash_vars.end(), pattern.begin(), pattern.end());
+        hash_multipliers.insert(
+            hash_multipliers.end(), multipliers.begin(), multipliers.end());
+        distance_tables.push_back(&pdb->get_distance_table());
+    }
+    hash_begin.push_back(hash_vars.size());
+
+    indices.resize(pdbs.size());
+    h_values.resize(pdbs.size());
+}
+
+int MultiPDBLookup::get_value(const vector<int> &state_values) const {
+    int num_pdbs = pdbs.size();
+    for (int pdb_id = 0; pdb_id < num_pdbs; ++pdb_id) {
+        size_t index = 0;
+        for (int i = hash_begin[pdb_id]; i < hash_begin[pdb_id + 1]; ++i) {
+            index += hash_multipliers[i] * state_values[hash_vars[i]];
+        }
+        indices[pdb_id] = index;
+        distance_tables[pdb_id]->prefetch(index);
+    }
+
+    for (int pdb_id = 0; pdb_id < num_pdbs; ++pdb_id) {
+        int h = distance_tables[pdb_id]->get(indices[pdb_id]);
+        if (h == numeric_limits<int>::max())
+            return numeric_limits<int>::max();
+        h_values[pdb_id] = h;
+    }
+
+    // If we have an empty collection, then subsets = { \emptyset }.
+    assert(subset_begin.size() >= 2);
+    int num_subsets = subset_begin.size() - 1;
+    int max_h = 0;
+    for (int subset_id = 0; subset_id < num_subsets; ++subset_id) {
+        int subset_h = 0;
+        for (int i = subset_begin[subset_id]; i < subset_begin[subset_id + 1]; ++i) {
+            subset_h += h_values[subset_pdbs[i]];
+        }
+        max_h = max(max_h, subset_h);
+    }
+    return max_h;
+}
+}
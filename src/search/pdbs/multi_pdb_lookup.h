@@ -0,0 +1,51 @@
+#ifndef PDBS_MULTI_PDB_LOOKUP_H
+#define PDBS_MULTI_PDB_LOOKUP_H
+
+#include "types.h"
+
+#include <vector>
+
+namespace pdbs {
+class DistanceTable;
+
+/*
+  Evaluates the maximum over sums of a collection of PDB subsets, i.e.,
+  the canonical heuristic for the given additive subsets. A single
+  subset yields the sum of its PDBs.
+
+  All data needed for a lookup is stored in flat arrays: first, the
+  abstract state indices of all PDBs are computed in one pass over a
+  table of (variable, multiplier) pairs, prefetching the distance
+  entries. Then all distances are looked up once, and finally the
+  subset sums are computed from a flat list of PDB indices.
+
+  The lookup uses internal buffers and is therefore not thread-safe.
+*/
+class MultiPDBLookup {
+    // Keep the PDBs alive since we point to their distance tables.
+    PDBCollection pdbs;
+    std::vector<const DistanceTable *> distance_tables;
+
+    // The hash function of PDB i uses the entries [hash_begin[i], hash_begin[i + 1]).
+    std::vector<int> hash_begin;
+    std::vector<int> hash_vars;
+    std::vector<std::size_t> hash_multipliers;
+
+    // Subset i consists of the PDBs subset_pdbs[subset_begin[i], subset_begin[i + 1]).
+    std::vector<int> subset_begin;
+    std::vector<int> subset_pdbs;
+
+    mutable std::vector<std::size_t> indices;
+    mutable std::vector<int> h_values;
+public:
+    explicit MultiPDBLookup(const MaxAdditivePDBSubsets &subsets);
+
+    /*
+      Returns numeric_limits<int>::max() if any PDB considers the state a
+      dead end. The state is given by the values of all variables.
+    */
+    int get_value(const std::vector<int> &state_values) const;
+};
+}
+
+#endif
@@ -17,11 +17,14 @@
 #include "../utils/markup.h"
 #include "../utils/math.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
+#include "../utils/parallel_options.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <limits>
@@ -117,6 +120,7 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       num_samples(opts.get<int>("num_samples")),
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
+      num_threads(utils::parse_num_threads_from_options(opts)),
       rng(utils::parse_rng_from_options(opts)),
       num_rejected(0),
       hill_climbing_timer(0) {
@@ -130,7 +134,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     PDBCollection &candidate_pdbs) {
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
-    int max_pdb_size = 0;
+    vector<Pattern> new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -157,16 +161,25 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                       surpass the size limit.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+
+    PDBCollection new_pdbs(new_patterns.size());
+    utils::parallel_for(
+        num_threads, new_patterns.size(),
+        [&](int, int i) {
+            new_pdbs[i] = make_shared<PatternDatabase>(task_proxy, new_patterns[i]);
+        });
+    int max_pdb_size = 0;
+    for (shared_ptr<PatternDatabase> &new_pdb : new_pdbs) {
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+        candidate_pdbs.push_back(move(new_pdb));
+    }
     return max_pdb_size;
 }
 
@@ -190,7 +203,7 @@ void PatternCollectionGeneratorHillclimbing::sample_states(
 }
 
 pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
-    const vector<State> &samples,
+    const vector<int> &sample_values,
     const vector<int> &samples_h_values,
     PDBCollection &candidate_pdbs) {
     /*
@@ -202,12 +215,11 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     */
     int improvement = 0;
     int best_pdb_index = -1;
+    int num_variables = sample_values.size() / num_samples;
 
-    // Iterate over all candidates and search for the best improving pattern/pdb
+    // Collect the candidates that need to be evaluated.
+    vector<int> evaluated_pdb_indices;
     for (size_t i = 0; i < candidate_pdbs.size(); ++i) {
-        if (hill_climbing_timer->is_expired())
-            throw HillClimbingTimeout();
-
         const shared_ptr<PatternDatabase> &pdb = candidate_pdbs[i];
         if (!pdb) {
             /* candidate pattern is too large or has already been added to
@@ -223,29 +235,50 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
             candidate_pdbs[i] = nullptr;
             continue;
         }
+        evaluated_pdb_indices.push_back(i);
+    }
 
-        /*
-          Calculate the "counting approximation" for all sample states: count
-          the number of samples for which the current pattern collection
-          heuristic would be improved if the new pattern was included into it.
-        */
-        /*
-          TODO: The original implementation by Haslum et al. uses m/t as a
-          statistical confidence interval to stop the A*-search (which they use,
-          see above) earlier.
-        */
-        int count = 0;
-        MaxAdditivePDBSubsets max_additive_subsets =
-            current_pdbs->get_max_additive_subsets(pdb->get_pattern());
-        for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
-            const State &sample = samples[sample_id];
-            assert(utils::in_bounds(sample_id, samples_h_values));
-            int h_collection = samples_h_values[sample_id];
-            if (is_heuristic_improved(
-                    *pdb, sample, h_collection, max_additive_subsets)) {
-                ++count;
+    /*
+      Calculate the "counting approximation" for all sample states: count
+      the number of samples for which the current pattern collection
+      heuristic would be improved if the new pattern was included into it.
+    */
+    /*
+      TODO: The original implementation by Haslum et al. uses m/t as a
+      statistical confidence interval to stop the A*-search (which they use,
+      see above) earlier.
+    */
+    vector<int> counts(evaluated_pdb_indices.size(), 0);
+    atomic<bool> timeout(false);
+    utils::parallel_for(
+        num_threads, evaluated_pdb_indices.size(),
+        [&](int, int item) {
+            if (timeout || hill_climbing_timer->is_expired()) {
+                timeout = true;
+                return;
             }
-        }
+            const PatternDatabase &pdb = *candidate_pdbs[evaluated_pdb_indices[item]];
+            MaxAdditivePDBSubsets max_additive_subsets =
+                current_pdbs->get_max_additive_subsets(pdb.get_pattern());
+            int count = 0;
+            for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
+                assert(utils::in_bounds(sample_id, samples_h_values));
+                int h_collection = samples_h_values[sample_id];
+                if (is_heuristic_improved(
+                        pdb, &sample_values[sample_id * num_variables],
+                        h_collection, max_additive_subsets)) {
+                    ++count;
+                }
+            }
+            counts[item] = count;
+        });
+    if (timeout)
+        throw HillClimbingTimeout();
+
+    // Reduce in candidate order to obtain the same result as a serial run.
+    for (size_t item = 0; item < evaluated_pdb_indices.size(); ++item) {
+        int i = evaluated_pdb_indices[item];
+        int count = counts[item];
         if (count > improvement) {
             improvement = count;
             best_pdb_index = i;
@@ -260,10 +293,10 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
 }
 
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
-    const PatternDatabase &pdb, const State &sample, int h_collection,
-    const MaxAdditivePDBSubsets &max_additive_subsets) {
+    const PatternDatabase &pdb, const int *sample_values, int h_collection,
+    const MaxAdditivePDBSubsets &max_additive_subsets) const {
     // h_pattern: h-value of the new pattern
-    int h_pattern = pdb.get_value(sample);
+    int h_pattern = pdb.get_value(sample_values);
 
     if (h_pattern == numeric_limits<int>::max()) {
         return true;
@@ -278,7 +311,7 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
         for (const shared_ptr<PatternDatabase> &additive_pdb : subset) {
             /* Experiments showed that it is faster to recompute the
                h values than to cache them in an unordered_map. */
-            int h = additive_pdb->get_value(sample);
+            int h = additive_pdb->get_value(sample_values);
             if (h == numeric_limits<int>::max())
                 return false;
             h_subset += h;
@@ -330,6 +363,8 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
     sampling::RandomWalkSampler sampler(task_proxy, *rng);
     vector<State> samples;
+    // All samples unpacked into one buffer shared by all candidates.
+    vector<int> sample_values;
     vector<int> samples_h_values;
 
     try {
@@ -347,14 +382,18 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
             }
 
             samples.clear();
+            sample_values.clear();
             samples_h_values.clear();
             sample_states(sampler, init_h, samples);
             for (const State &sample : samples) {
+                const vector<int> &values = sample.get_values();
+                sample_values.insert(sample_values.end(), values.begin(), values.end());
                 samples_h_values.push_back(current_pdbs->get_value(sample));
             }
 
             pair<int, int> improvement_and_index =
-                find_best_improving_pdb(samples, samples_h_values, candidate_pdbs);
+                find_best_improving_pdb(
+                    sample_values, samples_h_values, candidate_pdbs);
             int improvement = improvement_and_index.first;
             int best_pdb_index = improvement_and_index.second;
 
@@ -464,6 +503,7 @@ void add_hillclimbing_options(OptionParser &parser) {
         "infinity",
         Bounds("0.0", "infinity"));
     utils::add_rng_options(parser);
+    utils::add_parallel_options(parser);
 }
 
 void check_hillclimbing_options(
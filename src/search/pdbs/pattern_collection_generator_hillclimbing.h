@@ -39,6 +39,7 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     // minimal improvement required for hill climbing to continue search
     const int min_improvement;
     const double max_time;
+    const int num_threads;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     std::unique_ptr<IncrementalCanonicalPDBs> current_pdbs;
@@ -52,7 +53,8 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       relevant variable are considered as candidate patterns. If the candidate
       pattern has not been previously considered (not contained in
       generated_patterns) and if building a PDB for it does not surpass the
-      size limit, then the PDB is built and added to candidate_pdbs.
+      size limit, then the PDB is built and added to candidate_pdbs. The new
+      PDBs are built concurrently and added in a fixed order.
 
       The method returns the size of the largest PDB added to candidate_pdbs.
     */
@@ -80,11 +82,14 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
 
     /*
       Searches for the best improving pdb in candidate_pdbs according to the
-      counting approximation and the given samples. Returns the improvement and
-      the index of the best pdb in candidate_pdbs.
+      counting approximation and the given samples. The samples are stored
+      unpacked one after the other in sample_values. Candidates are scored
+      concurrently, but ties are broken in favour of the first candidate as
+      in a sequential run. Returns the improvement and the index of the best
+      pdb in candidate_pdbs.
     */
     std::pair<int, int> find_best_improving_pdb(
-        const std::vector<State> &samples,
+        const std::vector<int> &sample_values,
         const std::vector<int> &samples_h_values,
         PDBCollection &candidate_pdbs);
 
@@ -96,9 +101,9 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
     */
     bool is_heuristic_improved(
         const PatternDatabase &pdb,
-        const State &sample,
+        const int *sample_values,
         int h_collection,
-        const MaxAdditivePDBSubsets &max_additive_subsets);
+        const MaxAdditivePDBSubsets &max_additive_subsets) const;
 
     /*
       This is the core algorithm of this class. The initial PDB collection
@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "max_additive_pdb_sets.h"
+#include "pdb_cache.h"
 #include "validation.h"
 
 #include <algorithm>
@@ -72,10 +73,16 @@ void PatternCollectionInformation::create_pdbs_if_missing() {
     if (!pdbs) {
         pdbs = make_shared<PDBCollection>();
         for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
+            shared_ptr<PatternDatabase> pdb;
+            if (pdb_cache) {
+                pdb = pdb_cache->get_pdb(pattern);
+            } else {
+                pdb = make_shared<PatternDatabase>(task_proxy, pattern);
+            }
             pdbs->push_back(pdb);
         }
+        if (pdb_cache)
+            pdb_cache->print_statistics();
     }
 }
 
@@ -99,6 +106,11 @@ void PatternCollectionInformation::set_max_additive_subsets(
     assert(information_is_valid());
 }
 
+void PatternCollectionInformation::set_pdb_cache(
+    const shared_ptr<PDBCache> &pdb_cache_) {
+    pdb_cache = pdb_cache_;
+}
+
 shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() {
     assert(patterns);
     return patterns;
@@ -8,6 +8,8 @@
 #include <memory>
 
 namespace pdbs {
+class PDBCache;
+
 /*
   This class contains everything we know about a pattern collection. It will
   always contain patterns, but can also contain the computed PDBs and maximal
@@ -22,6 +24,7 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    std::shared_ptr<PDBCache> pdb_cache;
 
     void create_pdbs_if_missing();
     void create_max_additive_subsets_if_missing();
@@ -36,6 +39,11 @@ public:
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
     void set_max_additive_subsets(
         const std::shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets);
+    /*
+      Use the given cache for PDBs that are created on request. PDBs that
+      were already set (e.g., by the generator) are not added to it.
+    */
+    void set_pdb_cache(const std::shared_ptr<PDBCache> &pdb_cache);
 
     std::shared_ptr<PatternCollection> get_patterns();
     std::shared_ptr<PDBCollection> get_pdbs();
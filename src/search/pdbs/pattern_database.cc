@@ -7,6 +7,7 @@
 #include "../utils/collections.h"
 #include "../utils/logging.h"
 #include "../utils/math.h"
+#include "../utils/parallel.h"
 #include "../utils/timer.h"
 
 #include <algorithm>
@@ -70,7 +71,8 @@ PatternDatabase::PatternDatabase(
     const TaskProxy &task_proxy,
     const Pattern &pattern,
     bool dump,
-    const vector<int> &operator_costs)
+    const vector<int> &operator_costs,
+    int num_threads)
     : pattern(pattern) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
@@ -93,9 +95,24 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs);
-    if (dump)
+    create_pdb(task_proxy, operator_costs, num_threads);
+    if (dump) {
         cout << "PDB construction time: " << timer << endl;
+        cout << "PDB distance table: " << distances.get_bits_per_entry()
+             << " bits per entry, " << distances.get_memory_in_bytes()
+             << " bytes" << endl;
+    }
+}
+
+PatternDatabase::PatternDatabase(
+    const Pattern &pattern,
+    const vector<size_t> &hash_multipliers,
+    const DistanceTable &distances)
+    : pattern(pattern),
+      num_states(distances.size()),
+      distances(distances),
+      hash_multipliers(hash_multipliers) {
+    assert(hash_multipliers.size() == pattern.size());
 }
 
 void PatternDatabase::multiply_out(
@@ -187,8 +204,139 @@ void PatternDatabase::build_abstract_operators(
                  variables, operators);
 }
 
+/*
+  Regression search with Dial's algorithm: states are kept in a circular
+  array of max_cost + 1 buckets indexed by their distance, so all
+  states with the current minimum distance form the frontier that is
+  expanded next. For unit costs, this is a layered breadth-first
+  search. The frontier is split into chunks that are expanded
+  concurrently; each chunk collects its candidate predecessors, which
+  are then merged in chunk order. Only the merge writes to distances,
+  so the result is the same for any number of threads.
+*/
+static void compute_distances_with_buckets(
+    const vector<AbstractOperator> &operators,
+    const MatchTree &match_tree,
+    int max_cost,
+    int num_threads,
+    vector<size_t> &goal_states,
+    DistanceTableBuilder &distances) {
+    const int chunk_size = 1024;
+    int num_buckets = max_cost + 1;
+    vector<vector<size_t>> buckets(num_buckets);
+    size_t num_queued = goal_states.size();
+    buckets[0].swap(goal_states);
+
+    vector<size_t> frontier;
+    vector<vector<int>> applicable_operator_ids_by_thread(
+        num_threads, vector<int>(match_tree.get_buffer_size()));
+    vector<vector<pair<size_t, int>>> predecessors_by_chunk;
+    for (int distance = 0; num_queued > 0; ++distance) {
+        vector<size_t> &bucket = buckets[distance % num_buckets];
+        // Zero-cost operators can add states to the current bucket.
+        while (!bucket.empty()) {
+            frontier.clear();
+            frontier.swap(bucket);
+            num_queued -= frontier.size();
+            // Skip states that have been reached more cheaply later on.
+            frontier.erase(
+                remove_if(frontier.begin(), frontier.end(),
+                          [&](size_t state_index) {
+                              return distances.get(state_index) != distance;
+                          }),
+                frontier.end());
+
+            int num_chunks = (frontier.size() + chunk_size - 1) / chunk_size;
+            if (static_cast<int>(predecessors_by_chunk.size()) < num_chunks)
+                predecessors_by_chunk.resize(num_chunks);
+            utils::parallel_for(
+                num_threads, num_chunks,
+                [&](int thread_id, int chunk) {
+                    vector<int> &applicable_operator_ids =
+                        applicable_operator_ids_by_thread[thread_id];
+                    vector<pair<size_t, int>> &predecessors =
+                        predecessors_by_chunk[chunk];
+                    predecessors.clear();
+                    size_t end = min(frontier.size(),
+                                     static_cast<size_t>(chunk + 1) * chunk_size);
+                    for (size_t i = static_cast<size_t>(chunk) * chunk_size; i < end; ++i) {
+                        size_t state_index = frontier[i];
+                        int num_applicable = match_tree.get_applicable_operator_ids(
+                            state_index, applicable_operator_ids.data());
+                        for (int j = 0; j < num_applicable; ++j) {
+                            const AbstractOperator &op =
+                                operators[applicable_operator_ids[j]];
+                            size_t predecessor = state_index + op.get_hash_effect();
+                            int alternative_cost = distance + op.get_cost();
+                            if (alternative_cost < distances.get(predecessor))
+                                predecessors.emplace_back(predecessor, alternative_cost);
+                        }
+                    }
+                });
+
+            for (int chunk = 0; chunk < num_chunks; ++chunk) {
+                for (const pair<size_t, int> &entry : predecessors_by_chunk[chunk]) {
+                    size_t predecessor = entry.first;
+                    int alternative_cost = entry.second;
+                    if (alternative_cost < distances.get(predecessor)) {
+                        distances.set(predecessor, alternative_cost);
+                        buckets[alternative_cost % num_buckets].push_back(predecessor);
+                        ++num_queued;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+  Dijkstra regression search for tasks whose operator costs are too
+  large for a bucket array.
+*/
+static void compute_distances_with_queue(
+    const vector<AbstractOperator> &operators,
+    const MatchTree &match_tree,
+    const vector<size_t> &goal_states,
+    DistanceTableBuilder &distances) {
+    // first implicit entry: priority, second entry: index for an abstract state
+    priority_queues::AdaptiveQueue<size_t> pq;
+    for (size_t state_index : goal_states) {
+        pq.push(0, state_index);
+    }
+
+    vector<int> applicable_operator_ids(match_tree.get_buffer_size());
+    while (!pq.empty()) {
+        pair<int, size_t> node = pq.pop();
+        int distance = node.first;
+        size_t state_index = node.second;
+        if (distance > distances.get(state_index)) {
+            continue;
+        }
+
+        // regress abstract_state
+        int num_applicable = match_tree.get_applicable_operator_ids(
+            state_index, applicable_operator_ids.data());
+        for (int i = 0; i < num_applicable; ++i) {
+            const AbstractOperator &op = operators[applicable_operator_ids[i]];
+            size_t predecessor = state_index + op.get_hash_effect();
+            int alternative_cost = distance + op.get_cost();
+            if (alternative_cost < distances.get(predecessor)) {
+                distances.set(predecessor, alternative_cost);
+                pq.push(alternative_cost, predecessor);
+            }
+        }
+    }
+}
+
 void PatternDatabase::create_pdb(
-    const TaskProxy &task_proxy, const vector<int> &operator_costs) {
+    const TaskProxy &task_proxy, const vector<int> &operator_costs,
+    int num_threads) {
+    /*
+      Larger operator costs are handled by a heap-based queue because
+      the number of buckets grows with the maximal operator cost.
+    */
+    const int max_cost_for_buckets = 1 << 16;
+
     VariablesProxy variables = task_proxy.get_variables();
     vector<int> variable_to_index(variables.size(), -1);
     for (size_t i = 0; i < pattern.size(); ++i) {
@@ -207,6 +355,10 @@ void PatternDatabase::create_pdb(
         build_abstract_operators(
             op, op_cost, variable_to_index, variables, operators);
     }
+    int max_cost = 0;
+    for (const AbstractOperator &op : operators) {
+        max_cost = max(max_cost, op.get_cost());
+    }
 
     // build the match tree
     MatchTree match_tree(task_proxy, pattern, hash_multipliers);
@@ -214,6 +366,7 @@ void PatternDatabase::create_pdb(
         const AbstractOperator &op = operators[op_id];
         match_tree.insert(op_id, op.get_regression_preconditions());
     }
+    match_tree.finalize();
 
     // compute abstract goal var-val pairs
     vector<FactPair> abstract_goals;
@@ -225,42 +378,24 @@ void PatternDatabase::create_pdb(
         }
     }
 
-    distances.reserve(num_states);
-    // first implicit entry: priority, second entry: index for an abstract state
-    priority_queues::AdaptiveQueue<size_t> pq;
-
-    // initialize queue
+    // The search writes its distances directly into packed entries.
+    DistanceTableBuilder builder(num_states);
+    vector<size_t> goal_states;
     for (size_t state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
-            pq.push(0, state_index);
-            distances.push_back(0);
-        } else {
-            distances.push_back(numeric_limits<int>::max());
+            goal_states.push_back(state_index);
+            builder.set(state_index, 0);
         }
     }
 
-    // Dijkstra loop
-    while (!pq.empty()) {
-        pair<int, size_t> node = pq.pop();
-        int distance = node.first;
-        size_t state_index = node.second;
-        if (distance > distances[state_index]) {
-            continue;
-        }
-
-        // regress abstract_state
-        vector<int> applicable_operator_ids;
-        match_tree.get_applicable_operator_ids(state_index, applicable_operator_ids);
-        for (int op_id : applicable_operator_ids) {
-            const AbstractOperator &op = operators[op_id];
-            size_t predecessor = state_index + op.get_hash_effect();
-            int alternative_cost = distances[state_index] + op.get_cost();
-            if (alternative_cost < distances[predecessor]) {
-                distances[predecessor] = alternative_cost;
-                pq.push(alternative_cost, predecessor);
-            }
-        }
+    if (max_cost <= max_cost_for_buckets) {
+        compute_distances_with_buckets(
+            operators, match_tree, max_cost, num_threads, goal_states, builder);
+    } else {
+        compute_distances_with_queue(
+            operators, match_tree, goal_states, builder);
     }
+    distances = builder.finish();
 }
 
 bool PatternDatabase::is_goal_state(
@@ -280,24 +415,29 @@ bool PatternDatabase::is_goal_state(
     return true;
 }
 
-size_t PatternDatabase::hash_index(const State &state) const {
+size_t PatternDatabase::hash_index(const int *state_values) const {
     size_t index = 0;
     for (size_t i = 0; i < pattern.size(); ++i) {
-        index += hash_multipliers[i] * state[pattern[i]].get_value();
+        index += hash_multipliers[i] * state_values[pattern[i]];
     }
     return index;
 }
 
 int PatternDatabase::get_value(const State &state) const {
-    return distances[hash_index(state)];
+    return get_value(state.get_values().data());
+}
+
+int PatternDatabase::get_value(const int *state_values) const {
+    return distances.get(hash_index(state_values));
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
     for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+        int distance = distances.get(i);
+        if (distance != numeric_limits<int>::max()) {
+            sum += distance;
             ++size;
         }
     }
@@ -1,6 +1,7 @@
 #ifndef PDBS_PATTERN_DATABASE_H
 #define PDBS_PATTERN_DATABASE_H
 
+#include "distance_table.h"
 #include "types.h"
 
 #include "../task_proxy.h"
@@ -77,10 +78,11 @@ class PatternDatabase {
     std::size_t num_states;
 
     /*
-      final h-values for abstract-states.
-      dead-ends are represented by numeric_limits<int>::max()
+      final h-values for abstract-states, packed into the smallest
+      possible entry width. Dead-ends are represented by
+      numeric_limits<int>::max()
     */
-    std::vector<int> distances;
+    DistanceTable distances;
 
     // multipliers for each variable for perfect hash function
     std::vector<std::size_t> hash_multipliers;
@@ -115,14 +117,17 @@ class PatternDatabase {
 
     /*
       Computes all abstract operators, builds the match tree (successor
-      generator) and then does a Dijkstra regression search to compute
-      all final h-values (stored in distances). operator_costs can
-      specify individual operator costs for each operator for action
-      cost partitioning. If left empty, default operator costs are used.
+      generator) and then does a regression search to compute all
+      final h-values (stored in distances). operator_costs can specify
+      individual operator costs for each operator for action cost
+      partitioning. If left empty, default operator costs are used.
+      The states of each search layer are expanded with up to
+      num_threads threads.
     */
     void create_pdb(
         const TaskProxy &task_proxy,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs,
+        int num_threads);
 
     /*
       For a given abstract state (given as index), the according values
@@ -140,7 +145,7 @@ class PatternDatabase {
       according abstract state. This is only used for table lookup
       (distances) during search.
     */
-    std::size_t hash_index(const State &state) const;
+    std::size_t hash_index(const int *state_values) const;
 public:
     /*
       Important: It is assumed that the pattern (passed via Options) is
@@ -151,21 +156,48 @@ public:
        operator_costs: Can specify individual operator costs for each
        operator. This is useful for action cost partitioning. If left
        empty, default operator costs are used.
+       num_threads:    Number of threads used for the regression search.
+       The resulting PDB does not depend on this value.
     */
     PatternDatabase(
         const TaskProxy &task_proxy,
         const Pattern &pattern,
         bool dump = false,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs = std::vector<int>(),
+        int num_threads = 1);
+    /*
+      Create a PDB from precomputed data, e.g., loaded by a PDBCache.
+      The distance table must have an entry for each abstract state.
+    */
+    PatternDatabase(
+        const Pattern &pattern,
+        const std::vector<std::size_t> &hash_multipliers,
+        const DistanceTable &distances);
     ~PatternDatabase() = default;
 
     int get_value(const State &state) const;
 
+    /*
+      Same as above for a state given by the values of all variables.
+      This avoids creating State objects for states that are stored
+      unpacked in a flat buffer.
+    */
+    int get_value(const int *state_values) const;
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
     }
 
+    // Returns the multipliers of the perfect hash function
+    const std::vector<std::size_t> &get_hash_multipliers() const {
+        return hash_multipliers;
+    }
+
+    const DistanceTable &get_distance_table() const {
+        return distances;
+    }
+
     // Returns the size (number of abstract states) of the PDB
     int get_size() const {
         return num_states;
@@ -0,0 +1,420 @@
+#include "pdb_cache.h"
+
+#include "distance_table.h"
+#include "pattern_database.h"
+
+#include "../option_parser.h"
+
+#include "../utils/hash.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#define PDB_CACHE_SUPPORTED
+#endif
+
+using namespace std;
+
+namespace pdbs {
+static const uint32_t PDB_FILE_MAGIC = 0x42445046;
+static const uint32_t PDB_FILE_VERSION = 3;
+static const string PDB_FILE_SUFFIX = ".pdb";
+
+/*
+  The file starts with this header, followed by the pattern (uint32_t
+  per variable, padded to a multiple of 8 bytes), the hash multipliers
+  (uint64_t per variable) and the words of the distance table.
+*/
+struct PDBFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t num_entries;
+    uint32_t pattern_size;
+    uint32_t bits_per_entry;
+    // Checksum over the fields above, the pattern and the hash multipliers.
+    uint64_t metadata_checksum;
+    // Checksum over the words of the distance table.
+    uint64_t table_checksum;
+};
+
+static size_t get_pattern_bytes(size_t pattern_size) {
+    return (pattern_size * sizeof(uint32_t) + 7) / 8 * 8;
+}
+
+static size_t get_file_size(const PDBFileHeader &header) {
+    size_t num_words = DistanceTable::compute_num_words(
+        header.num_entries, header.bits_per_entry);
+    return sizeof(PDBFileHeader) + get_pattern_bytes(header.pattern_size) +
+           header.pattern_size * sizeof(uint64_t) + num_words * sizeof(uint32_t);
+}
+
+static void feed_uint64(utils::HashState &hash_state, uint64_t value) {
+    hash_state.feed(static_cast<uint32_t>(value));
+    hash_state.feed(static_cast<uint32_t>(value >> 32));
+}
+
+static uint64_t compute_metadata_checksum(
+    const PDBFileHeader &header, const uint32_t *pattern,
+    const uint64_t *hash_multipliers) {
+    utils::HashState hash_state;
+    hash_state.feed(header.magic);
+    hash_state.feed(header.version);
+    feed_uint64(hash_state, header.key);
+    feed_uint64(hash_state, header.num_entries);
+    hash_state.feed(header.pattern_size);
+    hash_state.feed(header.bits_per_entry);
+    size_t pattern_size = header.pattern_size;
+    for (size_t i = 0; i < pattern_size; ++i) {
+        hash_state.feed(pattern[i]);
+    }
+    for (size_t i = 0; i < pattern_size; ++i) {
+        feed_uint64(hash_state, hash_multipliers[i]);
+    }
+    return hash_state.get_hash64();
+}
+
+static uint64_t compute_table_checksum(const uint32_t *words, size_t num_words) {
+    utils::HashState hash_state;
+    for (size_t i = 0; i < num_words; ++i) {
+        hash_state.feed(words[i]);
+    }
+    return hash_state.get_hash64();
+}
+
+static void feed_fact(utils::HashState &hash_state, const FactProxy &fact) {
+    hash_state.feed(fact.get_variable().get_id());
+    hash_state.feed(fact.get_value());
+}
+
+static uint64_t compute_task_fingerprint(const TaskProxy &task_proxy) {
+    utils::HashState hash_state;
+    VariablesProxy variables = task_proxy.get_variables();
+    hash_state.feed(variables.size());
+    for (VariableProxy var : variables) {
+        hash_state.feed(var.get_domain_size());
+    }
+    OperatorsProxy operators = task_proxy.get_operators();
+    hash_state.feed(operators.size());
+    for (OperatorProxy op : operators) {
+        PreconditionsProxy preconditions = op.get_preconditions();
+        hash_state.feed(preconditions.size());
+        for (FactProxy pre : preconditions) {
+            feed_fact(hash_state, pre);
+        }
+        EffectsProxy effects = op.get_effects();
+        hash_state.feed(effects.size());
+        for (EffectProxy effect : effects) {
+            EffectConditionsProxy conditions = effect.get_conditions();
+            hash_state.feed(conditions.size());
+            for (FactProxy condition : conditions) {
+                feed_fact(hash_state, condition);
+            }
+            feed_fact(hash_state, effect.get_fact());
+        }
+    }
+    GoalsProxy goals = task_proxy.get_goals();
+    hash_state.feed(goals.size());
+    for (FactProxy goal : goals) {
+        feed_fact(hash_state, goal);
+    }
+    return hash_state.get_hash64();
+}
+
+PDBCache::PDBCache(
+    const TaskProxy &task_proxy, const string &directory,
+    size_t max_size_in_bytes, bool verify_tables)
+    : task_proxy(task_proxy),
+      directory(directory),
+      max_size_in_bytes(max_size_in_bytes),
+      verify_tables(verify_tables),
+      task_fingerprint(compute_task_fingerprint(task_proxy)),
+      enabled(false),
+      num_hits(0),
+      num_misses(0) {
+#ifdef PDB_CACHE_SUPPORTED
+    if (mkdir(directory.c_str(), 0777) == 0 || errno == EEXIST) {
+        enabled = true;
+    } else {
+        cout << "Warning: could not create PDB cache directory " << directory
+             << ". Computing all PDBs from scratch." << endl;
+    }
+#else
+    cout << "Warning: the PDB cache is not supported on this system. "
+         << "Computing all PDBs from scratch." << endl;
+#endif
+}
+
+uint64_t PDBCache::compute_key(
+    const Pattern &pattern, const vector<int> &operator_costs) const {
+    utils::HashState hash_state;
+    feed_uint64(hash_state, task_fingerprint);
+    hash_state.feed(pattern.size());
+    for (int var : pattern) {
+        hash_state.feed(var);
+    }
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        int cost = operator_costs.empty() ? op.get_cost() : operator_costs[op.get_id()];
+        hash_state.feed(cost);
+    }
+    return hash_state.get_hash64();
+}
+
+string PDBCache::get_filename(uint64_t key) const {
+    ostringstream filename;
+    filename << directory << "/" << hex << setw(16) << setfill('0') << key
+             << PDB_FILE_SUFFIX;
+    return filename.str();
+}
+
+shared_ptr<PatternDatabase> PDBCache::get_pdb(
+    const Pattern &pattern, bool dump, const vector<int> &operator_costs,
+    int num_threads) {
+    if (!enabled) {
+        return make_shared<PatternDatabase>(
+            task_proxy, pattern, dump, operator_costs, num_threads);
+    }
+    uint64_t key = compute_key(pattern, operator_costs);
+    string filename = get_filename(key);
+    shared_ptr<PatternDatabase> pdb = load(filename, key, pattern);
+    if (pdb) {
+        ++num_hits;
+        if (dump)
+            cout << "Loaded PDB from " << filename << endl;
+        return pdb;
+    }
+    ++num_misses;
+    pdb = make_shared<PatternDatabase>(
+        task_proxy, pattern, dump, operator_costs, num_threads);
+    store(filename, key, *pdb);
+    evict(filename);
+    return pdb;
+}
+
+#ifdef PDB_CACHE_SUPPORTED
+shared_ptr<PatternDatabase> PDBCache::load(
+    const string &filename, uint64_t key, const Pattern &pattern) const {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    struct stat file_status;
+    if (fstat(fd, &file_status) != 0 ||
+        static_cast<size_t>(file_status.st_size) < sizeof(PDBFileHeader)) {
+        close(fd);
+        remove(filename.c_str());
+        return nullptr;
+    }
+    size_t file_size = file_status.st_size;
+    void *address = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+        return nullptr;
+    shared_ptr<const char> mapping(
+        static_cast<const char *>(address),
+        [file_size](const char *data) {
+            munmap(const_cast<char *>(data), file_size);
+        });
+
+    const char *data = mapping.get();
+    const PDBFileHeader &header = *reinterpret_cast<const PDBFileHeader *>(data);
+    bool valid = header.magic == PDB_FILE_MAGIC &&
+        header.version == PDB_FILE_VERSION &&
+        header.key == key &&
+        header.pattern_size == pattern.size() &&
+        (header.bits_per_entry == 4 || header.bits_per_entry == 8 ||
+         header.bits_per_entry == 16 || header.bits_per_entry == 32) &&
+        get_file_size(header) == file_size;
+    const uint32_t *pattern_data = reinterpret_cast<const uint32_t *>(
+        data + sizeof(PDBFileHeader));
+    const uint64_t *multipliers_data = reinterpret_cast<const uint64_t *>(
+        data + sizeof(PDBFileHeader) + get_pattern_bytes(pattern.size()));
+    const uint32_t *words_data = reinterpret_cast<const uint32_t *>(
+        multipliers_data + pattern.size());
+    if (valid) {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            if (pattern_data[i] != static_cast<uint32_t>(pattern[i]))
+                valid = false;
+        }
+    }
+    if (valid) {
+        // The table needs one entry per abstract state in the usual order.
+        VariablesProxy variables = task_proxy.get_variables();
+        size_t num_states = 1;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            if (multipliers_data[i] != num_states)
+                valid = false;
+            num_states *= variables[pattern[i]].get_domain_size();
+        }
+        if (header.num_entries != num_states)
+            valid = false;
+    }
+    if (valid) {
+        valid = compute_metadata_checksum(
+            header, pattern_data, multipliers_data) == header.metadata_checksum;
+    }
+    if (valid && verify_tables) {
+        // This reads the whole table, so we only do it on request.
+        size_t num_words = DistanceTable::compute_num_words(
+            header.num_entries, header.bits_per_entry);
+        valid = compute_table_checksum(words_data, num_words) ==
+            header.table_checksum;
+    }
+    if (!valid) {
+        cout << "Removing invalid PDB cache file " << filename << endl;
+        remove(filename.c_str());
+        return nullptr;
+    }
+
+    // Mark the file as recently used for eviction.
+    utime(filename.c_str(), nullptr);
+
+    vector<size_t> hash_multipliers(multipliers_data, multipliers_data + pattern.size());
+    // The words share ownership of the mapping.
+    shared_ptr<const uint32_t> words(mapping, words_data);
+    return make_shared<PatternDatabase>(
+        pattern, hash_multipliers,
+        DistanceTable(words, header.num_entries, header.bits_per_entry));
+}
+
+void PDBCache::store(
+    const string &filename, uint64_t key, const PatternDatabase &pdb) const {
+    const Pattern &pattern = pdb.get_pattern();
+    const DistanceTable &distances = pdb.get_distance_table();
+    vector<uint32_t> pattern_data(get_pattern_bytes(pattern.size()) / sizeof(uint32_t), 0);
+    copy(pattern.begin(), pattern.end(), pattern_data.begin());
+    vector<uint64_t> multipliers_data(
+        pdb.get_hash_multipliers().begin(), pdb.get_hash_multipliers().end());
+
+    PDBFileHeader header;
+    header.magic = PDB_FILE_MAGIC;
+    header.version = PDB_FILE_VERSION;
+    header.key = key;
+    header.num_entries = distances.size();
+    header.pattern_size = pattern.size();
+    header.bits_per_entry = distances.get_bits_per_entry();
+    header.metadata_checksum = compute_metadata_checksum(
+        header, pattern_data.data(), multipliers_data.data());
+    header.table_checksum = compute_table_checksum(
+        distances.get_words(), distances.get_num_words());
+
+    ostringstream temp_filename;
+    temp_filename << filename << ".tmp." << utils::get_process_id();
+    ofstream file(temp_filename.str(), ios::binary);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(pattern_data.data()),
+               pattern_data.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char *>(multipliers_data.data()),
+               multipliers_data.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char *>(distances.get_words()),
+               distances.get_num_words() * sizeof(uint32_t));
+    file.close();
+    if (!file || rename(temp_filename.str().c_str(), filename.c_str()) != 0) {
+        cout << "Warning: could not write PDB cache file " << filename << endl;
+        remove(temp_filename.str().c_str());
+    }
+}
+
+void PDBCache::evict(const string &keep_filename) const {
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+        return;
+    struct CacheFile {
+        time_t last_used;
+        string filename;
+        size_t size;
+        bool operator<(const CacheFile &other) const {
+            return last_used < other.last_used;
+        }
+    };
+    vector<CacheFile> files;
+    size_t total_size = 0;
+    while (struct dirent *entry = readdir(dir)) {
+        string name = entry->d_name;
+        if (name.size() <= PDB_FILE_SUFFIX.size() ||
+            name.compare(name.size() - PDB_FILE_SUFFIX.size(),
+                         PDB_FILE_SUFFIX.size(), PDB_FILE_SUFFIX) != 0)
+            continue;
+        string filename = directory + "/" + name;
+        struct stat file_status;
+        if (stat(filename.c_str(), &file_status) != 0)
+            continue;
+        files.push_back({file_status.st_mtime, filename,
+                         static_cast<size_t>(file_status.st_size)});
+        total_size += file_status.st_size;
+    }
+    closedir(dir);
+
+    sort(files.begin(), files.end());
+    for (const CacheFile &file : files) {
+        if (total_size <= max_size_in_bytes)
+            break;
+        if (file.filename == keep_filename)
+            continue;
+        if (remove(file.filename.c_str()) == 0)
+            total_size -= file.size;
+    }
+}
+#else
+shared_ptr<PatternDatabase> PDBCache::load(
+    const string &, uint64_t, const Pattern &) const {
+    return nullptr;
+}
+
+void PDBCache::store(const string &, uint64_t, const PatternDatabase &) const {
+}
+
+void PDBCache::evict(const string &) const {
+}
+#endif
+
+void PDBCache::print_statistics() const {
+    cout << "PDB cache hits: " << num_hits << endl;
+    cout << "PDB cache misses: " << num_misses << endl;
+}
+
+void add_pdb_cache_options_to_parser(options::OptionParser &parser) {
+    parser.add_option<string>(
+        "pdb_cache_dir",
+        "directory in which PDBs are cached across planner runs. "
+        "If not given, PDBs are not cached.",
+        options::OptionParser::NONE);
+    parser.add_option<int>(
+        "pdb_cache_max_size",
+        "maximal total size of all cached PDBs in MiB. When the cache grows "
+        "larger, the least recently used PDBs are removed.",
+        "1024",
+        options::Bounds("1", "infinity"));
+    parser.add_option<bool>(
+        "pdb_cache_verify",
+        "also verify the checksum of the distance table when loading a PDB "
+        "from the cache. The header, the table size and the file length are "
+        "always checked. Verifying the table reads the whole table, while "
+        "otherwise only the pages of the table that are looked up are read.",
+        "false");
+}
+
+shared_ptr<PDBCache> create_pdb_cache_from_options(
+    const options::Options &opts, const TaskProxy &task_proxy) {
+    if (!opts.contains("pdb_cache_dir"))
+        return nullptr;
+    size_t max_size_in_bytes =
+        static_cast<size_t>(opts.get<int>("pdb_cache_max_size")) << 20;
+    return make_shared<PDBCache>(
+        task_proxy, opts.get<string>("pdb_cache_dir"), max_size_in_bytes,
+        opts.get<bool>("pdb_cache_verify"));
+}
+}
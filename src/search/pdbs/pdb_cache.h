@@ -0,0 +1,89 @@
+#ifndef PDBS_PDB_CACHE_H
+#define PDBS_PDB_CACHE_H
+
+#include "types.h"
+
+#include "../task_proxy.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace pdbs {
+/*
+  Persistent cache for pattern databases that allows reusing PDBs across
+  planner runs, e.g., when running the same task repeatedly in a
+  portfolio.
+
+  Each PDB is stored in its own file in the cache directory. The file
+  name is derived from a fingerprint of the task (variable domains,
+  operators and goals), the operator costs used for the PDB and the
+  pattern. A file contains a header, the pattern, the hash multipliers
+  and the packed distance table. Files are memory-mapped when loading,
+  so that the distance table is only paged in as needed and shared
+  between processes. Files are written to a temporary file first and
+  then renamed, so concurrent planner runs never see partial files.
+
+  When loading, we always check the header, the file size, the size of
+  the distance table and the hash multipliers against the pattern, and a
+  checksum over the header, the pattern and the hash multipliers. The
+  checksum over the distance table is only verified on request
+  (verify_tables), since computing it reads the whole table. Invalid
+  files are removed and the PDB is recomputed.
+  After storing a PDB, the least recently used files are removed until
+  the total size of all cached PDBs is at most max_size_in_bytes.
+
+  The cache is only supported on Unix-like systems. On other systems,
+  it computes all PDBs from scratch.
+*/
+class PDBCache {
+    TaskProxy task_proxy;
+    std::string directory;
+    std::size_t max_size_in_bytes;
+    bool verify_tables;
+    std::uint64_t task_fingerprint;
+    bool enabled;
+
+    int num_hits;
+    int num_misses;
+
+    std::uint64_t compute_key(
+        const Pattern &pattern, const std::vector<int> &operator_costs) const;
+    std::string get_filename(std::uint64_t key) const;
+    std::shared_ptr<PatternDatabase> load(
+        const std::string &filename, std::uint64_t key, const Pattern &pattern) const;
+    void store(const std::string &filename, std::uint64_t key,
+               const PatternDatabase &pdb) const;
+    void evict(const std::string &keep_filename) const;
+public:
+    PDBCache(const TaskProxy &task_proxy, const std::string &directory,
+             std::size_t max_size_in_bytes, bool verify_tables);
+
+    /*
+      Return the PDB for the given pattern and operator costs from the
+      cache, or compute it and add it to the cache. The parameters are
+      the same as for the PatternDatabase constructor.
+    */
+    std::shared_ptr<PatternDatabase> get_pdb(
+        const Pattern &pattern,
+        bool dump = false,
+        const std::vector<int> &operator_costs = std::vector<int>(),
+        int num_threads = 1);
+
+    void print_statistics() const;
+};
+
+extern void add_pdb_cache_options_to_parser(options::OptionParser &parser);
+
+// Returns nullptr if no cache directory is given.
+extern std::shared_ptr<PDBCache> create_pdb_cache_from_options(
+    const options::Options &opts, const TaskProxy &task_proxy);
+}
+
+#endif
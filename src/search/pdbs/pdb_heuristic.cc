@@ -1,11 +1,14 @@
 #include "pdb_heuristic.h"
 
 #include "pattern_generator.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../task_proxy.h"
 
+#include "../utils/parallel_options.h"
+
 #include <limits>
 #include <memory>
 
@@ -18,7 +21,15 @@ PatternDatabase get_pdb_from_options(const shared_ptr<AbstractTask> &task,
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     Pattern pattern = pattern_generator->generate(task);
     TaskProxy task_proxy(*task);
-    return PatternDatabase(task_proxy, pattern, true);
+    int num_threads = utils::parse_num_threads_from_options(opts);
+    shared_ptr<PDBCache> cache = create_pdb_cache_from_options(opts, task_proxy);
+    if (cache) {
+        PatternDatabase pdb = *cache->get_pdb(
+            pattern, true, vector<int>(), num_threads);
+        cache->print_statistics();
+        return pdb;
+    }
+    return PatternDatabase(task_proxy, pattern, true, vector<int>(), num_threads);
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
@@ -27,7 +38,7 @@ PDBHeuristic::PDBHeuristic(const Options &opts)
 }
 
 int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -52,6 +63,8 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    utils::add_parallel_options(parser);
+    add_pdb_cache_options_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -1,21 +1,23 @@
 #include "zero_one_pdbs.h"
 
 #include "pattern_database.h"
+#include "pdb_cache.h"
 
 #include "../task_proxy.h"
 
 #include "../utils/logging.h"
 
 #include <iostream>
-#include <limits>
 #include <memory>
 #include <vector>
 
 using namespace std;
 
 namespace pdbs {
-ZeroOnePDBs::ZeroOnePDBs(
-    const TaskProxy &task_proxy, const PatternCollection &patterns) {
+static PDBCollection compute_zero_one_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    const shared_ptr<PDBCache> &cache) {
+    PDBCollection pattern_databases;
     vector<int> remaining_operator_costs;
     OperatorsProxy operators = task_proxy.get_operators();
     remaining_operator_costs.reserve(operators.size());
@@ -24,8 +26,13 @@ ZeroOnePDBs::ZeroOnePDBs(
 
     pattern_databases.reserve(patterns.size());
     for (const Pattern &pattern : patterns) {
-        shared_ptr<PatternDatabase> pdb = make_shared<PatternDatabase>(
-            task_proxy, pattern, false, remaining_operator_costs);
+        shared_ptr<PatternDatabase> pdb;
+        if (cache) {
+            pdb = cache->get_pdb(pattern, false, remaining_operator_costs);
+        } else {
+            pdb = make_shared<PatternDatabase>(
+                task_proxy, pattern, false, remaining_operator_costs);
+        }
 
         /* Set cost of relevant operators to 0 for further iterations
            (action cost partitioning). */
@@ -36,6 +43,14 @@ ZeroOnePDBs::ZeroOnePDBs(
 
         pattern_databases.push_back(pdb);
     }
+    return pattern_databases;
+}
+
+ZeroOnePDBs::ZeroOnePDBs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    const shared_ptr<PDBCache> &cache)
+    : pattern_databases(compute_zero_one_pdbs(task_proxy, patterns, cache)),
+      lookup(MaxAdditivePDBSubsets(1, pattern_databases)) {
 }
 
 
@@ -44,14 +59,7 @@ int ZeroOnePDBs::get_value(const State &state) const {
       Because we use cost partitioning, we can simply add up all
       heuristic values of all patterns in the pattern collection.
     */
-    int h_val = 0;
-    for (const shared_ptr<PatternDatabase> &pdb : pattern_databases) {
-        int pdb_value = pdb->get_value(state);
-        if (pdb_value == numeric_limits<int>::max())
-            return numeric_limits<int>::max();
-        h_val += pdb_value;
-    }
-    return h_val;
+    return lookup.get_value(state.get_values());
 }
 
 double ZeroOnePDBs::compute_approx_mean_finite_h() const {
@@ -1,16 +1,25 @@
 #ifndef PDBS_ZERO_ONE_PDBS_H
 #define PDBS_ZERO_ONE_PDBS_H
 
+#include "multi_pdb_lookup.h"
 #include "types.h"
 
+#include <memory>
+
 class State;
 class TaskProxy;
 
 namespace pdbs {
+class PDBCache;
+
 class ZeroOnePDBs {
     PDBCollection pattern_databases;
+    // Sums up the values of all PDBs.
+    MultiPDBLookup lookup;
 public:
-    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns);
+    // If a cache is given, the PDBs are looked up in and added to it.
+    ZeroOnePDBs(const TaskProxy &task_proxy, const PatternCollection &patterns,
+                const std::shared_ptr<PDBCache> &cache = nullptr);
     ~ZeroOnePDBs() = default;
 
     int get_value(const State &state) const;
@@ -1,6 +1,7 @@
 #include "zero_one_pdbs_heuristic.h"
 
 #include "pattern_generator.h"
+#include "pdb_cache.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -17,7 +18,11 @@ ZeroOnePDBs get_zero_one_pdbs_from_options(
     shared_ptr<PatternCollection> patterns =
         pattern_collection_info.get_patterns();
     TaskProxy task_proxy(*task);
-    return ZeroOnePDBs(task_proxy, *patterns);
+    shared_ptr<PDBCache> cache = create_pdb_cache_from_options(opts, task_proxy);
+    ZeroOnePDBs zero_one_pdbs(task_proxy, *patterns, cache);
+    if (cache)
+        cache->print_statistics();
+    return zero_one_pdbs;
 }
 
 ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
@@ -27,7 +32,7 @@ ZeroOnePDBsHeuristic::ZeroOnePDBsHeuristic(
 }
 
 int ZeroOnePDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
     return compute_heuristic(state);
 }
 
@@ -62,6 +67,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "patterns",
         "pattern generation method",
         "systematic(1)");
+    add_pdb_cache_options_to_parser(parser);
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
@@ -10,8 +10,12 @@ using namespace std;
 
 namespace potentials {
 PotentialFunction::PotentialFunction(
-    const vector<vector<double>> &fact_potentials)
-    : fact_potentials(fact_potentials) {
+    const vector<vector<double>> &fact_potentials) {
+    for (const vector<double> &var_potentials : fact_potentials) {
+        variable_offsets.push_back(potentials.size());
+        potentials.insert(
+            potentials.end(), var_potentials.begin(), var_potentials.end());
+    }
 }
 
 int PotentialFunction::get_value(const State &state) const {
@@ -19,11 +23,15 @@ int PotentialFunction::get_value(const State &state) const {
     for (FactProxy fact : state) {
         int var_id = fact.get_variable().get_id();
         int value = fact.get_value();
-        assert(utils::in_bounds(var_id, fact_potentials));
-        assert(utils::in_bounds(value, fact_potentials[var_id]));
-        heuristic_value += fact_potentials[var_id][value];
+        assert(utils::in_bounds(var_id, variable_offsets));
+        assert(utils::in_bounds(variable_offsets[var_id] + value, potentials));
+        heuristic_value += potentials[variable_offsets[var_id] + value];
     }
+    return round_potential_sum(heuristic_value);
+}
+
+int round_potential_sum(double sum) {
     const double epsilon = 0.01;
-    return static_cast<int>(ceil(heuristic_value - epsilon));
+    return static_cast<int>(ceil(sum - epsilon));
 }
 }
@@ -11,9 +11,13 @@ namespace potentials {
 
   We decouple potential functions from potential heuristics to avoid the
   overhead that is induced by evaluating heuristics whenever possible.
+
+  The potentials of all facts are stored consecutively, ordered by
+  variable and value.
 */
 class PotentialFunction {
-    const std::vector<std::vector<double>> fact_potentials;
+    std::vector<int> variable_offsets;
+    std::vector<double> potentials;
 
 public:
     explicit PotentialFunction(
@@ -21,7 +25,17 @@ public:
     ~PotentialFunction() = default;
 
     int get_value(const State &state) const;
+
+    double get_fact_potential(int var, int value) const {
+        return potentials[variable_offsets[var] + value];
+    }
 };
+
+/*
+  Round the sum of potentials of a state to a heuristic value. We allow
+  for small numerical errors of the LP solver.
+*/
+extern int round_potential_sum(double sum);
 }
 
 #endif
@@ -0,0 +1,52 @@
+#include "potential_matrix.h"
+
+#include "potential_function.h"
+
+#include "../task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace potentials {
+PotentialMatrix::PotentialMatrix(
+    const TaskProxy &task_proxy,
+    const vector<unique_ptr<PotentialFunction>> &functions)
+    : num_functions(functions.size()),
+      sums(num_functions) {
+    int num_facts = 0;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        variable_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+    }
+    potentials.reserve(num_facts * num_functions);
+    for (VariableProxy var : task_proxy.get_variables()) {
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            for (const unique_ptr<PotentialFunction> &function : functions) {
+                potentials.push_back(
+                    function->get_fact_potential(var.get_id(), value));
+            }
+        }
+    }
+}
+
+void PotentialMatrix::compute_sums(const State &state) const {
+    fill(sums.begin(), sums.end(), 0.0);
+    double *function_sums = sums.data();
+    int num_variables = variable_offsets.size();
+    for (int var = 0; var < num_variables; ++var) {
+        int fact = variable_offsets[var] + state[var].get_value();
+        const double *row = potentials.data() + fact * num_functions;
+        for (int i = 0; i < num_functions; ++i) {
+            function_sums[i] += row[i];
+        }
+    }
+}
+
+int PotentialMatrix::get_max_value(const State &state) const {
+    assert(num_functions > 0);
+    compute_sums(state);
+    return round_potential_sum(*max_element(sums.begin(), sums.end()));
+}
+}
@@ -0,0 +1,48 @@
+#ifndef POTENTIALS_POTENTIAL_MATRIX_H
+#define POTENTIALS_POTENTIAL_MATRIX_H
+
+#include <memory>
+#include <vector>
+
+class State;
+class TaskProxy;
+
+namespace potentials {
+class PotentialFunction;
+
+/*
+  Evaluate multiple potential functions at once.
+
+  The matrix has one row per fact that contains the potentials of the
+  fact in all functions. To evaluate a state, we add up the rows of its
+  facts. The inner loop runs over consecutive potentials of different
+  functions, so the compiler can vectorize it. Each function adds up its
+  potentials in the same order as PotentialFunction::get_value(), so the
+  sums are identical.
+*/
+class PotentialMatrix {
+    int num_functions;
+    std::vector<int> variable_offsets;
+    // potentials[fact * num_functions + i] holds the potential of fact in function i.
+    std::vector<double> potentials;
+    mutable std::vector<double> sums;
+
+    void compute_sums(const State &state) const;
+public:
+    PotentialMatrix(
+        const TaskProxy &task_proxy,
+        const std::vector<std::unique_ptr<PotentialFunction>> &functions);
+
+    int get_num_functions() const {
+        return num_functions;
+    }
+
+    /*
+      Return the maximum of the values of all functions. Rounding the
+      potential sums is monotonic, so we only round the maximal sum.
+    */
+    int get_max_value(const State &state) const;
+};
+}
+
+#endif
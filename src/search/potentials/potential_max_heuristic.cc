@@ -1,9 +1,12 @@
 #include "potential_max_heuristic.h"
 
 #include "potential_function.h"
+#include "potential_matrix.h"
 
 #include "../option_parser.h"
 
+#include "../utils/memory.h"
+
 using namespace std;
 
 namespace potentials {
@@ -11,15 +14,17 @@ PotentialMaxHeuristic::PotentialMaxHeuristic(
     const Options &opts,
     vector<unique_ptr<PotentialFunction>> &&functions)
     : Heuristic(opts),
-      functions(move(functions)) {
+      matrix(utils::make_unique_ptr<PotentialMatrix>(task_proxy, functions)) {
+}
+
+PotentialMaxHeuristic::~PotentialMaxHeuristic() {
 }
 
 int PotentialMaxHeuristic::compute_heuristic(const GlobalState &global_state) {
-    const State state = convert_global_state(global_state);
-    int value = 0;
-    for (auto &function : functions) {
-        value = max(value, function->get_value(state));
+    if (matrix->get_num_functions() == 0) {
+        return 0;
     }
-    return value;
+    const State &state = convert_global_state(global_state);
+    return max(0, matrix->get_max_value(state));
 }
 }
@@ -8,12 +8,13 @@
 
 namespace potentials {
 class PotentialFunction;
+class PotentialMatrix;
 
 /*
   Maximize over multiple potential functions.
 */
 class PotentialMaxHeuristic : public Heuristic {
-    std::vector<std::unique_ptr<PotentialFunction>> functions;
+    std::unique_ptr<PotentialMatrix> matrix;
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
@@ -22,7 +23,8 @@ public:
     explicit PotentialMaxHeuristic(
         const options::Options &opts,
         std::vector<std::unique_ptr<PotentialFunction>> &&functions);
-    ~PotentialMaxHeuristic() = default;
+    // Define in .cc file to avoid include in header.
+    ~PotentialMaxHeuristic();
 };
 }
 
@@ -31,12 +31,42 @@ bool contain_conflicting_fact(const vector<FactPair> &facts1,
     return false;
 }
 
+/*
+  We store a set as bitset if this needs less memory than a vector of
+  32-bit operator indices.
+*/
+static const int MIN_DENSE_FRACTION_INVERSE = 32;
+
+OperatorSet::OperatorSet()
+    : dense(false),
+      dense_ops(0) {
+}
+
+OperatorSet::OperatorSet(const OperatorBitset &ops)
+    : dense(static_cast<size_t>(ops.count()) * MIN_DENSE_FRACTION_INVERSE >=
+            ops.size()),
+      dense_ops(0) {
+    if (dense) {
+        dense_ops = ops;
+    } else {
+        for (size_t op_no = ops.find_first(); op_no != OperatorBitset::npos;
+             op_no = ops.find_next(op_no)) {
+            sparse_ops.push_back(op_no);
+        }
+    }
+}
+
 StubbornSets::StubbornSets(const options::Options &opts)
     : min_required_pruning_ratio(opts.get<double>("min_required_pruning_ratio")),
       num_expansions_before_checking_pruning_ratio(
           opts.get<int>("expansions_before_checking_pruning_ratio")),
       num_pruning_calls(0),
-      is_pruning_disabled(false) {
+      is_pruning_disabled(false),
+      num_pruning_calls_in_window(0),
+      num_unpruned_successors_in_window(0),
+      num_pruned_successors_in_window(0),
+      stubborn(0),
+      scratch_ops(0) {
 }
 
 void StubbornSets::initialize(const shared_ptr<AbstractTask> &task) {
@@ -50,6 +80,8 @@ void StubbornSets::initialize(const shared_ptr<AbstractTask> &task) {
     num_pruned_successors_generated = 0;
     sorted_goals = utils::sorted<FactPair>(
         task_properties::get_fact_pairs(task_proxy.get_goals()));
+    stubborn = OperatorBitset(num_operators);
+    scratch_ops = OperatorBitset(num_operators);
 
     compute_sorted_operators(task_proxy);
     compute_achievers(task_proxy);
@@ -86,52 +118,131 @@ void StubbornSets::compute_sorted_operators(const TaskProxy &task_proxy) {
 }
 
 void StubbornSets::compute_achievers(const TaskProxy &task_proxy) {
-    achievers = utils::map_vector<vector<vector<int>>>(
-        task_proxy.get_variables(), [](const VariableProxy &var) {
-            return vector<vector<int>>(var.get_domain_size());
-        });
+    /*
+      We collect the operators of each fact in vectors first to avoid
+      allocating a bitset over all operators for every fact.
+    */
+    vector<vector<vector<int>>> achiever_ids;
+    vector<vector<vector<int>>> precondition_of_ids;
+    for (const VariableProxy var : task_proxy.get_variables()) {
+        achiever_ids.emplace_back(var.get_domain_size());
+        precondition_of_ids.emplace_back(var.get_domain_size());
+    }
 
     for (const OperatorProxy op : task_proxy.get_operators()) {
         for (const EffectProxy effect : op.get_effects()) {
             FactPair fact = effect.get_fact().get_pair();
-            achievers[fact.var][fact.value].push_back(op.get_id());
+            achiever_ids[fact.var][fact.value].push_back(op.get_id());
+        }
+        for (const FactProxy pre : op.get_preconditions()) {
+            FactPair fact = pre.get_pair();
+            precondition_of_ids[fact.var][fact.value].push_back(op.get_id());
+        }
+    }
+
+    auto create_operator_sets = [&](const vector<vector<vector<int>>> &ids) {
+            return utils::map_vector<vector<OperatorSet>>(
+                ids, [&](const vector<vector<int>> &ids_by_value) {
+                    return utils::map_vector<OperatorSet>(
+                        ids_by_value, [&](const vector<int> &op_ids) {
+                            for (int op_no : op_ids) {
+                                scratch_ops.set(op_no);
+                            }
+                            return extract_operators(-1);
+                        });
+                });
+        };
+    achievers = create_operator_sets(achiever_ids);
+    precondition_of = create_operator_sets(precondition_of_ids);
+}
+
+void StubbornSets::add_contradicting_operators(
+    const vector<vector<OperatorSet>> &ops_by_fact,
+    const vector<FactPair> &facts) {
+    for (const FactPair &fact : facts) {
+        const vector<OperatorSet> &ops_by_value = ops_by_fact[fact.var];
+        int num_values = ops_by_value.size();
+        for (int value = 0; value < num_values; ++value) {
+            if (value != fact.value) {
+                ops_by_value[value].add_to(scratch_ops);
+            }
         }
     }
 }
 
+OperatorSet StubbornSets::extract_operators(int op_no) {
+    if (op_no != -1) {
+        scratch_ops.reset(op_no);
+    }
+    OperatorSet ops(scratch_ops);
+    scratch_ops.reset();
+    return ops;
+}
+
+OperatorSet StubbornSets::compute_disabled_operators(int op_no) {
+    add_contradicting_operators(precondition_of, sorted_op_effects[op_no]);
+    return extract_operators(op_no);
+}
+
+OperatorSet StubbornSets::compute_conflicting_and_disabling_operators(int op_no) {
+    add_contradicting_operators(achievers, sorted_op_effects[op_no]);
+    add_contradicting_operators(achievers, sorted_op_preconditions[op_no]);
+    return extract_operators(op_no);
+}
+
+OperatorSet StubbornSets::compute_interfering_operators(int op_no) {
+    add_contradicting_operators(precondition_of, sorted_op_effects[op_no]);
+    add_contradicting_operators(achievers, sorted_op_effects[op_no]);
+    add_contradicting_operators(achievers, sorted_op_preconditions[op_no]);
+    return extract_operators(op_no);
+}
+
 bool StubbornSets::mark_as_stubborn(int op_no) {
-    if (!stubborn[op_no]) {
-        stubborn[op_no] = true;
+    if (!stubborn.test(op_no)) {
+        stubborn.set(op_no);
         stubborn_queue.push_back(op_no);
         return true;
     }
     return false;
 }
 
+void StubbornSets::check_pruning_ratio() {
+    double pruning_ratio = (num_unpruned_successors_in_window == 0) ? 1. : 1. - (
+        static_cast<double>(num_pruned_successors_in_window) /
+        static_cast<double>(num_unpruned_successors_in_window));
+    if (pruning_ratio < min_required_pruning_ratio) {
+        cout << "Pruning ratio of the last "
+             << num_expansions_before_checking_pruning_ratio << " calls after "
+             << num_pruning_calls << " calls: " << pruning_ratio << endl;
+        cout << "-- pruning ratio is lower than minimum pruning ratio ("
+             << min_required_pruning_ratio << ") -> switching off pruning" << endl;
+        is_pruning_disabled = true;
+    }
+    num_pruning_calls_in_window = 0;
+    num_unpruned_successors_in_window = 0;
+    num_pruned_successors_in_window = 0;
+}
+
 void StubbornSets::prune_operators(
     const State &state, vector<OperatorID> &op_ids) {
     if (is_pruning_disabled) {
         return;
     }
     if (min_required_pruning_ratio > 0. &&
-        num_pruning_calls == num_expansions_before_checking_pruning_ratio) {
-        double pruning_ratio = (num_unpruned_successors_generated == 0) ? 1. : 1. - (
-            static_cast<double>(num_pruned_successors_generated) /
-            static_cast<double>(num_unpruned_successors_generated));
-        cout << "Pruning ratio after " << num_expansions_before_checking_pruning_ratio
-             << " calls: " << pruning_ratio << endl;
-        if (pruning_ratio < min_required_pruning_ratio) {
-            cout << "-- pruning ratio is lower than minimum pruning ratio ("
-                 << min_required_pruning_ratio << ") -> switching off pruning" << endl;
-            is_pruning_disabled = true;
+        num_pruning_calls_in_window == num_expansions_before_checking_pruning_ratio) {
+        check_pruning_ratio();
+        if (is_pruning_disabled) {
+            return;
         }
     }
 
     num_unpruned_successors_generated += op_ids.size();
+    num_unpruned_successors_in_window += op_ids.size();
     ++num_pruning_calls;
+    ++num_pruning_calls_in_window;
 
     // Clear stubborn set from previous call.
-    stubborn.assign(num_operators, false);
+    stubborn.reset();
     assert(stubborn_queue.empty());
 
     initialize_stubborn_set(state);
@@ -147,13 +258,14 @@ void StubbornSets::prune_operators(
     vector<OperatorID> remaining_op_ids;
     remaining_op_ids.reserve(op_ids.size());
     for (OperatorID op_id : op_ids) {
-        if (stubborn[op_id.get_index()]) {
+        if (stubborn.test(op_id.get_index())) {
             remaining_op_ids.emplace_back(op_id);
         }
     }
     op_ids.swap(remaining_op_ids);
 
     num_pruned_successors_generated += op_ids.size();
+    num_pruned_successors_in_window += op_ids.size();
 }
 
 void StubbornSets::print_statistics() const {
@@ -161,6 +273,10 @@ void StubbornSets::print_statistics() const {
          << num_unpruned_successors_generated << endl
          << "total successors after partial-order reduction: "
          << num_pruned_successors_generated << endl;
+    if (is_pruning_disabled) {
+        cout << "partial-order reduction switched off after "
+             << num_pruning_calls << " calls" << endl;
+    }
 }
 
 void add_pruning_options(options::OptionParser &parser) {
@@ -172,26 +288,29 @@ void add_pruning_options(options::OptionParser &parser) {
         " outweighs the increased computational costs depends on the task at"
         " hand. Using the options 'min_required_pruning_ratio' (M) and"
         " 'expansions_before_checking_pruning_ratio' (E) it is possible to"
-        " automatically disable pruning after E expansions if the ratio of"
-        " pruned vs. non-pruned operators is lower than M. In detail, let B and"
-        " A be the total number of operators before and after pruning summed"
-        " over all previous expansions. We call 1-(A/B) the pruning ratio R. If"
-        " R is lower than M after E expansions, we disable pruning for all"
-        " subsequent expansions, i.e., consider all applicable operators when"
-        " generating successor states. By default, pruning is never disabled"
+        " automatically disable pruning if the ratio of pruned vs. non-pruned"
+        " operators is lower than M. In detail, we divide the expansions into"
+        " windows of E expansions. At the end of each window, let B and A be"
+        " the total number of operators before and after pruning summed over"
+        " the expansions of the window. We call 1-(A/B) the pruning ratio R."
+        " If R is lower than M, we disable pruning for all subsequent"
+        " expansions, i.e., consider all applicable operators when generating"
+        " successor states. By default, pruning is never disabled"
         " (min_required_pruning_ratio = 0.0). In experiments on IPC benchmarks,"
         " stronger results have been observed with automatic disabling"
         " (min_required_pruning_ratio = 0.2,"
         " expansions_before_checking_pruning_ratio=1000).");
     parser.add_option<double>(
         "min_required_pruning_ratio",
-        "disable pruning if the pruning ratio is lower than this value after"
-        " 'expansions_before_checking_pruning_ratio' expansions",
+        "disable pruning if the pruning ratio of a window of"
+        " 'expansions_before_checking_pruning_ratio' expansions is lower than"
+        " this value",
         "0.0",
         Bounds("0.0", "1.0"));
     parser.add_option<int>(
         "expansions_before_checking_pruning_ratio",
-        "number of expansions before deciding whether to disable pruning",
+        "number of expansions in each window after which we decide whether"
+        " to disable pruning",
         "1000",
         Bounds("0", "infinity"));
 }
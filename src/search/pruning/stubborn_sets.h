@@ -4,14 +4,81 @@
 #include "../abstract_task.h"
 #include "../pruning_method.h"
 
+#include "../algorithms/dynamic_bitset.h"
+
+#include <cstdint>
+
 namespace options {
 class OptionParser;
 }
 
 namespace stubborn_sets {
+using OperatorBitset = dynamic_bitset::DynamicBitset<uint64_t>;
+
 inline FactPair find_unsatisfied_condition(
     const std::vector<FactPair> &conditions, const State &state);
 
+/*
+  Set of operator indices. Sets that contain at least 1/32 of all
+  operators are stored as bitsets over all operators, so they can be added
+  to other bitsets with word-parallel operations. Smaller sets are stored
+  as sorted vectors, since the bitsets would need more memory.
+*/
+class OperatorSet {
+    bool dense;
+    std::vector<int> sparse_ops;
+    OperatorBitset dense_ops;
+public:
+    OperatorSet();
+    // Create the set from the set bits of ops, which are left unchanged.
+    explicit OperatorSet(const OperatorBitset &ops);
+
+    /*
+      Add all operators of this set that are contained in mask (if given)
+      to ops and call visit(op_no) in increasing order for each operator
+      that was not contained in ops before.
+    */
+    template<typename Visitor>
+    void add_to(OperatorBitset &ops, const OperatorBitset *mask,
+                const Visitor &visit) const {
+        if (dense) {
+            ops.set_and_visit_new(dense_ops, mask, visit);
+        } else {
+            for (int op_no : sparse_ops) {
+                if ((!mask || mask->test(op_no)) && !ops.test(op_no)) {
+                    ops.set(op_no);
+                    visit(op_no);
+                }
+            }
+        }
+    }
+
+    void add_to(OperatorBitset &ops) const {
+        add_to(ops, nullptr, [](int) {});
+    }
+
+    /*
+      Call visit(op_no) in increasing order for all operators of this set
+      that are contained in mask (if given).
+    */
+    template<typename Visitor>
+    void for_each(const OperatorBitset *mask, const Visitor &visit) const {
+        if (dense) {
+            for (size_t op_no = dense_ops.find_first();
+                 op_no != OperatorBitset::npos;
+                 op_no = dense_ops.find_next(op_no)) {
+                if (!mask || mask->test(op_no))
+                    visit(op_no);
+            }
+        } else {
+            for (int op_no : sparse_ops) {
+                if (!mask || mask->test(op_no))
+                    visit(op_no);
+            }
+        }
+    }
+};
+
 class StubbornSets : public PruningMethod {
     const double min_required_pruning_ratio;
     const int num_expansions_before_checking_pruning_ratio;
@@ -21,9 +88,17 @@ class StubbornSets : public PruningMethod {
     long num_unpruned_successors_generated;
     long num_pruned_successors_generated;
 
-    /* stubborn[op_no] is true iff the operator with operator index
-       op_no is contained in the stubborn set */
-    std::vector<bool> stubborn;
+    /*
+      Number of calls and successors since the pruning ratio was checked
+      the last time.
+    */
+    int num_pruning_calls_in_window;
+    long num_unpruned_successors_in_window;
+    long num_pruned_successors_in_window;
+
+    /* stubborn contains the operator indices of the operators in the
+       stubborn set */
+    OperatorBitset stubborn;
 
     /*
       stubborn_queue contains the operator indices of operators that
@@ -33,8 +108,22 @@ class StubbornSets : public PruningMethod {
     */
     std::vector<int> stubborn_queue;
 
+    // Buffer for computing operator sets.
+    OperatorBitset scratch_ops;
+
     void compute_sorted_operators(const TaskProxy &task_proxy);
     void compute_achievers(const TaskProxy &task_proxy);
+    void check_pruning_ratio();
+
+    /*
+      Add the operators of ops_by_fact[var][value] to scratch_ops for all
+      values that contradict one of the given facts.
+    */
+    void add_contradicting_operators(
+        const std::vector<std::vector<OperatorSet>> &ops_by_fact,
+        const std::vector<FactPair> &facts);
+    // Return the operators in scratch_ops except op_no and clear scratch_ops.
+    OperatorSet extract_operators(int op_no);
 
 protected:
     /*
@@ -48,11 +137,27 @@ protected:
 
     /* achievers[var][value] contains all operator indices of
        operators that achieve the fact (var, value). */
-    std::vector<std::vector<std::vector<int>>> achievers;
+    std::vector<std::vector<OperatorSet>> achievers;
+    /* precondition_of[var][value] contains all operator indices of
+       operators with the precondition (var, value). */
+    std::vector<std::vector<OperatorSet>> precondition_of;
 
     bool can_disable(int op1_no, int op2_no) const;
     bool can_conflict(int op1_no, int op2_no) const;
 
+    /*
+      The following methods return sets of operators other than op_no.
+      Instead of testing all pairs of operators, they compute unions of the
+      achievers and precondition_of sets of the facts that contradict the
+      preconditions and effects of op_no.
+    */
+    // Operators that op_no can disable.
+    OperatorSet compute_disabled_operators(int op_no);
+    // Operators that can conflict with op_no or that can disable op_no.
+    OperatorSet compute_conflicting_and_disabling_operators(int op_no);
+    // Operators that interfere with op_no.
+    OperatorSet compute_interfering_operators(int op_no);
+
     /*
       Return the first unsatified goal pair,
       or FactPair::no_fact if there is none.
@@ -88,6 +193,23 @@ protected:
     // Returns true iff the operators was enqueued.
     // TODO: rename to enqueue_stubborn_operator?
     bool mark_as_stubborn(int op_no);
+
+    /*
+      Mark all operators of ops that are contained in mask (if given) as
+      stubborn and call visit(op_no) for each operator that was enqueued.
+    */
+    template<typename Visitor>
+    void mark_as_stubborn(const OperatorSet &ops, const OperatorBitset *mask,
+                          const Visitor &visit) {
+        ops.add_to(stubborn, mask, [&](int op_no) {
+                stubborn_queue.push_back(op_no);
+                visit(op_no);
+            });
+    }
+
+    void mark_as_stubborn(const OperatorSet &ops) {
+        mark_as_stubborn(ops, nullptr, [](int) {});
+    }
     virtual void initialize_stubborn_set(const State &state) = 0;
     virtual void handle_stubborn_operator(const State &state, int op_no) = 0;
 public:
@@ -105,7 +105,8 @@ void get_conflicting_vars(const vector<FactPair> &facts1,
 }
 
 StubbornSetsEC::StubbornSetsEC(const options::Options &opts)
-    : StubbornSets(opts) {
+    : StubbornSets(opts),
+      active_ops(0) {
 }
 
 void StubbornSetsEC::initialize(const shared_ptr<AbstractTask> &task) {
@@ -117,7 +118,7 @@ void StubbornSetsEC::initialize(const shared_ptr<AbstractTask> &task) {
         variables, [](const VariableProxy &var) {
             return vector<bool>(var.get_domain_size(), false);
         });
-    active_ops.assign(num_operators, false);
+    active_ops = stubborn_sets::OperatorBitset(num_operators);
     compute_operator_preconditions(task_proxy);
     build_reachability_map(task_proxy);
 
@@ -159,7 +160,7 @@ void StubbornSetsEC::build_reachability_map(const TaskProxy &task_proxy) {
 }
 
 void StubbornSetsEC::compute_active_operators(const State &state) {
-    active_ops.assign(active_ops.size(), false);
+    active_ops.reset();
 
     for (int op_no = 0; op_no < num_operators; ++op_no) {
         bool all_preconditions_are_active = true;
@@ -176,77 +177,60 @@ void StubbornSetsEC::compute_active_operators(const State &state) {
         }
 
         if (all_preconditions_are_active) {
-            active_ops[op_no] = true;
+            active_ops.set(op_no);
         }
     }
 }
 
-const vector<int> &StubbornSetsEC::get_conflicting_and_disabling(int op1_no) {
-    vector<int> &result = conflicting_and_disabling[op1_no];
+const stubborn_sets::OperatorSet &StubbornSetsEC::get_conflicting_and_disabling(
+    int op1_no) {
     if (!conflicting_and_disabling_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no) {
-                bool conflict = can_conflict(op1_no, op2_no);
-                bool disable = can_disable(op2_no, op1_no);
-                if (conflict || disable) {
-                    result.push_back(op2_no);
-                }
-            }
-        }
-        result.shrink_to_fit();
+        conflicting_and_disabling[op1_no] =
+            compute_conflicting_and_disabling_operators(op1_no);
         conflicting_and_disabling_computed[op1_no] = true;
     }
-    return result;
+    return conflicting_and_disabling[op1_no];
 }
 
-const vector<int> &StubbornSetsEC::get_disabled(int op1_no) {
-    vector<int> &result = disabled[op1_no];
+const stubborn_sets::OperatorSet &StubbornSetsEC::get_disabled(int op1_no) {
     if (!disabled_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op2_no != op1_no && can_disable(op1_no, op2_no)) {
-                result.push_back(op2_no);
-            }
-        }
-        result.shrink_to_fit();
+        disabled[op1_no] = compute_disabled_operators(op1_no);
         disabled_computed[op1_no] = true;
     }
-    return result;
+    return disabled[op1_no];
 }
 
 bool StubbornSetsEC::is_applicable(int op_no, const State &state) const {
     return find_unsatisfied_precondition(op_no, state) == FactPair::no_fact;
 }
 
-// TODO: find a better name.
-void StubbornSetsEC::mark_as_stubborn_and_remember_written_vars(
-    int op_no, const State &state) {
-    if (mark_as_stubborn(op_no)) {
-        if (is_applicable(op_no, state)) {
-            for (const FactPair &effect : sorted_op_effects[op_no])
-                written_vars[effect.var] = true;
-        }
+// Must be called for each operator that is marked as stubborn.
+void StubbornSetsEC::remember_written_vars(int op_no, const State &state) {
+    if (is_applicable(op_no, state)) {
+        for (const FactPair &effect : sorted_op_effects[op_no])
+            written_vars[effect.var] = true;
     }
 }
 
 /* TODO: think about a better name, which distinguishes this method
    better from the corresponding method for simple stubborn sets */
 void StubbornSetsEC::add_nes_for_fact(const FactPair &fact, const State &state) {
-    for (int achiever : achievers[fact.var][fact.value]) {
-        if (active_ops[achiever]) {
-            mark_as_stubborn_and_remember_written_vars(achiever, state);
-        }
-    }
+    mark_as_stubborn(
+        achievers[fact.var][fact.value], &active_ops,
+        [&](int achiever) {
+            remember_written_vars(achiever, state);
+        });
 
     nes_computed[fact.var][fact.value] = true;
 }
 
 void StubbornSetsEC::add_conflicting_and_disabling(int op_no,
                                                    const State &state) {
-    for (int conflict : get_conflicting_and_disabling(op_no)) {
-        if (active_ops[conflict]) {
-            mark_as_stubborn_and_remember_written_vars(conflict, state);
-        }
-    }
+    mark_as_stubborn(
+        get_conflicting_and_disabling(op_no), &active_ops,
+        [&](int conflict) {
+            remember_written_vars(conflict, state);
+        });
 }
 
 // Relies on op_effects and op_preconditions being sorted by variable.
@@ -295,31 +279,30 @@ void StubbornSetsEC::handle_stubborn_operator(const State &state, int op_no) {
         add_conflicting_and_disabling(op_no, state);     // active operators used
         //Rule S4'
         vector<int> disabled_vars;
-        for (int disabled_op_no : get_disabled(op_no)) {
-            if (active_ops[disabled_op_no]) {
+        get_disabled(op_no).for_each(
+            &active_ops, [&](int disabled_op_no) {
                 get_disabled_vars(op_no, disabled_op_no, disabled_vars);
-                if (!disabled_vars.empty()) {     // == can_disable(op1_no, op2_no)
-                    bool v_applicable_op_found = false;
-                    for (int disabled_var : disabled_vars) {
-                        //First case: add o'
-                        if (is_v_applicable(disabled_var,
-                                            disabled_op_no,
-                                            state,
-                                            op_preconditions_on_var)) {
-                            mark_as_stubborn_and_remember_written_vars(
-                                disabled_op_no, state);
-                            v_applicable_op_found = true;
-                            break;
+                assert(!disabled_vars.empty());     // == can_disable(op1_no, op2_no)
+                bool v_applicable_op_found = false;
+                for (int disabled_var : disabled_vars) {
+                    //First case: add o'
+                    if (is_v_applicable(disabled_var,
+                                        disabled_op_no,
+                                        state,
+                                        op_preconditions_on_var)) {
+                        if (mark_as_stubborn(disabled_op_no)) {
+                            remember_written_vars(disabled_op_no, state);
                         }
+                        v_applicable_op_found = true;
+                        break;
                     }
+                }
 
-                    //Second case: add a necessary enabling set for o' following S5
-                    if (!v_applicable_op_found) {
-                        apply_s5(disabled_op_no, state);
-                    }
+                //Second case: add a necessary enabling set for o' following S5
+                if (!v_applicable_op_found) {
+                    apply_s5(disabled_op_no, state);
                 }
-            }
-        }
+            });
     } else {     // op is inapplicable
         //S5
         apply_s5(op_no, state);
@@ -20,37 +20,23 @@ void StubbornSetsSimple::initialize(const shared_ptr<AbstractTask> &task) {
     cout << "pruning method: stubborn sets simple" << endl;
 }
 
-const vector<int> &StubbornSetsSimple::get_interfering_operators(int op1_no) {
-    /*
-       TODO: as interference is symmetric, we only need to compute the
-       relation for operators (o1, o2) with (o1 < o2) and add a lookup
-       method that looks up (i, j) if i < j and (j, i) otherwise.
-    */
-    vector<int> &interfere_op1 = interference_relation[op1_no];
+const stubborn_sets::OperatorSet &StubbornSetsSimple::get_interfering_operators(
+    int op1_no) {
     if (!interference_relation_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no && interfere(op1_no, op2_no)) {
-                interfere_op1.push_back(op2_no);
-            }
-        }
-        interfere_op1.shrink_to_fit();
+        interference_relation[op1_no] = compute_interfering_operators(op1_no);
         interference_relation_computed[op1_no] = true;
     }
-    return interfere_op1;
+    return interference_relation[op1_no];
 }
 
 // Add all operators that achieve the fact (var, value) to stubborn set.
 void StubbornSetsSimple::add_necessary_enabling_set(const FactPair &fact) {
-    for (int op_no : achievers[fact.var][fact.value]) {
-        mark_as_stubborn(op_no);
-    }
+    mark_as_stubborn(achievers[fact.var][fact.value]);
 }
 
 // Add all operators that interfere with op.
 void StubbornSetsSimple::add_interfering(int op_no) {
-    for (int interferer_no : get_interfering_operators(op_no)) {
-        mark_as_stubborn(interferer_no);
-    }
+    mark_as_stubborn(get_interfering_operators(op_no));
 }
 
 void StubbornSetsSimple::initialize_stubborn_set(const State &state) {
@@ -155,7 +155,7 @@ int RedBlackHeuristic::compute_heuristic(const GlobalState &global_state) {
     if (task_properties::is_goal_state(task_proxy, global_state)) {
         return 0;
     }
-    State state = convert_global_state(global_state);
+    const State &state = convert_global_state(global_state);
 
     int h_ff = compute_sequential_relaxed_plan(state);
     if (h_ff == DEAD_END) {
@@ -5,7 +5,7 @@
 #include "option_parser.h"
 #include "plugin.h"
 
-#include "algorithms/ordered_set.h"
+#include "algorithms/stamped_ordered_set.h"
 #include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
 #include "tasks/root_task.h"
@@ -23,12 +23,19 @@ using utils::ExitCode;
 
 class PruningMethod;
 
-successor_generator::SuccessorGenerator &get_successor_generator(const TaskProxy &task_proxy) {
+successor_generator::SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, successor_generator::SuccessorGeneratorType type,
+    unique_ptr<successor_generator::SuccessorGenerator> &own_generator) {
     cout << "Building successor generator..." << flush;
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
+    if (type == successor_generator::SuccessorGeneratorType::INCREMENTAL) {
+        own_generator =
+            successor_generator::create_incremental_successor_generator(task_proxy);
+    }
     successor_generator::SuccessorGenerator &successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        own_generator ? *own_generator :
+        successor_generator::get_successor_generator(task_proxy, type);
     successor_generator_timer.stop();
     cout << "done! [t=" << utils::g_timer << "]" << endl;
     int peak_memory_after = utils::get_peak_memory_in_kb();
@@ -45,9 +52,20 @@ SearchEngine::SearchEngine(const Options &opts)
       solution_found(false),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(task_proxy),
-      successor_generator(get_successor_generator(task_proxy)),
-      search_space(state_registry),
+      state_registry(
+          task_proxy,
+          opts.contains("state_storage_dir") ?
+          opts.get<string>("state_storage_dir") : "",
+          static_cast<size_t>(opts.get<int>("state_storage_memory")) << 20),
+      successor_generator(
+          ::get_successor_generator(
+              task_proxy,
+              static_cast<successor_generator::SuccessorGeneratorType>(
+                  opts.get_enum("successor_generator")),
+              own_successor_generator)),
+      search_space(state_registry, successor_generator,
+                   static_cast<SearchSpaceMode>(opts.get_enum("search_space")),
+                   static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
       max_time(opts.get<double>("max_time")) {
@@ -138,6 +156,9 @@ void SearchEngine::add_pruning_option(OptionParser &parser) {
 
 void SearchEngine::add_options_to_parser(OptionParser &parser) {
     ::add_cost_type_option_to_parser(parser);
+    successor_generator::add_successor_generator_option_to_parser(parser);
+    add_search_space_option_to_parser(parser);
+    add_state_storage_options_to_parser(parser);
     parser.add_option<int>(
         "bound",
         "exclusive depth bound on g-values. Cutoffs are always performed according to "
@@ -183,6 +204,12 @@ void print_initial_evaluator_values(const EvaluationContext &eval_context) {
         );
 }
 
+void print_evaluator_statistics(const set<const Evaluator *> &evals) {
+    for (const Evaluator *eval : evals) {
+        eval->print_statistics();
+    }
+}
+
 static PluginTypePlugin<SearchEngine> _type_plugin(
     "SearchEngine",
     // TODO: Replace empty string by synopsis for the wiki page.
@@ -191,7 +218,7 @@ static PluginTypePlugin<SearchEngine> _type_plugin(
 void collect_preferred_operators(
     EvaluationContext &eval_context,
     Evaluator *preferred_operator_evaluator,
-    ordered_set::OrderedSet<OperatorID> &preferred_operators) {
+    stamped_ordered_set::StampedOrderedSet<OperatorID> &preferred_operators) {
     if (!eval_context.is_evaluator_value_infinite(preferred_operator_evaluator)) {
         for (OperatorID op_id : eval_context.get_preferred_operators(preferred_operator_evaluator)) {
             preferred_operators.insert(op_id);
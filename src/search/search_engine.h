@@ -10,6 +10,8 @@
 #include "state_registry.h"
 #include "task_proxy.h"
 
+#include <memory>
+#include <set>
 #include <vector>
 
 namespace options {
@@ -17,9 +19,9 @@ class OptionParser;
 class Options;
 }
 
-namespace ordered_set {
+namespace stamped_ordered_set {
 template<typename T>
-class OrderedSet;
+class StampedOrderedSet;
 }
 
 namespace successor_generator {
@@ -40,6 +42,8 @@ protected:
 
     PlanManager plan_manager;
     StateRegistry state_registry;
+    // Only set for successor generators that cannot be shared between searches.
+    std::unique_ptr<successor_generator::SuccessorGenerator> own_successor_generator;
     const successor_generator::SuccessorGenerator &successor_generator;
     SearchSpace search_space;
     SearchProgress search_progress;
@@ -81,8 +85,14 @@ public:
 */
 extern void print_initial_evaluator_values(const EvaluationContext &eval_context);
 
+/*
+  Print the statistics of the given evaluators. Search engines call this
+  from print_statistics with all evaluators they use.
+*/
+extern void print_evaluator_statistics(const std::set<const Evaluator *> &evals);
+
 extern void collect_preferred_operators(
     EvaluationContext &eval_context, Evaluator *preferred_operator_evaluator,
-    ordered_set::OrderedSet<OperatorID> &preferred_operators);
+    stamped_ordered_set::StampedOrderedSet<OperatorID> &preferred_operators);
 
 #endif
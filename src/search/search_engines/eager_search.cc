@@ -6,7 +6,7 @@
 #include "../option_parser.h"
 #include "../pruning_method.h"
 
-#include "../algorithms/ordered_set.h"
+#include "../algorithms/stamped_ordered_set.h"
 #include "../task_utils/successor_generator.h"
 
 #include <cassert>
@@ -109,6 +109,16 @@ void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+
+    set<const Evaluator *> evals;
+    open_list->get_involved_evaluators(evals);
+    if (f_evaluator)
+        f_evaluator->get_involved_evaluators(evals);
+    for (const shared_ptr<Evaluator> &evaluator : preferred_operator_evaluators)
+        evaluator->get_involved_evaluators(evals);
+    if (lazy_evaluator)
+        lazy_evaluator->get_involved_evaluators(evals);
+    print_evaluator_statistics(evals);
 }
 
 SearchStatus EagerSearch::step() {
@@ -126,19 +136,25 @@ SearchStatus EagerSearch::step() {
     successor_generator.generate_applicable_ops(s, applicable_ops);
 
     /*
-      TODO: When preferred operators are in use, a preferred operator will be
-      considered by the preferred operator queues even when it is pruned.
+      This evaluates the expanded state (again) to get preferred ops. We
+      do this before pruning, so that evaluators can reuse the complete
+      list of applicable operators.
     */
-    pruning_method->prune_operators(s, applicable_ops);
-
-    // This evaluates the expanded state (again) to get preferred ops
     EvaluationContext eval_context(s, node.get_g(), false, &statistics, true);
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
+    eval_context.set_applicable_operators(&applicable_ops);
+    preferred_operators.clear();
     for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
         collect_preferred_operators(eval_context,
                                     preferred_operator_evaluator.get(),
                                     preferred_operators);
     }
+    eval_context.set_applicable_operators(nullptr);
+
+    /*
+      TODO: When preferred operators are in use, a preferred operator will be
+      considered by the preferred operator queues even when it is pruned.
+    */
+    pruning_method->prune_operators(s, applicable_ops);
 
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
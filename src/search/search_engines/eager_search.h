@@ -2,8 +2,11 @@
 #define SEARCH_ENGINES_EAGER_SEARCH_H
 
 #include "../open_list.h"
+#include "../operator_id.h"
 #include "../search_engine.h"
 
+#include "../algorithms/stamped_ordered_set.h"
+
 #include <memory>
 #include <vector>
 
@@ -27,6 +30,9 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    // Preferred operators of the expanded state, reused across expansions.
+    stamped_ordered_set::StampedOrderedSet<OperatorID> preferred_operators;
+
     std::pair<SearchNode, bool> fetch_next_node();
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(const SearchNode &node);
@@ -3,7 +3,7 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
-#include "../algorithms/ordered_set.h"
+#include "../algorithms/stamped_ordered_set.h"
 #include "../evaluators/g_evaluator.h"
 #include "../evaluators/pref_evaluator.h"
 #include "../open_lists/best_first_open_list.h"
@@ -144,7 +144,7 @@ void EnforcedHillClimbingSearch::expand(EvaluationContext &eval_context) {
     SearchNode node = search_space.get_node(eval_context.get_state());
     int node_g = node.get_g();
 
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
+    preferred_operators.clear();
     if (use_preferred) {
         for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
             collect_preferred_operators(eval_context,
@@ -233,7 +233,7 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
                 d_pair.first += 1;
                 d_pair.second += statistics.get_expanded() - last_num_expanded;
 
-                current_eval_context = eval_context;
+                current_eval_context = move(eval_context);
                 open_list->clear();
                 current_phase_start_g = node.get_g();
                 return IN_PROGRESS;
@@ -248,6 +248,7 @@ SearchStatus EnforcedHillClimbingSearch::ehc() {
 
 void EnforcedHillClimbingSearch::print_statistics() const {
     statistics.print_detailed_statistics();
+    search_space.print_statistics();
 
     cout << "EHC phases: " << num_ehc_phases << endl;
     assert(num_ehc_phases != 0);
@@ -255,6 +256,12 @@ void EnforcedHillClimbingSearch::print_statistics() const {
          << static_cast<double>(statistics.get_expanded()) / num_ehc_phases
          << endl;
 
+    set<const Evaluator *> evals;
+    evaluator->get_involved_evaluators(evals);
+    for (const shared_ptr<Evaluator> &eval : preferred_operator_evaluators)
+        eval->get_involved_evaluators(evals);
+    print_evaluator_statistics(evals);
+
     for (auto count : d_counts) {
         int depth = count.first;
         int phases = count.second.first;
@@ -5,6 +5,8 @@
 #include "../open_list.h"
 #include "../search_engine.h"
 
+#include "../algorithms/stamped_ordered_set.h"
+
 #include <map>
 #include <memory>
 #include <set>
@@ -36,6 +38,8 @@ class EnforcedHillClimbingSearch : public SearchEngine {
     std::set<Evaluator *> path_dependent_evaluators;
     bool use_preferred;
     PreferredUsage preferred_usage;
+    // Preferred operators of the expanded state, reused across expansions.
+    stamped_ordered_set::StampedOrderedSet<OperatorID> preferred_operators;
 
     EvaluationContext current_eval_context;
     int current_phase_start_g;
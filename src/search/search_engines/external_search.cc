@@ -0,0 +1,542 @@
+#include "external_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../algorithms/int_packer.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <queue>
+
+using namespace std;
+
+namespace external_search {
+// Size of the write buffer of each bucket file.
+static const size_t WRITE_BUFFER_BYTES = 1 << 16;
+// Size of the read buffer of each RecordReader.
+static const size_t READ_BUFFER_BYTES = 1 << 16;
+/*
+  Estimated memory usage of a state in the bucket registry in addition to
+  its packed data (hash table entry and per-state information).
+*/
+static const size_t REGISTRY_BYTES_PER_STATE = 64;
+
+static void exit_with_file_error(const string &message, const string &path) {
+    cerr << "External search error: " << message << " " << path << ": "
+         << strerror(errno) << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+RecordFile::RecordFile(
+    const string &path, int record_size, size_t max_buffered_records)
+    : path(path),
+      record_size(record_size),
+      num_records(0),
+      max_buffered_records(max_buffered_records) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        exit_with_file_error("could not create", path);
+    }
+    fclose(file);
+}
+
+RecordFile::~RecordFile() {
+    remove(path.c_str());
+}
+
+void RecordFile::append(const PackedStateBin *record) {
+    buffer.insert(buffer.end(), record, record + record_size);
+    ++num_records;
+    if (buffer.size() >= max_buffered_records * record_size) {
+        flush();
+    }
+}
+
+void RecordFile::flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    FILE *file = fopen(path.c_str(), "ab");
+    if (!file) {
+        exit_with_file_error("could not open", path);
+    }
+    size_t written = fwrite(buffer.data(), sizeof(PackedStateBin),
+                            buffer.size(), file);
+    if (written != buffer.size() || fclose(file) != 0) {
+        exit_with_file_error("could not write to", path);
+    }
+    buffer.clear();
+}
+
+
+RecordReader::RecordReader(const RecordFile &record_file, size_t buffer_records)
+    : file(fopen(record_file.get_path().c_str(), "rb")),
+      record_size(record_file.get_record_size()),
+      buffer(max(buffer_records, size_t(1)) * record_size),
+      num_buffered_records(0),
+      pos(0) {
+    if (!file) {
+        exit_with_file_error("could not open", record_file.get_path());
+    }
+    fill_buffer();
+}
+
+RecordReader::~RecordReader() {
+    fclose(file);
+}
+
+void RecordReader::fill_buffer() {
+    size_t record_bytes = record_size * sizeof(PackedStateBin);
+    num_buffered_records = fread(
+        buffer.data(), record_bytes, buffer.size() / record_size, file);
+    pos = 0;
+}
+
+
+static bool state_less(const PackedStateBin *lhs, const PackedStateBin *rhs,
+                       int num_bins) {
+    return lexicographical_compare(lhs, lhs + num_bins, rhs, rhs + num_bins);
+}
+
+static bool state_equal(const PackedStateBin *lhs, const PackedStateBin *rhs,
+                        int num_bins) {
+    return equal(lhs, lhs + num_bins, rhs);
+}
+
+
+ExternalSearch::ExternalSearch(const Options &opts)
+    : SearchEngine(opts),
+      evaluator(opts.contains("eval") ?
+                opts.get<shared_ptr<Evaluator>>("eval") : nullptr),
+      directory(opts.get<string>("directory")),
+      memory_bytes(static_cast<size_t>(opts.get<int>("memory")) << 20),
+      state_packer(task_properties::g_state_packers[task_proxy]),
+      bins_per_state(state_packer.get_num_bins()),
+      record_size(bins_per_state + 1),
+      max_registered_states(
+          memory_bytes /
+          (bins_per_state * sizeof(PackedStateBin) + REGISTRY_BYTES_PER_STATE)),
+      num_created_files(0),
+      bucket_registry(utils::make_unique_ptr<StateRegistry>(task_proxy)),
+      record(record_size),
+      num_removed_duplicates(0),
+      num_written_records(0) {
+}
+
+ExternalSearch::~ExternalSearch() {
+}
+
+unique_ptr<RecordFile> ExternalSearch::create_record_file() {
+    string path = directory + "/external-search-" +
+        to_string(utils::get_process_id()) + "-" +
+        to_string(num_created_files++) + ".records";
+    size_t record_bytes = record_size * sizeof(PackedStateBin);
+    return utils::make_unique_ptr<RecordFile>(
+        path, record_size, max(WRITE_BUFFER_BYTES / record_bytes, size_t(1)));
+}
+
+RecordFile &ExternalSearch::get_open_bucket(int g, int h) {
+    unique_ptr<RecordFile> &bucket = open_buckets[make_tuple(g + h, g, h)];
+    if (!bucket) {
+        bucket = create_record_file();
+    }
+    return *bucket;
+}
+
+void ExternalSearch::pack_record(const GlobalState &state, OperatorID op_id) {
+    // Unused bits of the bins must be zero to compare records bin by bin.
+    fill(record.begin(), record.begin() + bins_per_state, 0);
+    int num_variables = task_proxy.get_variables().size();
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(record.data(), var, state[var]);
+    }
+    record[bins_per_state] = static_cast<PackedStateBin>(op_id.get_index());
+}
+
+OperatorID ExternalSearch::get_operator(const PackedStateBin *record) const {
+    return OperatorID(static_cast<int>(record[bins_per_state]));
+}
+
+int ExternalSearch::compute_h(const GlobalState &state, int g) {
+    if (!evaluator) {
+        return 0;
+    }
+    EvaluationContext eval_context(state, g, false, &statistics);
+    statistics.inc_evaluated_states();
+    return eval_context.get_evaluator_value_or_infinity(evaluator.get());
+}
+
+unique_ptr<RecordFile> ExternalSearch::sort_and_remove_duplicates(
+    unique_ptr<RecordFile> bucket) {
+    bucket->flush();
+    size_t record_bytes = record_size * sizeof(PackedStateBin);
+    size_t chunk_records = max(memory_bytes / (record_bytes + sizeof(int)),
+                               size_t(1));
+
+    // Write sorted runs of at most chunk_records records without duplicates.
+    vector<unique_ptr<RecordFile>> runs;
+    {
+        RecordReader reader(*bucket, READ_BUFFER_BYTES / record_bytes);
+        vector<PackedStateBin> chunk;
+        vector<int> order;
+        while (!reader.is_done()) {
+            chunk.clear();
+            size_t num_chunk_records = 0;
+            for (; !reader.is_done() && num_chunk_records < chunk_records;
+                 reader.advance()) {
+                const PackedStateBin *current = reader.get_record();
+                chunk.insert(chunk.end(), current, current + record_size);
+                ++num_chunk_records;
+            }
+            order.resize(num_chunk_records);
+            for (size_t i = 0; i < num_chunk_records; ++i) {
+                order[i] = i;
+            }
+            const PackedStateBin *data = chunk.data();
+            int size = record_size;
+            int num_bins = bins_per_state;
+            /*
+              Stable sorting keeps the first generated record of each state,
+              which makes the search deterministic.
+            */
+            stable_sort(order.begin(), order.end(),
+                        [data, size, num_bins] (int lhs, int rhs) {
+                            return state_less(data + lhs * size,
+                                              data + rhs * size, num_bins);
+                        });
+            runs.push_back(create_record_file());
+            const PackedStateBin *last = nullptr;
+            for (int index : order) {
+                const PackedStateBin *current = data + index * record_size;
+                if (!last || !state_equal(last, current, bins_per_state)) {
+                    runs.back()->append(current);
+                    last = current;
+                }
+            }
+            runs.back()->flush();
+        }
+    }
+    int64_t num_input_records = bucket->size();
+    bucket = nullptr;
+
+    if (runs.size() == 1) {
+        num_removed_duplicates += num_input_records - runs.front()->size();
+        return move(runs.front());
+    }
+
+    // Merge the runs, keeping the first record of each state.
+    size_t buffer_records = max(
+        memory_bytes / (record_bytes * (runs.size() + 1)), size_t(1));
+    buffer_records = min(buffer_records, READ_BUFFER_BYTES / record_bytes);
+    vector<unique_ptr<RecordReader>> readers;
+    for (const unique_ptr<RecordFile> &run : runs) {
+        readers.push_back(
+            utils::make_unique_ptr<RecordReader>(*run, buffer_records));
+    }
+    int num_bins = bins_per_state;
+    auto greater = [&readers, num_bins] (int lhs, int rhs) {
+                       const PackedStateBin *lhs_record = readers[lhs]->get_record();
+                       const PackedStateBin *rhs_record = readers[rhs]->get_record();
+                       if (state_equal(lhs_record, rhs_record, num_bins)) {
+                           return lhs > rhs;
+                       }
+                       return state_less(rhs_record, lhs_record, num_bins);
+                   };
+    priority_queue<int, vector<int>, decltype(greater)> queue(greater);
+    for (size_t i = 0; i < readers.size(); ++i) {
+        if (!readers[i]->is_done()) {
+            queue.push(i);
+        }
+    }
+    unique_ptr<RecordFile> result = create_record_file();
+    vector<PackedStateBin> last;
+    while (!queue.empty()) {
+        int index = queue.top();
+        queue.pop();
+        RecordReader &reader = *readers[index];
+        const PackedStateBin *current = reader.get_record();
+        if (last.empty() || !state_equal(last.data(), current, bins_per_state)) {
+            result->append(current);
+            last.assign(current, current + record_size);
+        }
+        reader.advance();
+        if (!reader.is_done()) {
+            queue.push(index);
+        }
+    }
+    result->flush();
+    num_removed_duplicates += num_input_records - result->size();
+    return result;
+}
+
+unique_ptr<RecordFile> ExternalSearch::remove_expanded_states(
+    unique_ptr<RecordFile> bucket, int g, int h) {
+    /*
+      The h value of a state only depends on the state (unless pathmax
+      increases it), so we only compare with the expanded buckets with the
+      same h value. Duplicates that pathmax moved to other buckets are
+      expanded again, which is safe but redundant.
+    */
+    auto it = closed_buckets.find(h);
+    if (it == closed_buckets.end()) {
+        return bucket;
+    }
+    size_t record_bytes = record_size * sizeof(PackedStateBin);
+    size_t buffer_records = READ_BUFFER_BYTES / record_bytes;
+    for (const auto &g_and_bucket : it->second) {
+        if (g_and_bucket.first >= g) {
+            break;
+        }
+        const RecordFile &expanded = *g_and_bucket.second;
+        unique_ptr<RecordFile> result = create_record_file();
+        RecordReader reader(*bucket, buffer_records);
+        RecordReader expanded_reader(expanded, buffer_records);
+        for (; !reader.is_done(); reader.advance()) {
+            const PackedStateBin *current = reader.get_record();
+            while (!expanded_reader.is_done() &&
+                   state_less(expanded_reader.get_record(), current,
+                              bins_per_state)) {
+                expanded_reader.advance();
+            }
+            if (expanded_reader.is_done() ||
+                !state_equal(expanded_reader.get_record(), current,
+                             bins_per_state)) {
+                result->append(current);
+            }
+        }
+        result->flush();
+        num_removed_duplicates += bucket->size() - result->size();
+        bucket = move(result);
+    }
+    return bucket;
+}
+
+bool ExternalSearch::expand_bucket(RecordFile &bucket, int g, int h) {
+    size_t record_bytes = record_size * sizeof(PackedStateBin);
+    RecordReader reader(bucket, READ_BUFFER_BYTES / record_bytes);
+    vector<OperatorID> applicable_ops;
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (; !reader.is_done(); reader.advance()) {
+        if (bucket_registry->size() > max_registered_states) {
+            bucket_registry = utils::make_unique_ptr<StateRegistry>(task_proxy);
+        }
+        const PackedStateBin *current = reader.get_record();
+        GlobalState state = bucket_registry->import_state(current);
+        if (task_properties::is_goal_state(task_proxy, state)) {
+            cout << "Solution found!" << endl;
+            extract_plan(vector<PackedStateBin>(current, current + record_size), g);
+            return true;
+        }
+        statistics.inc_expanded();
+
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        statistics.inc_generated_ops(applicable_ops.size());
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = operators[op_id];
+            int cost = get_adjusted_cost(op);
+            int succ_g = g + cost;
+            if (succ_g >= bound) {
+                continue;
+            }
+            GlobalState succ_state = bucket_registry->get_successor_state(state, op);
+            statistics.inc_generated();
+            int succ_h = compute_h(succ_state, succ_g);
+            if (succ_h == EvaluationResult::INFTY) {
+                statistics.inc_dead_ends();
+                continue;
+            }
+            // Pathmax: keep f values monotone for inconsistent heuristics.
+            succ_h = max(succ_h, h - cost);
+            if (succ_h >= bound - succ_g) {
+                continue;
+            }
+            pack_record(succ_state, op_id);
+            get_open_bucket(succ_g, succ_h).append(record.data());
+            ++num_written_records;
+        }
+    }
+    return false;
+}
+
+void ExternalSearch::extract_plan(
+    const vector<PackedStateBin> &goal_record, int goal_g) {
+    size_t record_bytes = record_size * sizeof(PackedStateBin);
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<PackedStateBin> current = goal_record;
+    int current_g = goal_g;
+    Plan plan;
+    while (true) {
+        OperatorID op_id = get_operator(current.data());
+        if (op_id == OperatorID::no_operator) {
+            break;
+        }
+        OperatorProxy op = operators[op_id];
+        int parent_g = current_g - get_adjusted_cost(op);
+
+        bool found_parent = false;
+        for (const auto &h_and_buckets : closed_buckets) {
+            auto it = h_and_buckets.second.find(parent_g);
+            if (it == h_and_buckets.second.end()) {
+                continue;
+            }
+            RecordReader reader(*it->second, READ_BUFFER_BYTES / record_bytes);
+            for (; !reader.is_done(); reader.advance()) {
+                const PackedStateBin *candidate = reader.get_record();
+                bool applicable = true;
+                for (FactProxy pre : op.get_preconditions()) {
+                    if (state_packer.get(candidate, pre.get_variable().get_id()) !=
+                        pre.get_value()) {
+                        applicable = false;
+                        break;
+                    }
+                }
+                if (!applicable) {
+                    continue;
+                }
+                if (state_registry.is_successor_state(candidate, op, current.data())) {
+                    current.assign(candidate, candidate + record_size);
+                    found_parent = true;
+                    break;
+                }
+            }
+            if (found_parent) {
+                break;
+            }
+        }
+        if (!found_parent) {
+            ABORT("Could not find the parent of a state on the solution path.");
+        }
+        plan.push_back(op_id);
+        current_g = parent_g;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+void ExternalSearch::initialize() {
+    cout << "Conducting external-memory "
+         << (evaluator ? "A*" : "breadth-first search")
+         << " in directory " << directory << ", (real) bound = " << bound
+         << endl;
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        if (get_adjusted_cost(op) == 0) {
+            cerr << "External search does not support operators with cost 0 "
+                 << "(consider cost_type=plusone)." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+    }
+
+    const GlobalState &initial_state = bucket_registry->get_initial_state();
+    int h = compute_h(initial_state, 0);
+    if (evaluator) {
+        cout << "Initial heuristic value for " << evaluator->get_description()
+             << ": " << h << endl;
+    }
+    if (h == EvaluationResult::INFTY) {
+        cout << "Initial state is a dead end." << endl;
+        return;
+    }
+    pack_record(initial_state, OperatorID::no_operator);
+    get_open_bucket(0, h).append(record.data());
+    ++num_written_records;
+}
+
+SearchStatus ExternalSearch::step() {
+    if (open_buckets.empty()) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        closed_buckets.clear();
+        return FAILED;
+    }
+
+    auto it = open_buckets.begin();
+    int f, g, h;
+    tie(f, g, h) = it->first;
+    unique_ptr<RecordFile> bucket = move(it->second);
+    open_buckets.erase(it);
+    statistics.report_f_value_progress(f);
+
+    bucket = sort_and_remove_duplicates(move(bucket));
+    bucket = remove_expanded_states(move(bucket), g, h);
+    RecordFile &expanded_bucket = *bucket;
+    closed_buckets[h][g] = move(bucket);
+    if (expand_bucket(expanded_bucket, g, h)) {
+        // The planner exits without destroying the engine, so remove the files now.
+        open_buckets.clear();
+        closed_buckets.clear();
+        return SOLVED;
+    }
+    return IN_PROGRESS;
+}
+
+void ExternalSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    cout << "Written records: " << num_written_records << endl;
+    cout << "Removed duplicate records: " << num_removed_duplicates << endl;
+    cout << "Bucket files: " << num_created_files << endl;
+
+    set<const Evaluator *> evals;
+    if (evaluator)
+        evaluator->get_involved_evaluators(evals);
+    print_evaluator_statistics(evals);
+}
+
+static void add_options_to_parser(OptionParser &parser) {
+    parser.add_option<string>(
+        "directory",
+        "directory for the temporary files that store the buckets",
+        ".");
+    parser.add_option<int>(
+        "memory",
+        "memory in MiB used for sorting buckets and for the registry of the "
+        "states of the bucket that is expanded",
+        "512",
+        Bounds("1", "infinity"));
+    parser.document_note(
+        "Supported tasks",
+        "Operators with (adjusted) cost 0 are not supported. "
+        "The search only keeps the states of one bucket in memory, so "
+        "heuristics that store information for all states (e.g., "
+        "path-dependent heuristics) do not work as intended.");
+    SearchEngine::add_options_to_parser(parser);
+}
+
+static shared_ptr<SearchEngine> _parse_astar(OptionParser &parser) {
+    parser.document_synopsis(
+        "External-memory A* search",
+        "A* with delayed duplicate detection that stores open and closed "
+        "states in files on disk, organized in buckets of states with equal "
+        "g and h values. The heuristic should be admissible; inconsistent "
+        "heuristics are corrected with pathmax.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+    add_options_to_parser(parser);
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    return make_shared<ExternalSearch>(opts);
+}
+
+static shared_ptr<SearchEngine> _parse_bfs(OptionParser &parser) {
+    parser.document_synopsis(
+        "External-memory breadth-first search",
+        "Uniform-cost search with delayed duplicate detection that stores "
+        "open and closed states in files on disk. This is equivalent to "
+        "external_astar with the blind heuristic without evaluating it.");
+    add_options_to_parser(parser);
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    return make_shared<ExternalSearch>(opts);
+}
+
+static Plugin<SearchEngine> _plugin_astar("external_astar", _parse_astar);
+static Plugin<SearchEngine> _plugin_bfs("external_bfs", _parse_bfs);
+}
@@ -0,0 +1,158 @@
+#ifndef SEARCH_ENGINES_EXTERNAL_SEARCH_H
+#define SEARCH_ENGINES_EXTERNAL_SEARCH_H
+
+#include "../global_state.h"
+#include "../operator_id.h"
+#include "../search_engine.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class Evaluator;
+
+namespace int_packer {
+class IntPacker;
+}
+
+namespace options {
+class Options;
+}
+
+namespace external_search {
+/*
+  File of fixed-size records. Each record consists of a packed state (see
+  IntPacker) followed by the ID of the operator that generated the state.
+  Records are appended through an in-memory buffer and read sequentially
+  with a RecordReader. The file is removed when the object is destroyed.
+*/
+class RecordFile {
+    std::string path;
+    int record_size;
+    int64_t num_records;
+    std::vector<PackedStateBin> buffer;
+    size_t max_buffered_records;
+
+public:
+    RecordFile(const std::string &path, int record_size,
+               size_t max_buffered_records);
+    ~RecordFile();
+
+    RecordFile(const RecordFile &) = delete;
+    RecordFile &operator=(const RecordFile &) = delete;
+
+    void append(const PackedStateBin *record);
+    // Write all buffered records to the file.
+    void flush();
+
+    int64_t size() const {
+        return num_records;
+    }
+
+    const std::string &get_path() const {
+        return path;
+    }
+
+    int get_record_size() const {
+        return record_size;
+    }
+};
+
+class RecordReader {
+    FILE *file;
+    int record_size;
+    std::vector<PackedStateBin> buffer;
+    size_t num_buffered_records;
+    size_t pos;
+
+    void fill_buffer();
+public:
+    RecordReader(const RecordFile &record_file, size_t buffer_records);
+    ~RecordReader();
+
+    RecordReader(const RecordReader &) = delete;
+    RecordReader &operator=(const RecordReader &) = delete;
+
+    bool is_done() const {
+        return pos == num_buffered_records;
+    }
+
+    const PackedStateBin *get_record() const {
+        return &buffer[pos * record_size];
+    }
+
+    void advance() {
+        ++pos;
+        if (pos == num_buffered_records) {
+            fill_buffer();
+        }
+    }
+};
+
+/*
+  External-memory A* with delayed duplicate detection.
+
+  Generated states are appended to bucket files indexed by (g, h). Buckets
+  are expanded in order of increasing f = g + h, breaking ties by
+  increasing g. Before a bucket is expanded, it is sorted with an external
+  merge sort that removes duplicates, and states contained in previously
+  expanded buckets with the same h value are removed by merging with these
+  (sorted) buckets. Only the sorting buffers, the file buffers and a
+  temporary state registry for the states of the current bucket are kept
+  in memory.
+
+  Plans are reconstructed backwards from the goal state: each record stores
+  its generating operator, and the parent is found by scanning the expanded
+  buckets with the g value of the parent.
+*/
+class ExternalSearch : public SearchEngine {
+    const std::shared_ptr<Evaluator> evaluator;
+    const std::string directory;
+    const size_t memory_bytes;
+    const int_packer::IntPacker &state_packer;
+    const int bins_per_state;
+    const int record_size;
+    const size_t max_registered_states;
+    int num_created_files;
+
+    // Buckets of generated, unexpanded states indexed by (f, g, h).
+    std::map<std::tuple<int, int, int>, std::unique_ptr<RecordFile>> open_buckets;
+    // Expanded buckets without duplicates indexed by h and g.
+    std::map<int, std::map<int, std::unique_ptr<RecordFile>>> closed_buckets;
+    // Registry for the states of the bucket that is currently expanded.
+    std::unique_ptr<StateRegistry> bucket_registry;
+    std::vector<PackedStateBin> record;
+
+    int64_t num_removed_duplicates;
+    int64_t num_written_records;
+
+    std::unique_ptr<RecordFile> create_record_file();
+    RecordFile &get_open_bucket(int g, int h);
+    void pack_record(const GlobalState &state, OperatorID op_id);
+    OperatorID get_operator(const PackedStateBin *record) const;
+    int compute_h(const GlobalState &state, int g);
+
+    std::unique_ptr<RecordFile> sort_and_remove_duplicates(
+        std::unique_ptr<RecordFile> bucket);
+    std::unique_ptr<RecordFile> remove_expanded_states(
+        std::unique_ptr<RecordFile> bucket, int g, int h);
+    bool expand_bucket(RecordFile &bucket, int g, int h);
+    void extract_plan(const std::vector<PackedStateBin> &goal_record, int goal_g);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ExternalSearch(const options::Options &opts);
+    virtual ~ExternalSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
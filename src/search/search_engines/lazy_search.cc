@@ -3,7 +3,7 @@
 #include "../open_list_factory.h"
 #include "../option_parser.h"
 
-#include "../algorithms/ordered_set.h"
+#include "../algorithms/stamped_ordered_set.h"
 #include "../task_utils/successor_generator.h"
 #include "../task_utils/task_properties.h"
 #include "../utils/rng.h"
@@ -29,7 +29,8 @@ LazySearch::LazySearch(const Options &opts)
       current_operator_id(OperatorID::no_operator),
       current_g(0),
       current_real_g(0),
-      current_eval_context(current_state, 0, true, &statistics) {
+      current_eval_context(current_state, 0, true, &statistics),
+      current_applicable_ops_generated(false) {
     /*
       We initialize current_eval_context in such a way that the initial node
       counts as "preferred".
@@ -61,43 +62,54 @@ void LazySearch::initialize() {
     }
 }
 
-vector<OperatorID> LazySearch::get_successor_operators(
-    const ordered_set::OrderedSet<OperatorID> &preferred_operators) const {
-    vector<OperatorID> applicable_operators;
-    successor_generator.generate_applicable_ops(
-        current_state, applicable_operators);
+const vector<OperatorID> &LazySearch::get_successor_operators(
+    const stamped_ordered_set::StampedOrderedSet<OperatorID> &preferred_operators) {
+    get_current_applicable_ops();
+    // Swapping exchanges the buffers, so neither needs to allocate memory.
+    successor_operators.swap(current_applicable_ops);
+    current_applicable_ops_generated = false;
+    current_eval_context.set_applicable_operators(nullptr);
 
     if (randomize_successors) {
-        rng->shuffle(applicable_operators);
+        rng->shuffle(successor_operators);
     }
 
     if (preferred_successors_first) {
-        ordered_set::OrderedSet<OperatorID> successor_operators;
+        ordered_successor_operators.clear();
         for (OperatorID op_id : preferred_operators) {
-            successor_operators.insert(op_id);
+            ordered_successor_operators.insert(op_id);
         }
-        for (OperatorID op_id : applicable_operators) {
-            successor_operators.insert(op_id);
+        for (OperatorID op_id : successor_operators) {
+            ordered_successor_operators.insert(op_id);
         }
-        return successor_operators.pop_as_vector();
-    } else {
-        return applicable_operators;
+        successor_operators.assign(ordered_successor_operators.begin(),
+                                   ordered_successor_operators.end());
     }
+    return successor_operators;
+}
+
+const vector<OperatorID> &LazySearch::get_current_applicable_ops() {
+    if (!current_applicable_ops_generated) {
+        successor_generator.generate_applicable_ops(
+            current_state, current_applicable_ops);
+        current_applicable_ops_generated = true;
+    }
+    return current_applicable_ops;
 }
 
 void LazySearch::generate_successors() {
-    ordered_set::OrderedSet<OperatorID> preferred_operators;
+    current_preferred_operators.clear();
     for (const shared_ptr<Evaluator> &preferred_operator_evaluator : preferred_operator_evaluators) {
         collect_preferred_operators(current_eval_context,
                                     preferred_operator_evaluator.get(),
-                                    preferred_operators);
+                                    current_preferred_operators);
     }
     if (randomize_successors) {
-        preferred_operators.shuffle(*rng);
+        current_preferred_operators.shuffle(*rng);
     }
 
-    vector<OperatorID> successor_operators =
-        get_successor_operators(preferred_operators);
+    const vector<OperatorID> &successor_operators =
+        get_successor_operators(current_preferred_operators);
 
     statistics.inc_generated(successor_operators.size());
 
@@ -105,7 +117,7 @@ void LazySearch::generate_successors() {
         OperatorProxy op = task_proxy.get_operators()[op_id];
         int new_g = current_g + get_adjusted_cost(op);
         int new_real_g = current_real_g + op.get_cost();
-        bool is_preferred = preferred_operators.contains(op_id);
+        bool is_preferred = current_preferred_operators.contains(op_id);
         if (new_real_g < bound) {
             EvaluationContext new_eval_context(
                 current_eval_context.get_cache(), new_g, is_preferred, nullptr);
@@ -168,6 +180,12 @@ SearchStatus LazySearch::step() {
                     parent_state, current_operator_id, current_state);
         }
         statistics.inc_evaluated_states();
+        current_applicable_ops.clear();
+        current_applicable_ops_generated = false;
+        current_eval_context.set_applicable_operators_generator(
+            [this]() -> const vector<OperatorID> & {
+                return get_current_applicable_ops();
+            });
         if (!open_list->is_dead_end(current_eval_context)) {
             // TODO: Generalize code for using multiple evaluators.
             if (current_predecessor_id == StateID::no_state) {
@@ -255,5 +273,11 @@ void LazySearch::print_checkpoint_line(int g) const {
 void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
+
+    set<const Evaluator *> evals;
+    open_list->get_involved_evaluators(evals);
+    for (const shared_ptr<Evaluator> &evaluator : preferred_operator_evaluators)
+        evaluator->get_involved_evaluators(evals);
+    print_evaluator_statistics(evals);
 }
 }
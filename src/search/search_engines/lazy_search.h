@@ -10,6 +10,7 @@
 #include "../search_progress.h"
 #include "../search_space.h"
 
+#include "../algorithms/stamped_ordered_set.h"
 #include "../utils/rng.h"
 
 #include <memory>
@@ -39,6 +40,23 @@ protected:
     int current_g;
     int current_real_g;
     EvaluationContext current_eval_context;
+    /*
+      Applicable operators of current_state. They are generated on demand,
+      either by an evaluator computing preferred operators through
+      current_eval_context or when the state is expanded, so that dead
+      ends never pay for them.
+    */
+    std::vector<OperatorID> current_applicable_ops;
+    bool current_applicable_ops_generated;
+    /*
+      Preferred operators of current_state, scratch space for ordering
+      its successors and the ordered successor operators. All are reused
+      across expansions to avoid allocating memory for every expanded
+      state.
+    */
+    stamped_ordered_set::StampedOrderedSet<OperatorID> current_preferred_operators;
+    stamped_ordered_set::StampedOrderedSet<OperatorID> ordered_successor_operators;
+    std::vector<OperatorID> successor_operators;
 
     virtual void initialize() override;
     virtual SearchStatus step() override;
@@ -48,8 +66,10 @@ protected:
 
     void reward_progress();
 
-    std::vector<OperatorID> get_successor_operators(
-        const ordered_set::OrderedSet<OperatorID> &preferred_operators) const;
+    const std::vector<OperatorID> &get_current_applicable_ops();
+
+    const std::vector<OperatorID> &get_successor_operators(
+        const stamped_ordered_set::StampedOrderedSet<OperatorID> &preferred_operators);
 
     // TODO: Move into SearchEngine?
     void print_checkpoint_line(int g) const;
@@ -1,10 +1,30 @@
 #include "search_node_info.h"
 
+using namespace std;
+
 static const int pointer_bytes = sizeof(void *);
-static const int info_bytes = 3 * sizeof(int) + sizeof(StateID);
+static const int info_bytes = sizeof(int) + sizeof(StateID);
 static const int padding_bytes = info_bytes % pointer_bytes;
 
 static_assert(
     sizeof(SearchNodeInfo) == info_bytes + padding_bytes,
     "The size of SearchNodeInfo is larger than expected. This probably means "
     "that packing two fields into one integer using bitfields is not supported.");
+
+SearchNodeExtraLayout::SearchNodeExtraLayout(int operator_bytes, bool real_g_stored)
+    : operator_bytes(operator_bytes),
+      real_g_stored(real_g_stored) {
+    assert(operator_bytes == 0 || operator_bytes == 1 ||
+           operator_bytes == 2 || operator_bytes == 4);
+}
+
+vector<unsigned char> SearchNodeExtraLayout::get_default_data() const {
+    vector<unsigned char> data(get_num_bytes(), 0);
+    if (stores_creating_operator()) {
+        set_creating_operator(data.data(), OperatorID::no_operator);
+    }
+    if (stores_real_g()) {
+        set_real_g(data.data(), -1);
+    }
+    return data;
+}
@@ -4,6 +4,10 @@
 #include "operator_id.h"
 #include "state_id.h"
 
+#include <cassert>
+#include <cstring>
+#include <vector>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
@@ -13,13 +17,75 @@ struct SearchNodeInfo {
     unsigned int status : 2;
     int g : 30;
     StateID parent_state_id;
-    OperatorID creating_operator;
-    int real_g;
 
     SearchNodeInfo()
-        : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1) {
+        : status(NEW), g(-1), parent_state_id(StateID::no_state) {
+    }
+};
+
+/*
+  Besides the SearchNodeInfo, the search space can store the operator that
+  created a state and the g value of the state under the original operator
+  costs ("real g"). Both are optional and packed into a byte array per
+  state whose layout is described by this class:
+
+  - The creating operator is stored as its index plus one (0 encodes "no
+    operator") in 1, 2 or 4 bytes, or not at all. If it is not stored, it
+    has to be reconstructed from the parent state.
+  - The real g value is stored in 4 bytes after the creating operator. If
+    it is not stored, it is equal to the g value of the SearchNodeInfo.
+*/
+class SearchNodeExtraLayout {
+    int operator_bytes;
+    bool real_g_stored;
+
+public:
+    SearchNodeExtraLayout(int operator_bytes, bool real_g_stored);
+
+    bool stores_creating_operator() const {
+        return operator_bytes > 0;
+    }
+
+    bool stores_real_g() const {
+        return real_g_stored;
+    }
+
+    int get_num_bytes() const {
+        return operator_bytes + (real_g_stored ? sizeof(int) : 0);
+    }
+
+    OperatorID get_creating_operator(const unsigned char *data) const {
+        assert(stores_creating_operator());
+        unsigned int encoded = 0;
+        for (int i = 0; i < operator_bytes; ++i) {
+            encoded |= static_cast<unsigned int>(data[i]) << (8 * i);
+        }
+        return OperatorID(static_cast<int>(encoded) - 1);
+    }
+
+    void set_creating_operator(unsigned char *data, OperatorID op_id) const {
+        assert(stores_creating_operator());
+        unsigned int encoded = op_id.get_index() + 1;
+        for (int i = 0; i < operator_bytes; ++i) {
+            data[i] = static_cast<unsigned char>(encoded >> (8 * i));
+        }
+        assert(get_creating_operator(data) == op_id);
     }
+
+    int get_real_g(const unsigned char *data) const {
+        assert(stores_real_g());
+        int real_g;
+        memcpy(&real_g, data + operator_bytes, sizeof(int));
+        return real_g;
+    }
+
+    void set_real_g(unsigned char *data, int real_g) const {
+        assert(stores_real_g());
+        memcpy(data + operator_bytes, &real_g, sizeof(int));
+    }
+
+    // Data of a state without creating operator and with real g value -1.
+    std::vector<unsigned char> get_default_data() const;
 };
 
 #endif
@@ -1,20 +1,29 @@
 #include "search_space.h"
 
 #include "global_state.h"
+#include "option_parser.h"
 #include "search_node_info.h"
 #include "task_proxy.h"
 
+#include "task_utils/successor_generator.h"
+#include "task_utils/task_properties.h"
+
 #include <cassert>
 
 using namespace std;
 
 SearchNode::SearchNode(const StateRegistry &state_registry,
                        StateID state_id,
-                       SearchNodeInfo &info)
+                       SearchNodeInfo &info,
+                       const SearchNodeExtraLayout &extra_layout,
+                       unsigned char *extra_data)
     : state_registry(state_registry),
       state_id(state_id),
-      info(info) {
+      info(info),
+      extra_layout(extra_layout),
+      extra_data(extra_data) {
     assert(state_id != StateID::no_state);
+    assert((extra_data != nullptr) == (extra_layout.get_num_bytes() > 0));
 }
 
 GlobalState SearchNode::get_state() const {
@@ -43,16 +52,40 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    if (extra_layout.stores_real_g()) {
+        return extra_layout.get_real_g(extra_data);
+    }
+    return info.g;
+}
+
+void SearchNode::set_parent(const SearchNode &parent_node,
+                            const OperatorProxy &parent_op,
+                            int adjusted_cost) {
+    info.g = parent_node.info.g + adjusted_cost;
+    if (extra_layout.stores_real_g()) {
+        extra_layout.set_real_g(
+            extra_data, parent_node.get_real_g() + parent_op.get_cost());
+    } else {
+        assert(adjusted_cost == parent_op.get_cost());
+    }
+    info.parent_state_id = parent_node.get_state_id();
+    if (extra_layout.stores_creating_operator()) {
+        extra_layout.set_creating_operator(
+            extra_data, OperatorID(parent_op.get_id()));
+    }
 }
 
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
+    if (extra_layout.stores_real_g()) {
+        extra_layout.set_real_g(extra_data, 0);
+    }
     info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    if (extra_layout.stores_creating_operator()) {
+        extra_layout.set_creating_operator(extra_data, OperatorID::no_operator);
+    }
 }
 
 void SearchNode::open(const SearchNode &parent_node,
@@ -60,10 +93,7 @@ void SearchNode::open(const SearchNode &parent_node,
                       int adjusted_cost) {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
@@ -75,10 +105,7 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
@@ -89,10 +116,7 @@ void SearchNode::update_parent(const SearchNode &parent_node,
            info.status == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close() {
@@ -107,22 +131,92 @@ void SearchNode::mark_as_dead_end() {
 void SearchNode::dump(const TaskProxy &task_proxy) const {
     cout << state_id << ": ";
     get_state().dump_fdr();
-    if (info.creating_operator != OperatorID::no_operator) {
+    if (info.parent_state_id == StateID::no_state) {
+        cout << " no parent" << endl;
+    } else if (extra_layout.stores_creating_operator()) {
         OperatorsProxy operators = task_proxy.get_operators();
-        OperatorProxy op = operators[info.creating_operator.get_index()];
+        OperatorID op_id = extra_layout.get_creating_operator(extra_data);
+        OperatorProxy op = operators[op_id.get_index()];
         cout << " created by " << op.get_name()
              << " from " << info.parent_state_id << endl;
     } else {
-        cout << " no parent" << endl;
+        cout << " created from " << info.parent_state_id << endl;
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry)
-    : state_registry(state_registry) {
+static SearchNodeExtraLayout compute_extra_layout(
+    SearchSpaceMode mode, OperatorCost cost_type, int num_operators) {
+    if (mode == SearchSpaceMode::FULL) {
+        return SearchNodeExtraLayout(4, true);
+    }
+    // Real g values can only differ from g values for adjusted costs.
+    bool store_real_g = (cost_type != NORMAL);
+    int operator_bytes = 0;
+    if (mode == SearchSpaceMode::COMPACT) {
+        // Operators are stored as index + 1, so 0 can encode "no operator".
+        if (num_operators < (1 << 8)) {
+            operator_bytes = 1;
+        } else if (num_operators < (1 << 16)) {
+            operator_bytes = 2;
+        } else {
+            operator_bytes = 4;
+        }
+    }
+    return SearchNodeExtraLayout(operator_bytes, store_real_g);
+}
+
+SearchSpace::SearchSpace(
+    StateRegistry &state_registry,
+    const successor_generator::SuccessorGenerator &successor_generator,
+    SearchSpaceMode mode,
+    OperatorCost cost_type)
+    : extra_layout(compute_extra_layout(
+                       mode, cost_type,
+                       state_registry.get_task_proxy().get_operators().size())),
+      search_node_extras(extra_layout.get_default_data()),
+      state_registry(state_registry),
+      successor_generator(successor_generator),
+      cost_type(cost_type),
+      is_unit_cost(task_properties::is_unit_cost(state_registry.get_task_proxy())) {
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
-    return SearchNode(state_registry, state.get_id(), search_node_infos[state]);
+    unsigned char *extra_data = nullptr;
+    if (extra_layout.get_num_bytes() > 0) {
+        extra_data = &search_node_extras[state][0];
+    }
+    return SearchNode(state_registry, state.get_id(), search_node_infos[state],
+                      extra_layout, extra_data);
+}
+
+OperatorID SearchSpace::find_creating_operator(
+    const GlobalState &parent_state, const GlobalState &state) const {
+    /*
+      Several operators may lead from the parent state to the state. The g
+      value of the state is at least the g value of the parent state plus the
+      adjusted cost of the operator that created the state, so the cheapest
+      of these operators is consistent with the stored g values. Among
+      operators with equal adjusted cost, we prefer lower real cost.
+    */
+    OperatorsProxy operators = state_registry.get_task_proxy().get_operators();
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(parent_state, applicable_ops);
+    OperatorID best_op_id = OperatorID::no_operator;
+    pair<int, int> best_cost;
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        if (state_registry.is_successor_state(parent_state, op, state)) {
+            pair<int, int> cost(
+                get_adjusted_action_cost(op, cost_type, is_unit_cost),
+                op.get_cost());
+            if (best_op_id == OperatorID::no_operator || cost < best_cost) {
+                best_op_id = op_id;
+                best_cost = cost;
+            }
+        }
+    }
+    assert(best_op_id != OperatorID::no_operator);
+    return best_op_id;
 }
 
 void SearchSpace::trace_path(const GlobalState &goal_state,
@@ -131,12 +225,19 @@ void SearchSpace::trace_path(const GlobalState &goal_state,
     assert(path.empty());
     for (;;) {
         const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        if (info.parent_state_id == StateID::no_state) {
             break;
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        GlobalState parent_state = state_registry.lookup_state(info.parent_state_id);
+        if (extra_layout.stores_creating_operator()) {
+            OperatorID op_id = extra_layout.get_creating_operator(
+                &search_node_extras[current_state][0]);
+            assert(op_id != OperatorID::no_operator);
+            path.push_back(op_id);
+        } else {
+            path.push_back(find_creating_operator(parent_state, current_state));
+        }
+        current_state = parent_state;
     }
     reverse(path.begin(), path.end());
 }
@@ -150,9 +251,13 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
         const SearchNodeInfo &node_info = search_node_infos[state];
         cout << id << ": ";
         state.dump_fdr();
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
-            OperatorProxy op = operators[node_info.creating_operator.get_index()];
+        if (node_info.parent_state_id != StateID::no_state) {
+            GlobalState parent_state = state_registry.lookup_state(
+                node_info.parent_state_id);
+            OperatorID op_id = extra_layout.stores_creating_operator() ?
+                extra_layout.get_creating_operator(&search_node_extras[state][0]) :
+                find_creating_operator(parent_state, state);
+            OperatorProxy op = operators[op_id.get_index()];
             cout << " created by " << op.get_name()
                  << " from " << node_info.parent_state_id << endl;
         } else {
@@ -161,6 +266,44 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
     }
 }
 
+int SearchSpace::get_node_size_in_bytes() const {
+    return sizeof(SearchNodeInfo) + extra_layout.get_num_bytes();
+}
+
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics();
+    cout << "Search node bytes per state: " << get_node_size_in_bytes() << endl;
+    cout << "Bytes per state (packed state and search node): "
+         << state_registry.get_state_size_in_bytes() + get_node_size_in_bytes()
+         << endl;
+}
+
+void add_search_space_option_to_parser(options::OptionParser &parser) {
+    vector<string> modes;
+    vector<string> modes_doc;
+    modes.push_back("FULL");
+    modes_doc.push_back(
+        "store the creating operator and the g value under the original "
+        "operator costs for each state (16 bytes per state)");
+    modes.push_back("COMPACT");
+    modes_doc.push_back(
+        "store the creating operator in 1, 2 or 4 bytes depending on the "
+        "number of operators and store the g value under the original "
+        "operator costs only if costs are adjusted (cost_type != NORMAL)");
+    modes.push_back("PARENTS");
+    modes_doc.push_back(
+        "like COMPACT, but do not store the creating operator. Plans are "
+        "reconstructed by regenerating the successors of the parent states "
+        "on the path to the goal.");
+    parser.add_enum_option(
+        "search_space",
+        modes,
+        "Information stored for each state in the search space besides its "
+        "status, g value and parent state. Reducing it allows searches to "
+        "store more states within the memory limit. The search behavior is "
+        "the same for all modes, but with PARENTS, a different operator "
+        "of the same cost may be chosen for parent states that have "
+        "several operators leading to the same successor.",
+        "FULL",
+        modes_doc);
 }
@@ -3,6 +3,7 @@
 
 #include "global_state.h"
 #include "operator_cost.h"
+#include "per_state_array.h"
 #include "per_state_information.h"
 #include "search_node_info.h"
 
@@ -12,15 +13,42 @@ class GlobalState;
 class OperatorProxy;
 class TaskProxy;
 
+namespace options {
+class OptionParser;
+}
+
+namespace successor_generator {
+class SuccessorGenerator;
+}
+
+/*
+  Determines which information the search space stores for each state
+  besides status, g value and parent state (see SearchNodeExtraLayout).
+*/
+enum class SearchSpaceMode {
+    FULL,
+    COMPACT,
+    PARENTS
+};
+
 
 class SearchNode {
     const StateRegistry &state_registry;
     StateID state_id;
     SearchNodeInfo &info;
+    const SearchNodeExtraLayout &extra_layout;
+    // Optional data as described by extra_layout (nullptr if empty).
+    unsigned char *extra_data;
+
+    void set_parent(const SearchNode &parent_node,
+                    const OperatorProxy &parent_op,
+                    int adjusted_cost);
 public:
     SearchNode(const StateRegistry &state_registry,
                StateID state_id,
-               SearchNodeInfo &info);
+               SearchNodeInfo &info,
+               const SearchNodeExtraLayout &extra_layout,
+               unsigned char *extra_data);
 
     StateID get_state_id() const {
         return state_id;
@@ -54,10 +82,22 @@ public:
 
 class SearchSpace {
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    const SearchNodeExtraLayout extra_layout;
+    PerStateArray<unsigned char> search_node_extras;
 
     StateRegistry &state_registry;
+    const successor_generator::SuccessorGenerator &successor_generator;
+    const OperatorCost cost_type;
+    const bool is_unit_cost;
+
+    OperatorID find_creating_operator(
+        const GlobalState &parent_state, const GlobalState &state) const;
 public:
-    explicit SearchSpace(StateRegistry &state_registry);
+    SearchSpace(
+        StateRegistry &state_registry,
+        const successor_generator::SuccessorGenerator &successor_generator,
+        SearchSpaceMode mode,
+        OperatorCost cost_type);
 
     SearchNode get_node(const GlobalState &state);
     void trace_path(const GlobalState &goal_state,
@@ -65,6 +105,11 @@ public:
 
     void dump(const TaskProxy &task_proxy) const;
     void print_statistics() const;
+
+    // Number of bytes the search space stores per state.
+    int get_node_size_in_bytes() const;
 };
 
+extern void add_search_space_option_to_parser(options::OptionParser &parser);
+
 #endif
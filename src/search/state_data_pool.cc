@@ -0,0 +1,221 @@
+#include "state_data_pool.h"
+
+#include "option_parser.h"
+
+#include "utils/system.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STATE_FILE_SUPPORTED
+#endif
+
+using namespace std;
+
+// Targeted size of a segment of the state file.
+static const size_t FILE_SEGMENT_BYTES = 1 << 20;
+// Number of segments that are mapped even for very small memory bounds.
+static const size_t MIN_MAPPED_SEGMENTS = 4;
+
+static void exit_with_file_error(const string &message) {
+    cerr << "State storage error: " << message << ": " << strerror(errno) << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+StateDataPool::StateDataPool(
+    int bins_per_state, const string &directory, size_t max_mapped_bytes)
+    : bins_per_state(bins_per_state),
+      file_backed(!directory.empty()),
+      memory_pool(bins_per_state),
+      file_descriptor(-1),
+      states_per_segment(0),
+      segment_bytes(0),
+      max_mapped_segments(0),
+      num_states(0),
+      access_counter(0),
+      num_segment_loads(0) {
+    if (file_backed) {
+        open_file(directory);
+        size_t state_bytes = bins_per_state * sizeof(PackedStateBin);
+        states_per_segment = max(FILE_SEGMENT_BYTES / state_bytes, size_t(1));
+        // Segments must start at multiples of the page size in the file.
+#ifdef STATE_FILE_SUPPORTED
+        size_t page_size = sysconf(_SC_PAGESIZE);
+#else
+        size_t page_size = 1;
+#endif
+        segment_bytes = states_per_segment * state_bytes;
+        segment_bytes = (segment_bytes + page_size - 1) / page_size * page_size;
+        max_mapped_segments = max(max_mapped_bytes / segment_bytes, MIN_MAPPED_SEGMENTS);
+        cout << "Storing states in a file in " << directory << " with "
+             << states_per_segment << " states per segment and at most "
+             << max_mapped_segments << " segments in memory." << endl;
+    }
+}
+
+StateDataPool::~StateDataPool() {
+#ifdef STATE_FILE_SUPPORTED
+    if (file_backed) {
+        for (int segment_id : mapped_segment_ids) {
+            munmap(segments[segment_id].data, segment_bytes);
+        }
+        close(file_descriptor);
+    }
+#endif
+}
+
+void StateDataPool::open_file(const string &directory) {
+#ifdef STATE_FILE_SUPPORTED
+    string path_template = directory + "/states-XXXXXX";
+    vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    file_descriptor = mkstemp(path.data());
+    if (file_descriptor == -1) {
+        exit_with_file_error("could not create state file in " + directory);
+    }
+    // The file is removed automatically once it is closed.
+    unlink(path.data());
+#else
+    utils::unused_variable(directory);
+    cerr << "Storing states in a file is not supported on this system." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+#endif
+}
+
+void StateDataPool::add_segment() {
+#ifdef STATE_FILE_SUPPORTED
+    off_t file_size = (segments.size() + 1) * segment_bytes;
+    if (ftruncate(file_descriptor, file_size) == -1) {
+        exit_with_file_error("could not extend state file");
+    }
+    segments.emplace_back();
+    map_segment(segments.size() - 1);
+#endif
+}
+
+void StateDataPool::map_segment(int segment_id) const {
+#ifdef STATE_FILE_SUPPORTED
+    FileSegment &segment = segments[segment_id];
+    assert(!segment.data);
+    if (mapped_segment_ids.size() >= max_mapped_segments) {
+        evict_segment();
+    }
+    off_t offset = static_cast<off_t>(segment_id) * segment_bytes;
+    void *data = mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, file_descriptor, offset);
+    if (data == MAP_FAILED) {
+        exit_with_file_error("could not map state file");
+    }
+    segment.data = static_cast<PackedStateBin *>(data);
+    mapped_segment_ids.push_back(segment_id);
+#else
+    utils::unused_variable(segment_id);
+#endif
+}
+
+void StateDataPool::unmap_segment(int segment_id) const {
+#ifdef STATE_FILE_SUPPORTED
+    FileSegment &segment = segments[segment_id];
+    assert(segment.data && segment.num_pins == 0);
+    munmap(segment.data, segment_bytes);
+    segment.data = nullptr;
+    mapped_segment_ids.erase(
+        find(mapped_segment_ids.begin(), mapped_segment_ids.end(), segment_id));
+#else
+    utils::unused_variable(segment_id);
+#endif
+}
+
+void StateDataPool::evict_segment() const {
+    int last_segment_id = segments.size() - 1;
+    int victim = -1;
+    uint64_t victim_access = numeric_limits<uint64_t>::max();
+    for (int segment_id : mapped_segment_ids) {
+        const FileSegment &segment = segments[segment_id];
+        /*
+          Keep the segment of the previous access mapped, since callers may
+          compare two states (e.g., for duplicate checking).
+        */
+        if (segment_id != last_segment_id && segment.num_pins == 0 &&
+            segment.last_access != access_counter &&
+            segment.last_access < victim_access) {
+            victim = segment_id;
+            victim_access = segment.last_access;
+        }
+    }
+    /*
+      If all mapped segments are in use, we temporarily map more segments
+      than allowed.
+    */
+    if (victim != -1) {
+        unmap_segment(victim);
+    }
+}
+
+PackedStateBin *StateDataPool::get_file_state(size_t index) const {
+    assert(index < num_states);
+    size_t segment_id = index / states_per_segment;
+    FileSegment &segment = segments[segment_id];
+    if (!segment.data) {
+        map_segment(segment_id);
+        ++num_segment_loads;
+    }
+    segment.last_access = ++access_counter;
+    return segment.data + (index % states_per_segment) * bins_per_state;
+}
+
+void StateDataPool::push_back(const PackedStateBin *state) {
+    if (!file_backed) {
+        memory_pool.push_back(state);
+        return;
+    }
+    if (num_states == segments.size() * states_per_segment) {
+        add_segment();
+    }
+    ++num_states;
+    PackedStateBin *buffer = get_file_state(num_states - 1);
+    copy(state, state + bins_per_state, buffer);
+}
+
+void StateDataPool::pop_back() {
+    if (!file_backed) {
+        memory_pool.pop_back();
+        return;
+    }
+    assert(num_states > 0);
+    --num_states;
+}
+
+void StateDataPool::print_statistics() const {
+    if (file_backed) {
+        cout << "State file segments: " << segments.size() << endl;
+        cout << "State file segments in memory: "
+             << mapped_segment_ids.size() << endl;
+        cout << "State file segment loads: " << num_segment_loads << endl;
+    }
+}
+
+void add_state_storage_options_to_parser(options::OptionParser &parser) {
+    parser.add_option<string>(
+        "state_storage_dir",
+        "directory in which a temporary file for the registered states is "
+        "created. Only the recently used parts of the file are kept in "
+        "memory (see state_storage_memory), so the search can store more "
+        "states than fit into memory. If not given, all states are kept in "
+        "memory.",
+        options::OptionParser::NONE);
+    parser.add_option<int>(
+        "state_storage_memory",
+        "maximal size in MiB of the parts of the state file that are kept "
+        "in memory",
+        "256",
+        options::Bounds("1", "infinity"));
+}
@@ -0,0 +1,125 @@
+#ifndef STATE_DATA_POOL_H
+#define STATE_DATA_POOL_H
+
+#include "global_state.h"
+
+#include "algorithms/segmented_vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace options {
+class OptionParser;
+}
+
+/*
+  Storage for the packed states of a StateRegistry.
+
+  By default, all states are kept in memory in a SegmentedArrayVector. If a
+  directory is given, the states are stored in segments of a temporary
+  memory-mapped file in this directory instead. Only a bounded number of
+  segments ("hot" segments) are mapped at any time. Accessing a state in an
+  unmapped ("cold") segment maps the segment again and unmaps the least
+  recently used segment that is neither pinned nor the last segment (to
+  which new states are added). Unmapped segments only occupy space in the
+  file and in the page cache of the operating system, not in the address
+  space of the planner.
+
+  Pointers to states in a segment are only valid while the segment is
+  mapped. Therefore, GlobalState objects pin the segment of their state
+  (see get_pin_count()) as long as they exist. All other accesses (e.g.,
+  for duplicate checking) only use the returned pointer until the next
+  access to the pool.
+*/
+class StateDataPool {
+    struct FileSegment {
+        // nullptr if the segment is currently not mapped.
+        PackedStateBin *data;
+        int num_pins;
+        uint64_t last_access;
+
+        FileSegment()
+            : data(nullptr), num_pins(0), last_access(0) {
+        }
+    };
+
+    const int bins_per_state;
+    const bool file_backed;
+
+    // Storage for states that are kept in memory.
+    segmented_vector::SegmentedArrayVector<PackedStateBin> memory_pool;
+
+    // Storage for states in a memory-mapped file.
+    int file_descriptor;
+    size_t states_per_segment;
+    size_t segment_bytes;
+    size_t max_mapped_segments;
+    size_t num_states;
+    /*
+      We use a deque to keep the pin counters of segments at fixed addresses
+      when adding segments.
+    */
+    mutable std::deque<FileSegment> segments;
+    mutable std::vector<int> mapped_segment_ids;
+    mutable uint64_t access_counter;
+    mutable int64_t num_segment_loads;
+
+    void open_file(const std::string &directory);
+    void add_segment();
+    void map_segment(int segment_id) const;
+    void unmap_segment(int segment_id) const;
+    void evict_segment() const;
+    PackedStateBin *get_file_state(size_t index) const;
+
+public:
+    StateDataPool(
+        int bins_per_state, const std::string &directory = "",
+        size_t max_mapped_bytes = 0);
+    ~StateDataPool();
+
+    StateDataPool(const StateDataPool &) = delete;
+    StateDataPool &operator=(const StateDataPool &) = delete;
+
+    size_t size() const {
+        return file_backed ? num_states : memory_pool.size();
+    }
+
+    void push_back(const PackedStateBin *state);
+    void pop_back();
+
+    const PackedStateBin *operator[](size_t index) const {
+        if (!file_backed) {
+            return memory_pool[index];
+        }
+        return get_file_state(index);
+    }
+
+    // Writable buffer of the state that was added last.
+    PackedStateBin *get_last_state() {
+        assert(size() > 0);
+        if (!file_backed) {
+            return memory_pool[memory_pool.size() - 1];
+        }
+        return get_file_state(num_states - 1);
+    }
+
+    /*
+      Return the pin counter of the segment holding the given state, or
+      nullptr if states are kept in memory and never move.
+    */
+    int *get_pin_count(size_t index) const {
+        if (!file_backed) {
+            return nullptr;
+        }
+        return &segments[index / states_per_segment].num_pins;
+    }
+
+    void print_statistics() const;
+};
+
+extern void add_state_storage_options_to_parser(options::OptionParser &parser);
+
+#endif
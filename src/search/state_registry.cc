@@ -8,11 +8,17 @@
 using namespace std;
 
 StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+    : StateRegistry(task_proxy, "", 0) {
+}
+
+StateRegistry::StateRegistry(
+    const TaskProxy &task_proxy, const string &storage_directory,
+    size_t max_memory_bytes)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      state_data_pool(get_bins_per_state(), storage_directory, max_memory_bytes),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
@@ -42,7 +48,8 @@ StateID StateRegistry::insert_id_or_pop_state() {
 }
 
 GlobalState StateRegistry::lookup_state(StateID id) const {
-    return GlobalState(state_data_pool[id.value], *this, id);
+    return GlobalState(state_data_pool[id.value], *this, id,
+                       state_data_pool.get_pin_count(id.value));
 }
 
 const GlobalState &StateRegistry::get_initial_state() {
@@ -67,21 +74,65 @@ const GlobalState &StateRegistry::get_initial_state() {
 //TODO it would be nice to move the actual state creation (and operator application)
 //     out of the StateRegistry. This could for example be done by global functions
 //     operating on state buffers (PackedStateBin *).
-GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, const OperatorProxy &op) {
+void StateRegistry::apply_operator(
+    const PackedStateBin *predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) {
     assert(!op.is_axiom());
-    state_data_pool.push_back(predecessor.get_packed_buffer());
-    PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
+    changed_facts.clear();
     for (EffectProxy effect : op.get_effects()) {
-        if (does_fire(effect, predecessor)) {
+        bool fires = true;
+        for (FactProxy condition : effect.get_conditions()) {
+            FactPair condition_pair = condition.get_pair();
+            if (state_packer.get(predecessor, condition_pair.var) !=
+                condition_pair.value) {
+                fires = false;
+                break;
+            }
+        }
+        if (fires) {
             FactPair effect_pair = effect.get_fact().get_pair();
+            int old_value = state_packer.get(predecessor, effect_pair.var);
+            if (old_value != effect_pair.value &&
+                state_packer.get(buffer, effect_pair.var) == old_value) {
+                changed_facts.emplace_back(effect_pair.var, old_value);
+            }
             state_packer.set(buffer, effect_pair.var, effect_pair.value);
         }
     }
-    axiom_evaluator.evaluate(buffer, state_packer);
+    axiom_evaluator.evaluate_incremental(buffer, state_packer, changed_facts);
+}
+
+GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, const OperatorProxy &op) {
+    state_data_pool.push_back(predecessor.get_packed_buffer());
+    PackedStateBin *buffer = state_data_pool.get_last_state();
+    apply_operator(predecessor.get_packed_buffer(), op, buffer);
     StateID id = insert_id_or_pop_state();
     return lookup_state(id);
 }
 
+GlobalState StateRegistry::import_state(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+bool StateRegistry::is_successor_state(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    const GlobalState &successor) {
+    return is_successor_state(
+        predecessor.get_packed_buffer(), op, successor.get_packed_buffer());
+}
+
+bool StateRegistry::is_successor_state(
+    const PackedStateBin *predecessor, const OperatorProxy &op,
+    const PackedStateBin *successor) {
+    int num_bins = get_bins_per_state();
+    unregistered_buffer.assign(predecessor, predecessor + num_bins);
+    apply_operator(predecessor, op, unregistered_buffer.data());
+    return equal(unregistered_buffer.begin(), unregistered_buffer.end(),
+                 successor);
+}
+
 int StateRegistry::get_bins_per_state() const {
     return state_packer.get_num_bins();
 }
@@ -93,4 +144,5 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics() const {
     cout << "Number of registered states: " << size() << endl;
     registered_states.print_statistics();
+    state_data_pool.print_statistics();
 }
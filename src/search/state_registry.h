@@ -4,6 +4,7 @@
 #include "abstract_task.h"
 #include "axioms.h"
 #include "global_state.h"
+#include "state_data_pool.h"
 #include "state_id.h"
 
 #include "algorithms/int_hash_set.h"
@@ -13,6 +14,8 @@
 #include "utils/hash.h"
 
 #include <set>
+#include <string>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -92,8 +95,10 @@
 
     SearchSpace
       The SearchSpace uses PerStateInformation<SearchNodeInfo> to map StateIDs to
-      SearchNodeInfos. The open lists only have to store StateIDs which can be
-      used to look up a search node in the SearchSpace on demand.
+      SearchNodeInfos and a PerStateArray for the optional creating operators
+      and real g values (see SearchNodeExtraLayout). The open lists only have
+      to store StateIDs which can be used to look up a search node in the
+      SearchSpace on demand.
 
   ---------------
   Usage example 2
@@ -110,10 +115,10 @@
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -130,10 +135,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
@@ -158,15 +163,35 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
     GlobalState *cached_initial_state;
 
+    // Predecessor facts changed by the last operator; reused to avoid reallocation.
+    std::vector<FactPair> changed_facts;
+
+    // Scratch space for successor states that are not registered.
+    std::vector<PackedStateBin> unregistered_buffer;
+
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
+    /*
+      Apply op to the packed predecessor state. The result is written to
+      buffer, which initially holds a copy of the predecessor state.
+    */
+    void apply_operator(
+        const PackedStateBin *predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer);
 public:
     explicit StateRegistry(const TaskProxy &task_proxy);
+    /*
+      Store the states in a temporary file in the given directory, keeping
+      at most (roughly) max_memory_bytes of it in memory.
+    */
+    StateRegistry(
+        const TaskProxy &task_proxy, const std::string &storage_directory,
+        size_t max_memory_bytes);
     ~StateRegistry();
 
     const TaskProxy &get_task_proxy() const {
@@ -200,6 +225,29 @@ public:
     */
     GlobalState get_successor_state(const GlobalState &predecessor, const OperatorProxy &op);
 
+    /*
+      Returns the state with the given packed data and registers it if this
+      was not done before.
+    */
+    GlobalState import_state(const PackedStateBin *buffer);
+
+    /*
+      Returns true iff applying op to predecessor results in the (registered)
+      state successor. Unlike get_successor_state, this does not register
+      the resulting state.
+    */
+    bool is_successor_state(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        const GlobalState &successor);
+
+    /*
+      Same as above for packed states, which do not have to be registered
+      in this registry.
+    */
+    bool is_successor_state(
+        const PackedStateBin *predecessor, const OperatorProxy &op,
+        const PackedStateBin *successor);
+
     /*
       Returns the number of states registered so far.
     */
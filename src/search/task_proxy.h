@@ -80,7 +80,7 @@ class CausalGraph;
   OperatorProxy and GlobalOperator objects.
 
       int FantasyHeuristic::compute_heuristic(const GlobalState &global_state) {
-          State state = convert_global_state(global_state);
+          const State &state = convert_global_state(global_state);
           set_preferred(task->get_operators()[42]);
           int sum = 0;
           for (FactProxy fact : state)
@@ -5,12 +5,34 @@
 
 #include "../abstract_task.h"
 #include "../global_state.h"
+#include "../option_parser.h"
+
+#include "../utils/memory.h"
+
+#include <cassert>
 
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create()) {
+static PerTaskInformation<PreconditionIndex> g_precondition_indices;
+
+static GeneratorPtr create_generator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type) {
+    if (type == SuccessorGeneratorType::INCREMENTAL) {
+        return utils::make_unique_ptr<GeneratorIncremental>(
+            g_precondition_indices[task_proxy]);
+    }
+    SuccessorGeneratorFactory factory(task_proxy);
+    if (type == SuccessorGeneratorType::COMPILED) {
+        return factory.create_compiled();
+    } else {
+        return factory.create();
+    }
+}
+
+SuccessorGenerator::SuccessorGenerator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type)
+    : root(create_generator(task_proxy, type)) {
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
@@ -26,4 +48,52 @@ void SuccessorGenerator::generate_applicable_ops(
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+PerTaskInformation<SuccessorGenerator> g_compiled_successor_generators(
+    [](const TaskProxy &task_proxy) {
+        return utils::make_unique_ptr<SuccessorGenerator>(
+            task_proxy, SuccessorGeneratorType::COMPILED);
+    });
+
+SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type) {
+    assert(type != SuccessorGeneratorType::INCREMENTAL);
+    if (type == SuccessorGeneratorType::COMPILED) {
+        return g_compiled_successor_generators[task_proxy];
+    } else {
+        return g_successor_generators[task_proxy];
+    }
+}
+
+unique_ptr<SuccessorGenerator> create_incremental_successor_generator(
+    const TaskProxy &task_proxy) {
+    return utils::make_unique_ptr<SuccessorGenerator>(
+        task_proxy, SuccessorGeneratorType::INCREMENTAL);
+}
+
+void add_successor_generator_option_to_parser(options::OptionParser &parser) {
+    vector<string> types;
+    vector<string> types_doc;
+    types.push_back("TREE");
+    types_doc.push_back(
+        "decision tree of individually allocated nodes");
+    types.push_back("COMPILED");
+    types_doc.push_back(
+        "the same decision tree stored in one contiguous array and "
+        "traversed without virtual calls");
+    types.push_back("INCREMENTAL");
+    types_doc.push_back(
+        "count unsatisfied preconditions per operator and update the counts "
+        "and a bitset of applicable operators for the variables that differ "
+        "from the previously queried state. Suited for tasks with many "
+        "operators and searches that query similar states in a row, like "
+        "lazy search. Generates operators ordered by ID, so the search may "
+        "expand states in a different order than with the other types.");
+    parser.add_enum_option(
+        "successor_generator",
+        types,
+        "Representation of the successor generator. TREE and COMPILED "
+        "generate the same applicable operators in the same order.",
+        "TREE",
+        types_doc);
+}
 }
@@ -11,14 +11,29 @@ class OperatorID;
 class State;
 class TaskProxy;
 
+namespace options {
+class OptionParser;
+}
+
 namespace successor_generator {
 class GeneratorBase;
 
+enum class SuccessorGeneratorType {
+    // Tree of polymorphic nodes.
+    TREE,
+    // The same tree, stored as a contiguous array (see GeneratorCompiled).
+    COMPILED,
+    // Incremental precondition counting (see GeneratorIncremental).
+    INCREMENTAL
+};
+
 class SuccessorGenerator {
     std::unique_ptr<GeneratorBase> root;
 
 public:
-    explicit SuccessorGenerator(const TaskProxy &task_proxy);
+    explicit SuccessorGenerator(
+        const TaskProxy &task_proxy,
+        SuccessorGeneratorType type = SuccessorGeneratorType::TREE);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -34,6 +49,26 @@ public:
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_compiled_successor_generators;
+
+/*
+  Return the shared successor generator of the given type (TREE or
+  COMPILED) for the task. Both generate the same operators in the same
+  order.
+*/
+extern SuccessorGenerator &get_successor_generator(
+    const TaskProxy &task_proxy, SuccessorGeneratorType type);
+
+/*
+  INCREMENTAL generators keep the state of their last query and can
+  therefore not be shared. Every call creates a new generator, which only
+  shares the precondition index with the other generators of the task.
+*/
+extern std::unique_ptr<SuccessorGenerator> create_incremental_successor_generator(
+    const TaskProxy &task_proxy);
+
+extern void add_successor_generator_option_to_parser(
+    options::OptionParser &parser);
 }
 
 #endif
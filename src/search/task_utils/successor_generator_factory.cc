@@ -270,6 +270,101 @@ GeneratorPtr SuccessorGeneratorFactory::construct_recursive(
     return construct_fork(move(nodes));
 }
 
+int SuccessorGeneratorFactory::compile_fork(
+    const vector<int> &children, vector<int> &code) const {
+    if (children.size() == 1) {
+        return children.front();
+    }
+    /* As above, this includes the case of zero children, which can
+       (only) happen for the root for tasks with no operators. */
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::FORK);
+    code.push_back(children.size());
+    code.insert(code.end(), children.begin(), children.end());
+    return pos;
+}
+
+int SuccessorGeneratorFactory::compile_leaf(
+    OperatorRange range, vector<int> &code) const {
+    assert(!range.empty());
+    int pos = code.size();
+    code.push_back(GeneratorCompiled::LEAF);
+    code.push_back(range.span());
+    while (range.begin != range.end) {
+        code.push_back(operator_infos[range.begin].get_op().get_index());
+        ++range.begin;
+    }
+    return pos;
+}
+
+int SuccessorGeneratorFactory::compile_switch(
+    int switch_var_id, const ValuesAndChildren &values_and_children,
+    vector<int> &code) const {
+    VariablesProxy variables = task_proxy.get_variables();
+    int var_domain = variables[switch_var_id].get_domain_size();
+    int num_children = values_and_children.size();
+
+    assert(num_children > 0);
+
+    int pos = code.size();
+    if (num_children == 1) {
+        code.push_back(GeneratorCompiled::SWITCH_SINGLE);
+        code.push_back(switch_var_id);
+        code.push_back(values_and_children[0].first);
+        code.push_back(values_and_children[0].second);
+    } else if (var_domain <= 2 * num_children + 1) {
+        // Use the faster vector switch unless it needs more space.
+        code.push_back(GeneratorCompiled::SWITCH_VECTOR);
+        code.push_back(switch_var_id);
+        int children_begin = code.size();
+        code.resize(children_begin + var_domain, GeneratorCompiled::NO_CHILD);
+        for (const auto &item : values_and_children)
+            code[children_begin + item.first] = item.second;
+    } else {
+        // Values are grouped in increasing order.
+        code.push_back(GeneratorCompiled::SWITCH_SORTED);
+        code.push_back(switch_var_id);
+        code.push_back(num_children);
+        for (const auto &item : values_and_children)
+            code.push_back(item.first);
+        for (const auto &item : values_and_children)
+            code.push_back(item.second);
+    }
+    return pos;
+}
+
+int SuccessorGeneratorFactory::compile_recursive(
+    int depth, OperatorRange range, vector<int> &code) const {
+    // This mirrors construct_recursive.
+    vector<int> children;
+    OperatorGrouper grouper_by_var(
+        operator_infos, depth, GroupOperatorsBy::VAR, range);
+    while (!grouper_by_var.done()) {
+        auto var_group = grouper_by_var.next();
+        int var = var_group.first;
+        OperatorRange var_range = var_group.second;
+
+        if (var == -1) {
+            children.push_back(compile_leaf(var_range, code));
+        } else {
+            ValuesAndChildren values_and_children;
+            OperatorGrouper grouper_by_value(
+                operator_infos, depth, GroupOperatorsBy::VALUE, var_range);
+            while (!grouper_by_value.done()) {
+                auto value_group = grouper_by_value.next();
+                int value = value_group.first;
+                OperatorRange value_range = value_group.second;
+
+                values_and_children.emplace_back(
+                    value, compile_recursive(depth + 1, value_range, code));
+            }
+
+            children.push_back(compile_switch(var, values_and_children, code));
+        }
+    }
+    return compile_fork(children, code);
+}
+
 static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
     vector<FactPair> precond;
     precond.reserve(op.get_preconditions().size());
@@ -280,7 +375,7 @@ static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
     return precond;
 }
 
-GeneratorPtr SuccessorGeneratorFactory::create() {
+void SuccessorGeneratorFactory::initialize_operator_infos() {
     OperatorsProxy operators = task_proxy.get_operators();
     operator_infos.reserve(operators.size());
     for (OperatorProxy op : operators) {
@@ -290,10 +385,24 @@ GeneratorPtr SuccessorGeneratorFactory::create() {
     /* Use stable_sort rather than sort for reproducibility.
        This amounts to breaking ties by operator ID. */
     stable_sort(operator_infos.begin(), operator_infos.end());
+}
 
+GeneratorPtr SuccessorGeneratorFactory::create() {
+    initialize_operator_infos();
     OperatorRange full_range(0, operator_infos.size());
     GeneratorPtr root = construct_recursive(0, full_range);
     operator_infos.clear();
     return root;
 }
+
+GeneratorPtr SuccessorGeneratorFactory::create_compiled() {
+    initialize_operator_infos();
+    OperatorRange full_range(0, operator_infos.size());
+    vector<int> code;
+    // Children are compiled before their parents, so the root comes last.
+    int root = compile_recursive(0, full_range, code);
+    operator_infos.clear();
+    code.shrink_to_fit();
+    return utils::make_unique_ptr<GeneratorCompiled>(move(code), root);
+}
 }
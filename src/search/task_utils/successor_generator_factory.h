@@ -26,11 +26,28 @@ class SuccessorGeneratorFactory {
     GeneratorPtr construct_switch(
         int switch_var_id, ValuesAndGenerators values_and_generators) const;
     GeneratorPtr construct_recursive(int depth, OperatorRange range) const;
+
+    // The compile_* methods append nodes to code and return their offsets.
+    using ValuesAndChildren = std::vector<std::pair<int, int>>;
+    int compile_fork(const std::vector<int> &children, std::vector<int> &code) const;
+    int compile_leaf(OperatorRange range, std::vector<int> &code) const;
+    int compile_switch(
+        int switch_var_id, const ValuesAndChildren &values_and_children,
+        std::vector<int> &code) const;
+    int compile_recursive(
+        int depth, OperatorRange range, std::vector<int> &code) const;
+
+    void initialize_operator_infos();
 public:
     explicit SuccessorGeneratorFactory(const TaskProxy &task_proxy);
     // Destructor cannot be implicit because OperatorInfo is forward-declared.
     ~SuccessorGeneratorFactory();
     GeneratorPtr create();
+    /*
+      Create a GeneratorCompiled that uses the same decision tree as the
+      generator returned by create(), stored as one contiguous array.
+    */
+    GeneratorPtr create_compiled();
 };
 }
 
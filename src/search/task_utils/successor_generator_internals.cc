@@ -3,6 +3,7 @@
 #include "../global_state.h"
 #include "../task_proxy.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -22,7 +23,8 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. GeneratorCompiled
+    implements a variant of this idea (see successor_generator_internals.h).
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -225,4 +227,181 @@ void GeneratorLeafSingle::generate_applicable_ops(
     const GlobalState &, vector<OperatorID> &applicable_ops) const {
     applicable_ops.push_back(applicable_operator);
 }
+
+static inline int get_state_value(const State &state, int var_id) {
+    return state[var_id].get_value();
+}
+
+static inline int get_state_value(const GlobalState &state, int var_id) {
+    return state[var_id];
+}
+
+const int GeneratorCompiled::NO_CHILD;
+
+GeneratorCompiled::GeneratorCompiled(vector<int> &&code, int root)
+    : code(move(code)),
+      root(root) {
+}
+
+template<typename StateType>
+void GeneratorCompiled::generate_recursive(
+    int pos, const StateType &state, vector<OperatorID> &applicable_ops) const {
+    /*
+      Switch nodes have at most one child to visit, so we follow them in
+      the loop instead of recursing. We only recurse for the children of
+      forks (except for the last one).
+    */
+    while (pos != NO_CHILD) {
+        const int *node = &code[pos];
+        switch (node[0]) {
+        case FORK: {
+            int num_children = node[1];
+            if (num_children == 0)
+                return;
+            for (int i = 0; i < num_children - 1; ++i) {
+                generate_recursive(node[2 + i], state, applicable_ops);
+            }
+            pos = node[1 + num_children];
+            break;
+        }
+        case SWITCH_VECTOR:
+            pos = node[2 + get_state_value(state, node[1])];
+            break;
+        case SWITCH_SORTED: {
+            int value = get_state_value(state, node[1]);
+            int num_children = node[2];
+            const int *values_begin = node + 3;
+            const int *values_end = values_begin + num_children;
+            const int *it = lower_bound(values_begin, values_end, value);
+            if (it == values_end || *it != value)
+                return;
+            pos = values_end[it - values_begin];
+            break;
+        }
+        case SWITCH_SINGLE:
+            if (get_state_value(state, node[1]) != node[2])
+                return;
+            pos = node[3];
+            break;
+        case LEAF: {
+            // See GeneratorLeafVector for the reason for using push_back.
+            int num_operators = node[1];
+            for (int i = 0; i < num_operators; ++i) {
+                applicable_ops.push_back(OperatorID(node[2 + i]));
+            }
+            return;
+        }
+        default:
+            assert(false);
+            return;
+        }
+    }
+}
+
+void GeneratorCompiled::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+    generate_recursive(root, state, applicable_ops);
+}
+
+void GeneratorCompiled::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    generate_recursive(root, state, applicable_ops);
+}
+
+PreconditionIndex::PreconditionIndex(const TaskProxy &task_proxy) {
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_facts = 0;
+    fact_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+    }
+    operators_by_precondition.resize(num_facts);
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    num_preconditions.reserve(operators.size());
+    for (OperatorProxy op : operators) {
+        PreconditionsProxy preconditions = op.get_preconditions();
+        for (FactProxy pre : preconditions) {
+            FactPair fact = pre.get_pair();
+            operators_by_precondition[fact_offsets[fact.var] + fact.value].push_back(
+                op.get_id());
+        }
+        num_preconditions.push_back(preconditions.size());
+    }
+    for (vector<int> &op_ids : operators_by_precondition) {
+        op_ids.shrink_to_fit();
+    }
+}
+
+GeneratorIncremental::GeneratorIncremental(const PreconditionIndex &index)
+    : index(index),
+      applicable_operators(index.num_preconditions.size()) {
+}
+
+void GeneratorIncremental::add_unsatisfied(int var, int value) const {
+    for (int op_id : index.operators_by_precondition[index.fact_offsets[var] + value]) {
+        if (num_unsatisfied_preconditions[op_id]++ == 0)
+            applicable_operators.reset(op_id);
+    }
+}
+
+void GeneratorIncremental::remove_unsatisfied(int var, int value) const {
+    for (int op_id : index.operators_by_precondition[index.fact_offsets[var] + value]) {
+        if (--num_unsatisfied_preconditions[op_id] == 0)
+            applicable_operators.set(op_id);
+    }
+}
+
+template<typename StateType>
+void GeneratorIncremental::update_reference_state(const StateType &state) const {
+    int num_variables = index.fact_offsets.size();
+    if (reference_values.empty()) {
+        // Compute everything from scratch for the first state.
+        int num_operators = index.num_preconditions.size();
+        reference_values.resize(num_variables);
+        num_unsatisfied_preconditions = index.num_preconditions;
+        for (int op_id = 0; op_id < num_operators; ++op_id) {
+            if (index.num_preconditions[op_id] == 0)
+                applicable_operators.set(op_id);
+        }
+        for (int var = 0; var < num_variables; ++var) {
+            int value = get_state_value(state, var);
+            reference_values[var] = value;
+            remove_unsatisfied(var, value);
+        }
+        return;
+    }
+
+    for (int var = 0; var < num_variables; ++var) {
+        int old_value = reference_values[var];
+        int new_value = get_state_value(state, var);
+        if (old_value != new_value) {
+            add_unsatisfied(var, old_value);
+            remove_unsatisfied(var, new_value);
+            reference_values[var] = new_value;
+        }
+    }
+}
+
+void GeneratorIncremental::collect_applicable_ops(
+    vector<OperatorID> &applicable_ops) const {
+    for (size_t op_id = applicable_operators.find_first();
+         op_id != applicable_operators.npos;
+         op_id = applicable_operators.find_next(op_id)) {
+        applicable_ops.push_back(OperatorID(op_id));
+    }
+}
+
+void GeneratorIncremental::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+    update_reference_state(state);
+    collect_applicable_ops(applicable_ops);
+}
+
+void GeneratorIncremental::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    update_reference_state(state);
+    collect_applicable_ops(applicable_ops);
+}
 }
@@ -3,12 +3,16 @@
 
 #include "../operator_id.h"
 
+#include "../algorithms/dynamic_bitset.h"
+
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 class GlobalState;
 class State;
+class TaskProxy;
 
 namespace successor_generator {
 class GeneratorBase {
@@ -101,6 +105,99 @@ public:
         const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
 };
 
+/*
+  Flat representation of a complete successor generator. All nodes are
+  stored in one vector of ints and refer to their children by offsets
+  into this vector. Node layouts (tags are the values of NodeType):
+
+  - fork:          [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, var_id, child_for_value_0, ...,
+                    child_for_value_k] with NO_CHILD for missing values
+  - sorted switch: [SWITCH_SORTED, var_id, n, value_1, ..., value_n,
+                    child_1, ..., child_n] with increasing values
+  - single switch: [SWITCH_SINGLE, var_id, value, child]
+  - leaf:          [LEAF, n, op_id_1, ..., op_id_n]
+
+  The nodes are traversed with a loop over the node types, so only the
+  root is called virtually. Operators are reported in the same order as
+  by the pointer-based generator built from the same task.
+*/
+class GeneratorCompiled : public GeneratorBase {
+public:
+    enum NodeType {
+        FORK,
+        SWITCH_VECTOR,
+        SWITCH_SORTED,
+        SWITCH_SINGLE,
+        LEAF
+    };
+    static const int NO_CHILD = -1;
+private:
+    std::vector<int> code;
+    int root;
+
+    template<typename StateType>
+    void generate_recursive(
+        int pos, const StateType &state,
+        std::vector<OperatorID> &applicable_ops) const;
+public:
+    GeneratorCompiled(std::vector<int> &&code, int root);
+    virtual void generate_applicable_ops(
+        const State &state, std::vector<OperatorID> &applicable_ops) const override;
+    // Transitional method, used until the search is switched to the new task interface.
+    virtual void generate_applicable_ops(
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+};
+
+// Operators indexed by their preconditions, shared by all GeneratorIncremental objects of a task.
+struct PreconditionIndex {
+    // Operators with precondition var=value, indexed by fact_offsets[var] + value.
+    std::vector<int> fact_offsets;
+    std::vector<std::vector<int>> operators_by_precondition;
+    std::vector<int> num_preconditions;
+
+    explicit PreconditionIndex(const TaskProxy &task_proxy);
+};
+
+/*
+  Applicable operator computation that does not use a decision tree.
+  We keep the number of unsatisfied preconditions of every operator and
+  the set of applicable operators (as a bitset) for the state of the last
+  query (the reference state). For the next state, we only update the
+  operators that have a precondition on a variable whose value differs
+  from the reference state. Successive queries for a parent and its
+  successor (as in lazy search) or for siblings therefore only touch the
+  operators affected by the change. Comparing the two states is linear in
+  the number of variables, and reporting the applicable operators scans
+  the bitset, i.e., one word per 64 operators.
+
+  Operators are generated in the order of their IDs, which differs from
+  the order of the tree-based generators. The generator keeps mutable
+  state, so it must not be shared between searches or used concurrently.
+  Only the precondition index is shared.
+*/
+class GeneratorIncremental : public GeneratorBase {
+    const PreconditionIndex &index;
+
+    mutable std::vector<int> reference_values;
+    mutable std::vector<int> num_unsatisfied_preconditions;
+    // Applicable operators of the reference state, iterated in ID order.
+    mutable dynamic_bitset::DynamicBitset<std::uint64_t> applicable_operators;
+
+    void add_unsatisfied(int var, int value) const;
+    void remove_unsatisfied(int var, int value) const;
+    template<typename StateType>
+    void update_reference_state(const StateType &state) const;
+    void collect_applicable_ops(std::vector<OperatorID> &applicable_ops) const;
+public:
+    explicit GeneratorIncremental(const PreconditionIndex &index);
+    virtual void generate_applicable_ops(
+        const State &state, std::vector<OperatorID> &applicable_ops) const override;
+    // Transitional method, used until the search is switched to the new task interface.
+    virtual void generate_applicable_ops(
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const override;
+};
+
 class GeneratorLeafSingle : public GeneratorBase {
     OperatorID applicable_operator;
 public:
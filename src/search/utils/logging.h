@@ -11,16 +11,22 @@
 namespace utils {
 /*
   Simple logger that prepends time and peak memory info to messages.
-  Logs are written to stdout.
+  Logs are written to stdout unless another stream is given.
 
   Usage:
         utils::g_log << "States: " << num_states << endl;
 */
 struct Log {
+    std::ostream &stream;
+
+    explicit Log(std::ostream &stream = std::cout)
+        : stream(stream) {
+    }
+
     template<typename T>
     std::ostream &operator<<(const T &elem) {
-        return std::cout << "[t=" << g_timer << ", "
-                         << get_peak_memory_in_kb() << " KB] " << elem;
+        return stream << "[t=" << g_timer << ", "
+                      << get_peak_memory_in_kb() << " KB] " << elem;
     }
 };
 
@@ -0,0 +1,46 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+int get_num_used_threads(int num_threads, int num_items) {
+    return max(1, min(num_threads, num_items));
+}
+
+void parallel_for(
+    int num_threads, int num_items,
+    const function<void(int thread_id, int item)> &func) {
+    num_threads = get_num_used_threads(num_threads, num_items);
+    if (num_threads == 1) {
+        for (int item = 0; item < num_items; ++item) {
+            func(0, item);
+        }
+        return;
+    }
+
+    atomic<int> next_item(0);
+    auto work = [&](int thread_id) {
+            while (true) {
+                int item = next_item.fetch_add(1);
+                if (item >= num_items)
+                    break;
+                func(thread_id, item);
+            }
+        };
+
+    vector<thread> workers;
+    workers.reserve(num_threads - 1);
+    for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+        workers.emplace_back(work, thread_id);
+    }
+    work(0);
+    for (thread &worker : workers) {
+        worker.join();
+    }
+}
+}
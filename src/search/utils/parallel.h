@@ -0,0 +1,77 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace utils {
+/*
+  Call func(thread_id, item) for all items in [0, num_items), using up to
+  num_threads threads (including the calling thread). Items are handed out
+  dynamically, so callers must not rely on the order in which they are
+  processed. The thread_id lies in [0, num_threads) and can be used to
+  index per-thread scratch data. With num_threads <= 1, all items are
+  processed in order in the calling thread.
+
+  The function returns when all items have been processed. Callers are
+  responsible for making concurrent calls of func safe, which usually
+  means that func only writes to data owned by the given item or thread.
+*/
+extern void parallel_for(
+    int num_threads, int num_items,
+    const std::function<void(int thread_id, int item)> &func);
+
+// Return the number of threads parallel_for() actually uses.
+extern int get_num_used_threads(int num_threads, int num_items);
+
+/*
+  Sort [begin, end) by sorting one chunk per thread and merging the sorted
+  chunks pairwise. If comp induces a total order, the result is identical
+  to that of std::sort for all values of num_threads.
+*/
+template<typename RandomIt, typename Compare>
+void parallel_sort(int num_threads, RandomIt begin, RandomIt end, Compare comp) {
+    int num_items = std::distance(begin, end);
+    int num_chunks = get_num_used_threads(num_threads, num_items);
+    if (num_chunks == 1) {
+        std::sort(begin, end, comp);
+        return;
+    }
+
+    std::vector<int> chunk_begin(num_chunks + 1);
+    for (int chunk = 0; chunk <= num_chunks; ++chunk) {
+        chunk_begin[chunk] = static_cast<long long>(num_items) * chunk / num_chunks;
+    }
+    parallel_for(
+        num_threads, num_chunks,
+        [&](int, int chunk) {
+            std::sort(begin + chunk_begin[chunk],
+                      begin + chunk_begin[chunk + 1], comp);
+        });
+    for (int width = 1; width < num_chunks; width *= 2) {
+        int num_merges = (num_chunks + 2 * width - 1) / (2 * width);
+        parallel_for(
+            num_threads, num_merges,
+            [&](int, int merge) {
+                int left = 2 * width * merge;
+                int middle = std::min(left + width, num_chunks);
+                int right = std::min(left + 2 * width, num_chunks);
+                if (middle < right) {
+                    std::inplace_merge(begin + chunk_begin[left],
+                                       begin + chunk_begin[middle],
+                                       begin + chunk_begin[right], comp);
+                }
+            });
+    }
+}
+
+template<typename RandomIt>
+void parallel_sort(int num_threads, RandomIt begin, RandomIt end) {
+    parallel_sort(num_threads, begin, end,
+                  std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+}
+
+#endif
@@ -0,0 +1,20 @@
+#include "parallel_options.h"
+
+#include "../options/option_parser.h"
+
+using namespace std;
+
+namespace utils {
+void add_parallel_options(options::OptionParser &parser) {
+    parser.add_option<int>(
+        "num_threads",
+        "Number of threads. The default (1) runs all computations in the "
+        "main thread.",
+        "1",
+        options::Bounds("1", "infinity"));
+}
+
+int parse_num_threads_from_options(const options::Options &options) {
+    return options.get<int>("num_threads");
+}
+}
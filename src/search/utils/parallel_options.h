@@ -0,0 +1,17 @@
+#ifndef UTILS_PARALLEL_OPTIONS_H
+#define UTILS_PARALLEL_OPTIONS_H
+
+namespace options {
+class OptionParser;
+class Options;
+}
+
+namespace utils {
+// Add num_threads option to parser.
+extern void add_parallel_options(options::OptionParser &parser);
+
+// Only use this together with "add_parallel_options()".
+extern int parse_num_threads_from_options(const options::Options &options);
+}
+
+#endif